@@ -44,6 +44,12 @@
 
 /* USER CODE BEGIN Includes */
 /* Section where include file can be added */
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+  /* kernel hooks implemented in telemetry.c */
+  extern void telemetry_configure_timer(void);
+  extern void telemetry_task_switched_in(void *task);
+  extern void telemetry_task_deleted(void *task);
+#endif
 /* USER CODE END Includes */
 
 /* Ensure definitions are only used by the compiler, and not by the assembler. */
@@ -60,11 +66,12 @@
 #define configTICK_RATE_HZ                       ((TickType_t)1000)
 #define configMAX_PRIORITIES                     ( 7 )
 #define configMINIMAL_STACK_SIZE                 ((uint16_t)128)
-#define configTOTAL_HEAP_SIZE                    ((size_t)16384)
+#define configTOTAL_HEAP_SIZE                    ((size_t)13312)
 #define configMAX_TASK_NAME_LEN                  ( 16 )
 #define configUSE_16_BIT_TICKS                   0
 #define configUSE_MUTEXES                        1
 #define configQUEUE_REGISTRY_SIZE                8
+#define configCHECK_FOR_STACK_OVERFLOW           2
 #define configUSE_COUNTING_SEMAPHORES            1
 #define configENABLE_BACKWARD_COMPATIBILITY      0
 #define configUSE_PORT_OPTIMISED_TASK_SELECTION  1
@@ -127,6 +134,18 @@ standard names. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+
+/* Run-time statistics clocked by the DWT cycle counter, plus per-task context
+switch accounting (see telemetry.c). The counter wraps every ~25 s at 170 MHz,
+so the telemetry snapshot must be refreshed more often than that. */
+#define configUSE_TRACE_FACILITY                 1
+#define configGENERATE_RUN_TIME_STATS            1
+#define INCLUDE_uxTaskGetStackHighWaterMark      1
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() telemetry_configure_timer()
+#define portGET_RUN_TIME_COUNTER_VALUE()         (*((volatile uint32_t *)0xE0001004UL)) /* DWT->CYCCNT */
+#define traceTASK_SWITCHED_IN()                  telemetry_task_switched_in((void *)pxCurrentTCB)
+#define traceTASK_DELETE(pxTaskToDelete)         telemetry_task_deleted((void *)(pxTaskToDelete))
+
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,106 @@
+/**
+  ******************************************************************************
+  * @file           : asset.h
+  * @brief          : Streaming decoder for the compressed image assets.
+  ******************************************************************************
+  * @attention
+  *
+  * Images are compiled from Assets/ by Tools/asset_compiler.py into a
+  * palette of at most 256 RGB565 colours and one run-length encoded row of
+  * palette indices per scanline:
+  *
+  *   0x00..0x7F  literal, (b + 1) indices follow
+  *   0x80..0xFE  run of (b - 0x7F) pixels, the index follows
+  *   0xFF        long run, 16-bit little-endian count and the index follow
+  *
+  * asset_draw() opens a single window for the whole image and never
+  * expands it in RAM: literals are decoded into a pair of small line
+  * buffers that alternate on the SPI DMA, runs of ASSET_FILL_MIN pixels or
+  * more (merged across row ends) are sent as DMA fills from a single
+  * colour.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __ASSET_H
+#define __ASSET_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+#include "stm32g4xx_hal.h"
+
+#include "tft.h"
+
+/* Exported constants --------------------------------------------------------*/
+
+// pixels per DMA transfer, decoded alternately into the two strips of
+// render_scratch()
+#ifndef ASSET_BUFFER_PIXELS
+#define ASSET_BUFFER_PIXELS   256U
+#endif
+
+// shortest run sent as a DMA fill instead of being decoded into a buffer
+#ifndef ASSET_FILL_MIN
+#define ASSET_FILL_MIN        32U
+#endif
+
+#define ASSET_LITERAL_MAX     0x7FU
+#define ASSET_LONG_RUN        0xFFU
+
+/* Exported types ------------------------------------------------------------*/
+
+typedef struct
+{
+  uint16_t width;
+  uint16_t height;
+  uint16_t colors;              // palette entries
+  uint32_t size;                // flash bytes of palette, rows and data
+  const tft_color_t *palette;
+  const uint16_t *rows;         // offset of each row into data
+  const uint8_t *data;
+}
+asset_image_t;
+
+typedef struct
+{
+  uint32_t images;        // drawn since start
+  uint32_t pixels;        // of the last image
+  uint32_t filled;        // pixels of the last image sent as fills
+  uint32_t fills;         // fill transfers of the last image
+  uint32_t writes;        // buffer transfers of the last image
+  uint32_t time;          // us to draw the last image, bus included
+  uint32_t decode;        // us of that spent decoding, not waiting for DMA
+  uint32_t rate;          // pixels per ms drawn, last image
+  uint32_t decode_rate;   // pixels per ms decoded, last image
+  uint32_t saved;         // flash bytes the last image saves over raw RGB565
+}
+asset_stats_t;
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Flash an image saves over raw RGB565.
+  * @param  image: compiled image
+  * @retval Bytes
+  */
+static inline uint32_t asset_saved(const asset_image_t *image)
+{
+  uint32_t raw = (uint32_t)image->width * image->height * TFT_BYTES_PER_PIXEL;
+
+  return (raw > image->size) ? (raw - image->size) : 0U;
+}
+
+HAL_StatusTypeDef asset_draw(const asset_image_t *image, uint16_t x, uint16_t y);
+void asset_stats(asset_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ASSET_H */
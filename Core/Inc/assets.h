@@ -0,0 +1,29 @@
+/**
+  ******************************************************************************
+  * @file           : assets.h
+  * @brief          : Compressed image assets, generated by
+  *                   Tools/asset_compiler.py from Assets/. Do not edit.
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __ASSETS_H
+#define __ASSETS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "asset.h"
+
+/* Exported constants --------------------------------------------------------*/
+
+extern const asset_image_t asset_bolt;            // 20x20, 160 bytes
+extern const asset_image_t asset_splash;          // 320x240, 4106 bytes
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ASSETS_H */
@@ -0,0 +1,109 @@
+/**
+  ******************************************************************************
+  * @file           : baud.h
+  * @brief          : USART2 baud rate negotiation with verification and
+  *                   fallback.
+  ******************************************************************************
+  * @attention
+  *
+  * The port starts at BAUD_SAFE_RATE, as configured by MX_USART2_UART_Init().
+  * The host raises it through the shell (shell.h):
+  *
+  *   1. SYST:COMM:SER:NEG? <rate>|MAX  answers, at the current rate, with
+  *      the fastest known rate not above the one asked for that the kernel
+  *      clock can generate within BAUD_TOLERANCE_PERMILLE and that has not
+  *      failed BAUD_STRIKES_MAX times in a row.
+  *   2. Once that answer has left the USART, the port switches, using 16x
+  *      oversampling where the divider allows and 8x above fck / 16.
+  *   3. The host switches too and sends SYST:COMM:SER:CONF? until it reads
+  *      the rate back; the exchange verifies both directions.
+  *
+  * A trial that sees a receive error or no confirmation within
+  * BAUD_CONFIRM_MS returns to the previous rate. Once confirmed, more than
+  * BAUD_ERRORS_MAX framing, noise or overrun errors within BAUD_WINDOW_MS
+  * drop the port back to BAUD_SAFE_RATE, where a host that lost the stream
+  * looks for it. Either way the rate gets a strike, so the next negotiation
+  * settles lower.
+  *
+  * Runs in ShellTask: baud_poll() is called after every shell poll.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __BAUD_H
+#define __BAUD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+
+// rate after reset and after a fallback, must match MX_USART2_UART_Init()
+#define BAUD_SAFE_RATE          115200U
+
+// largest relative error of the generated rate
+#ifndef BAUD_TOLERANCE_PERMILLE
+#define BAUD_TOLERANCE_PERMILLE 15U
+#endif
+
+// how long a new rate waits for the host to confirm it
+#ifndef BAUD_CONFIRM_MS
+#define BAUD_CONFIRM_MS         1000U
+#endif
+
+// how long the answer may take to drain before the port switches anyway
+#ifndef BAUD_DRAIN_MS
+#define BAUD_DRAIN_MS           250U
+#endif
+
+// receive errors tolerated per window at a confirmed rate
+#ifndef BAUD_WINDOW_MS
+#define BAUD_WINDOW_MS          1000U
+#endif
+#ifndef BAUD_ERRORS_MAX
+#define BAUD_ERRORS_MAX         4U
+#endif
+
+// consecutive failures after which a rate is no longer offered
+#ifndef BAUD_STRIKES_MAX
+#define BAUD_STRIKES_MAX        2U
+#endif
+
+/* Exported types ------------------------------------------------------------*/
+
+typedef enum
+{
+  BAUD_STEADY,            // running at a confirmed rate
+  BAUD_SWITCH,            // answer draining, new rate pending
+  BAUD_TRIAL,             // running at the new rate, not yet confirmed
+}
+baud_state_t;
+
+typedef struct
+{
+  uint32_t rate;          // current nominal rate
+  uint8_t oversampling;   // 16 or 8
+  baud_state_t state;
+  uint32_t switches;      // trials started
+  uint32_t confirmed;     // trials confirmed by the host
+  uint32_t fallbacks;     // trials failed and confirmed rates abandoned
+}
+baud_stats_t;
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+uint32_t baud_negotiate(uint32_t rate);
+uint8_t baud_confirm(void);
+void baud_poll(void);
+void baud_stats(baud_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BAUD_H */
@@ -0,0 +1,98 @@
+/**
+  ******************************************************************************
+  * @file           : chart.h
+  * @brief          : Hardware-scrolled VBUS/IBUS strip chart.
+  ******************************************************************************
+  * @attention
+  *
+  * Samples go into a fixed-size ring. Every CHART_TIMEBASE samples make one
+  * pixel column, drawn as min..max bars so a spike of a single sample stays
+  * visible at any timebase. The ring holds a full plot at the default
+  * timebase only; a rebuild at a slower one restores the newest columns and
+  * leaves the rest empty. The chart occupies the full-height band of
+  * columns CHART_X..CHART_X+CHART_WIDTH-1, set up as the panel's scroll
+  * area: a new column is one narrow DMA write over the oldest GRAM column
+  * followed by a scroll-start update, the rest of the plot is never resent.
+  * Zoom and timebase changes rebuild the whole plot from the ring.
+  *
+  * chart_push() runs in the sampling task, chart_draw() in the screen task
+  * with the display owned.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __CHART_H
+#define __CHART_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+#include "stm32g4xx_hal.h"
+
+#include "tft.h"
+
+/* Exported constants --------------------------------------------------------*/
+
+// the scroll area, everything left of it is fixed
+#define CHART_X               160U
+#define CHART_WIDTH           (TFT_WIDTH - CHART_X)
+
+// samples kept for rebuilds, 4 bytes each
+#ifndef CHART_RING_SIZE
+#define CHART_RING_SIZE       256U
+#endif
+
+// columns that may wait for the screen task before a rebuild is forced
+#ifndef CHART_PENDING_MAX
+#define CHART_PENDING_MAX     16U
+#endif
+
+// interval between the samples the default task pushes, a multiple of
+// MEASURE_PERIOD_MS
+#ifndef CHART_PERIOD_MS
+#define CHART_PERIOD_MS       100U
+#endif
+
+// defaults: samples per column and full-scale values
+#ifndef CHART_TIMEBASE
+#define CHART_TIMEBASE        1U
+#endif
+#ifndef CHART_FULL_MV
+#define CHART_FULL_MV         21000U
+#endif
+#ifndef CHART_FULL_MA
+#define CHART_FULL_MA         5000U
+#endif
+
+/* Exported types ------------------------------------------------------------*/
+
+typedef struct
+{
+  uint32_t samples;       // pushed since start
+  uint32_t columns;       // drawn by scrolling
+  uint32_t rebuilds;      // full redraws from the ring
+  uint32_t overruns;      // columns lost to a full pending queue
+}
+chart_stats_t;
+
+typedef void (*chart_listener_t)(void);
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+void chart_init(chart_listener_t listener);
+void chart_push(uint32_t mV, int32_t mA);
+void chart_timebase(uint16_t samples);
+void chart_zoom(uint32_t full_mV, uint32_t full_mA);
+HAL_StatusTypeDef chart_draw(void);
+void chart_stats(chart_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CHART_H */
@@ -0,0 +1,93 @@
+/**
+  ******************************************************************************
+  * @file           : codec.h
+  * @brief          : Streaming delta / adaptive Rice codec for measurements.
+  ******************************************************************************
+  * @attention
+  *
+  * Each sample is CODEC_CHANNELS 16-bit values (VBUS mV, IBUS mA as two's
+  * complement). A value is coded as the zig-zag mapped difference to the
+  * previous value of its channel, modulo 2^16, in a Rice code whose
+  * parameter k follows the running mean of recent magnitudes (as in
+  * LOCO-I): q = zz >> k ones, a zero, then the k low bits of zz. A quotient
+  * of CODEC_ESCAPE or more is sent as CODEC_ESCAPE ones and zz in 16 bits,
+  * so every value costs at most CODEC_VALUE_BITS_MAX bits and a sample is
+  * coded in bounded time.
+  *
+  * A keyframe carries each channel's k (4 bits) and its absolute value
+  * (16 bits) and restarts the adaptation from that k, so a decoder can
+  * start from any keyframe. Bits are packed MSB first; the last byte is
+  * padded with zeros.
+  *
+  * Tools/link.py holds the matching decoder; Tests/test_codec.c checks the
+  * two against each other. On its synthesized traces (5 V idle, 20 V load
+  * steps, negotiation, switching ripple) a LINK_TYPE_SAMPLES_RICE stream is
+  * 2.1 to 3.5 times smaller than LINK_TYPE_SAMPLES, 2.9 overall: about
+  * 11 bits per sample in steady state against 39.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __CODEC_H
+#define __CODEC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+
+#define CODEC_CHANNELS        2U
+
+#define CODEC_K_MAX           15U   // fits the 4-bit keyframe field
+#define CODEC_ESCAPE          12U   // quotient sent as a raw value
+#define CODEC_RESET           32U   // halve the statistics at this count
+
+#define CODEC_VALUE_BITS_MAX  (CODEC_ESCAPE + 16U)
+#define CODEC_SAMPLE_BITS_MAX (CODEC_CHANNELS * CODEC_VALUE_BITS_MAX)
+#define CODEC_KEYFRAME_BITS   (CODEC_CHANNELS * (4U + 16U))
+
+/* Exported types ------------------------------------------------------------*/
+
+typedef struct
+{
+  uint16_t prev;          // last value coded
+  uint32_t sum;           // recent zig-zag magnitudes
+  uint32_t count;         // values in sum
+}
+codec_channel_t;
+
+typedef struct
+{
+  codec_channel_t channel[CODEC_CHANNELS];
+}
+codec_t;
+
+typedef struct
+{
+  uint8_t *buf;
+  size_t size;            // bytes available in buf
+  size_t len;             // whole bytes written
+  uint32_t acc;           // bits not yet written, right-aligned
+  uint8_t pending;        // number of bits in acc
+}
+codec_bits_t;
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+void codec_init(codec_t *codec);
+void codec_begin(codec_bits_t *bits, uint8_t *buf, size_t size);
+uint8_t codec_keyframe(codec_t *codec, codec_bits_t *bits, const uint16_t value[CODEC_CHANNELS]);
+uint8_t codec_encode(codec_t *codec, codec_bits_t *bits, const uint16_t value[CODEC_CHANNELS]);
+size_t codec_end(codec_bits_t *bits);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CODEC_H */
@@ -0,0 +1,87 @@
+/**
+  ******************************************************************************
+  * @file           : cycles.h
+  * @brief          : Core clock cycle counter (DWT CYCCNT) helpers shared by
+  *                   the run-time instrumentation.
+  ******************************************************************************
+  * @attention
+  *
+  * CYCCNT is a free-running 32-bit counter clocked by HCLK, so it wraps every
+  * 2^32 / 170 MHz = ~25 s. All differences must be taken with unsigned
+  * arithmetic and spans must stay well below the wrap period.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __CYCLES_H
+#define __CYCLES_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32g4xx.h"
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+/**
+  * @brief  Enable the DWT cycle counter if it is not already running. Safe to
+  *         call more than once, the counter is never reset.
+  * @retval None
+  */
+static inline void cycles_init(void)
+{
+  if (0U == (DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk))
+  {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0U;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+  }
+}
+
+/**
+  * @brief  Current value of the cycle counter.
+  * @retval Core clock cycles (wrapping)
+  */
+static inline uint32_t cycles_now(void)
+{
+  return DWT->CYCCNT;
+}
+
+/**
+  * @brief  Cycles elapsed since a previous cycles_now() reading.
+  * @param  since: earlier reading
+  * @retval Core clock cycles
+  */
+static inline uint32_t cycles_since(uint32_t since)
+{
+  return DWT->CYCCNT - since;
+}
+
+/**
+  * @brief  Convert a cycle count to microseconds at the current core clock.
+  * @param  cycles: core clock cycles
+  * @retval Microseconds (truncated)
+  */
+static inline uint32_t cycles_to_us(uint32_t cycles)
+{
+  return cycles / (SystemCoreClock / 1000000U);
+}
+
+/**
+  * @brief  Convert microseconds to a cycle count at the current core clock.
+  * @param  us: microseconds, must be below the counter wrap period
+  * @retval Core clock cycles
+  */
+static inline uint32_t cycles_from_us(uint32_t us)
+{
+  return us * (SystemCoreClock / 1000000U);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CYCLES_H */
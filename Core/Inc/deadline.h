@@ -0,0 +1,76 @@
+/**
+  ******************************************************************************
+  * @file           : deadline.h
+  * @brief          : Lightweight deadline monitor for tasks and ISRs.
+  ******************************************************************************
+  * @attention
+  *
+  * A deadline is a named latency budget. deadline_start() and
+  * deadline_finish() bracket one occurrence (e.g. PE wake-up to state machine
+  * done), deadline_mark() measures the interval between consecutive calls of
+  * a periodic activity. Every completed occurrence updates the miss count,
+  * worst-case latency/lateness and a histogram whose bins are fractions of
+  * the budget:
+  *
+  *   bin:   0      1      2      3      4      5      6      7
+  *   upto:  1/8    1/4    1/2    3/4    1      2      4      (more)
+  *
+  * Bins 5..7 are misses. All calls are safe from tasks and from ISRs at or
+  * below configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY. Spans are measured
+  * with the DWT cycle counter and must stay below ~25 s.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __DEADLINE_H
+#define __DEADLINE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+
+#ifndef DEADLINE_MAX
+#define DEADLINE_MAX            8U
+#endif
+
+#define DEADLINE_HISTOGRAM_BINS 8U
+#define DEADLINE_NONE           0xFFU
+
+/* Exported types ------------------------------------------------------------*/
+
+typedef uint8_t deadline_id_t;
+
+typedef struct
+{
+  const char *name;
+  uint32_t budget_us;
+  uint32_t count;         // completed occurrences
+  uint32_t missed;        // occurrences over budget
+  uint32_t worst_us;      // worst-case latency
+  uint32_t lateness_us;   // worst-case latency beyond the budget
+  uint32_t histogram[DEADLINE_HISTOGRAM_BINS];
+}
+deadline_stats_t;
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+deadline_id_t deadline_register(const char *name, uint32_t budget_us);
+void deadline_start(deadline_id_t id);
+void deadline_finish(deadline_id_t id);
+void deadline_mark(deadline_id_t id);
+void deadline_cancel(deadline_id_t id);
+uint32_t deadline_count(void);
+void deadline_stats(deadline_id_t id, deadline_stats_t *stats);
+void deadline_reset(deadline_id_t id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __DEADLINE_H */
@@ -0,0 +1,87 @@
+/**
+  ******************************************************************************
+  * @file           : dlog.h
+  * @brief          : Deferred binary logging, formatted on the host.
+  ******************************************************************************
+  * @attention
+  *
+  * DLOG(port, format, ...) does no formatting. The format string is placed
+  * in the .dlog section, which the linker script keeps in the ELF file but
+  * never loads, so it takes no flash; its address in that section is the
+  * format ID. The call site stores the ID, the cycle counter and up to
+  * DLOG_ARGS_MAX raw 32-bit arguments in a lock-free ring, a few dozen
+  * cycles from any task or interrupt handler.
+  *
+  * dlog_flush() moves the records into LINK_TYPE_DLOG frames on the log
+  * channel of link.h. Tools/link.py -e <elf> reads the .dlog section back
+  * and formats them.
+  *
+  * Arguments are integers (int, unsigned, char, pointers cast to uint32_t)
+  * for %d, %i, %u, %x, %X, %c and %p conversions, with any length modifier.
+  * %s and floating point cannot be deferred.
+  *
+  * A record that finds the ring full is dropped; the next frame carries the
+  * number of records dropped since the previous one.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __DLOG_H
+#define __DLOG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+
+// records held until the next flush, a power of two
+#ifndef DLOG_RING_SIZE
+#define DLOG_RING_SIZE        32U
+#endif
+
+#define DLOG_ARGS_MAX         4U
+
+/* Exported types ------------------------------------------------------------*/
+
+typedef struct
+{
+  uint32_t records;       // records stored
+  uint32_t dropped;       // records that found the ring full
+  uint32_t frames;        // frames handed to the link
+}
+dlog_stats_t;
+
+/* Exported macro ------------------------------------------------------------*/
+
+#define DLOG(port, format, ...) do {                                          \
+    static const char _dlog_format[]                                          \
+        __attribute__((section(".dlog"), used)) = format;                     \
+    DLOG_CAT(dlog_write, DLOG_NARGS(__VA_ARGS__))(                            \
+        (uint16_t)(uintptr_t)_dlog_format, (uint8_t)(port), ##__VA_ARGS__);   \
+  } while (0)
+
+#define DLOG_NARGS(...)       DLOG_NARGS_(0, ##__VA_ARGS__, 4, 3, 2, 1, 0)
+#define DLOG_NARGS_(_0, _1, _2, _3, _4, n, ...) n
+#define DLOG_CAT(a, b)        DLOG_CAT_(a, b)
+#define DLOG_CAT_(a, b)       a##b
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+void dlog_write0(uint16_t id, uint8_t port);
+void dlog_write1(uint16_t id, uint8_t port, uint32_t a);
+void dlog_write2(uint16_t id, uint8_t port, uint32_t a, uint32_t b);
+void dlog_write3(uint16_t id, uint8_t port, uint32_t a, uint32_t b, uint32_t c);
+void dlog_write4(uint16_t id, uint8_t port, uint32_t a, uint32_t b, uint32_t c, uint32_t d);
+void dlog_flush(void);
+void dlog_stats(dlog_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __DLOG_H */
@@ -0,0 +1,72 @@
+/**
+  ******************************************************************************
+  * @file           : glyph.h
+  * @brief          : Layout of the pre-rendered glyph atlases.
+  ******************************************************************************
+  * @attention
+  *
+  * An atlas holds every glyph of one size as 1-bpp row masks in flash, MSB
+  * first (leftmost pixel), stride bytes per row. The renderer expands the
+  * masks to RGB565 straight into its DMA strip buffers, so no font is
+  * rasterized at run time. Atlases are generated by Tools/glyph_atlas.py.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __GLYPH_H
+#define __GLYPH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+
+#define GLYPH_FIRST       ' '
+#define GLYPH_LAST        '~'
+#define GLYPH_INDEX_SIZE  (GLYPH_LAST - GLYPH_FIRST + 1)
+#define GLYPH_NONE        0xFFU
+
+/* Exported types ------------------------------------------------------------*/
+
+typedef struct
+{
+  uint8_t width;          // pixels per glyph row
+  uint8_t height;         // rows per glyph
+  uint8_t advance;        // pixels from one glyph to the next
+  uint8_t stride;         // bytes per glyph row
+  const uint8_t *index;   // glyph number of each character, GLYPH_NONE if absent
+  const uint8_t *masks;   // height * stride bytes per glyph
+}
+glyph_atlas_t;
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Row masks of a character.
+  * @param  atlas: glyph source
+  * @param  ch: character
+  * @retval First row of the glyph, NULL if the atlas has no such glyph
+  */
+static inline const uint8_t *glyph_find(const glyph_atlas_t *atlas, char ch)
+{
+  if ((ch < GLYPH_FIRST) || (ch > GLYPH_LAST))
+    { return NULL; }
+
+  uint8_t n = atlas->index[ch - GLYPH_FIRST];
+  if (GLYPH_NONE == n)
+    { return NULL; }
+
+  return &atlas->masks[(size_t)n * atlas->height * atlas->stride];
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __GLYPH_H */
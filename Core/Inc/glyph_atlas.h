@@ -0,0 +1,30 @@
+/**
+  ******************************************************************************
+  * @file           : glyph_atlas.h
+  * @brief          : Pre-rendered glyph atlas, generated by
+  *                   Tools/glyph_atlas.py. Do not edit.
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __GLYPH_ATLAS_H
+#define __GLYPH_ATLAS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "glyph.h"
+
+/* Exported constants --------------------------------------------------------*/
+
+extern const glyph_atlas_t glyph_atlas_small;     // 10x14, 68 glyphs
+extern const glyph_atlas_t glyph_atlas_medium;    // 15x21, 23 glyphs
+extern const glyph_atlas_t glyph_atlas_large;     // 20x28, 23 glyphs
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __GLYPH_ATLAS_H */
@@ -0,0 +1,109 @@
+/**
+  ******************************************************************************
+  * @file           : isr_profile.h
+  * @brief          : Interrupt handler duration and rate profiler.
+  ******************************************************************************
+  * @attention
+  *
+  * ISR_PROFILE_ENTER(id) / ISR_PROFILE_EXIT(id) bracket the body of a handler
+  * in stm32g4xx_it.c. Durations are exclusive: time spent in a nested
+  * (preempting) handler is charged to that handler only. The bookkeeping
+  * masks interrupts with PRIMASK for a few cycles, so it is also valid in
+  * handlers above configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY.
+  *
+  * Define ISR_PROFILE_ENABLED to 0 to compile the macros out entirely; it
+  * defaults to enabled in DEBUG builds only.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __ISR_PROFILE_H
+#define __ISR_PROFILE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+
+#ifndef ISR_PROFILE_ENABLED
+#if defined(DEBUG)
+#define ISR_PROFILE_ENABLED  1
+#else
+#define ISR_PROFILE_ENABLED  0
+#endif
+#endif
+
+/* Exported types ------------------------------------------------------------*/
+
+typedef enum
+{
+  ISR_PROFILE_DMA1_CH1,
+  ISR_PROFILE_DMA1_CH2,
+  ISR_PROFILE_DMA1_CH3,
+  ISR_PROFILE_DMA1_CH4,
+  ISR_PROFILE_DMA1_CH5,
+  ISR_PROFILE_SPI1,
+  ISR_PROFILE_USART2,
+  ISR_PROFILE_EXTI15_10,
+  ISR_PROFILE_TIM6,
+  ISR_PROFILE_TIM7,
+  ISR_PROFILE_UCPD1,
+  ISR_PROFILE_I2C3_EV,
+  ISR_PROFILE_I2C3_ER,
+  ISR_PROFILE_COUNT
+}
+isr_profile_id_t;
+
+typedef struct
+{
+  uint32_t start;        // cycle counter at entry
+  uint32_t child;        // nested time of the enclosing handler, saved
+}
+isr_profile_frame_t;
+
+typedef struct
+{
+  uint32_t count;        // calls since reset
+  uint32_t nested;       // calls that preempted another profiled handler
+  uint32_t min;          // exclusive cycles
+  uint32_t max;          // exclusive cycles
+  uint32_t avg;          // exclusive cycles
+  uint32_t rate;         // calls per second over the last sample window
+  uint16_t load;         // CPU share over the last sample window, in 0.1 %
+}
+isr_profile_stats_t;
+
+/* Exported macro ------------------------------------------------------------*/
+
+#if ISR_PROFILE_ENABLED
+#define ISR_PROFILE_ENTER(id) \
+  isr_profile_frame_t _isr_profile_frame; \
+  isr_profile_enter((id), &_isr_profile_frame)
+#define ISR_PROFILE_EXIT(id) \
+  isr_profile_exit((id), &_isr_profile_frame)
+#else
+#define ISR_PROFILE_ENTER(id)
+#define ISR_PROFILE_EXIT(id)
+#endif
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+void isr_profile_enter(isr_profile_id_t id, isr_profile_frame_t *frame);
+void isr_profile_exit(isr_profile_id_t id, isr_profile_frame_t *frame);
+
+void isr_profile_sample(void);
+void isr_profile_stats(isr_profile_id_t id, isr_profile_stats_t *stats);
+uint32_t isr_profile_depth_max(void);
+const char *isr_profile_name(isr_profile_id_t id);
+void isr_profile_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ISR_PROFILE_H */
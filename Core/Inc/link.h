@@ -0,0 +1,142 @@
+/**
+  ******************************************************************************
+  * @file           : link.h
+  * @brief          : Framed binary telemetry link over USART2.
+  ******************************************************************************
+  * @attention
+  *
+  * Every record is one frame: a header, a body of at most LINK_BODY_MAX
+  * bytes and a CRC-16, COBS-encoded and terminated by a zero byte, so the
+  * host can resynchronise on the next zero after any loss or corruption.
+  *
+  *   offset  size  field
+  *   0       1     schema version, LINK_SCHEMA_VERSION
+  *   1       1     channel, link_channel_t
+  *   2       1     record type, LINK_TYPE_*
+  *   3       2     sequence number of the channel, little-endian
+  *   5       n     body, little-endian fields
+  *   5+n     2     CRC-16/CCITT-FALSE of bytes 0..4+n (poly 0x1021, init
+  *                 0xFFFF), little-endian, from the hardware CRC unit
+  *
+  * Channels are numbered in priority order. Priority is enforced when a
+  * frame is queued: each channel may only fill the transmit ring up to its
+  * own limit, so bulk samples never take the room left for PD events, logs
+  * and command responses. A frame over its limit is dropped, the sequence
+  * number it consumed shows the gap to the host.
+  *
+  * Tools/link.py decodes the stream.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __LINK_H
+#define __LINK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include <stdint.h>
+
+#include "measure.h"
+#include "uart_tx.h"
+
+/* Exported constants --------------------------------------------------------*/
+
+// bumped whenever a header or body layout changes
+#define LINK_SCHEMA_VERSION   1U
+
+#define LINK_HEADER_SIZE      5U
+#define LINK_CRC_SIZE         2U
+
+#ifndef LINK_BODY_MAX
+#define LINK_BODY_MAX         64U
+#endif
+
+// COBS adds one byte per 254 plus the delimiter
+#define LINK_FRAME_MAX        (LINK_HEADER_SIZE + LINK_BODY_MAX + LINK_CRC_SIZE + 2U)
+
+// share of the transmit ring each channel may fill, in bytes
+#ifndef LINK_LIMIT_RESPONSE
+#define LINK_LIMIT_RESPONSE   UART_TX_BUFFER_SIZE
+#endif
+#ifndef LINK_LIMIT_EVENT
+#define LINK_LIMIT_EVENT      (UART_TX_BUFFER_SIZE * 7U / 8U)
+#endif
+#ifndef LINK_LIMIT_LOG
+#define LINK_LIMIT_LOG        (UART_TX_BUFFER_SIZE * 3U / 4U)
+#endif
+#ifndef LINK_LIMIT_SAMPLE
+#define LINK_LIMIT_SAMPLE     (UART_TX_BUFFER_SIZE / 2U)
+#endif
+
+// 1: samples go out compressed (codec.h), 0: as raw 16-bit values
+#ifndef LINK_SAMPLE_CODEC
+#define LINK_SAMPLE_CODEC     1
+#endif
+
+// most samples per frame, a compressed frame is also sent once full
+#ifndef LINK_SAMPLE_BATCH
+#if LINK_SAMPLE_CODEC
+#define LINK_SAMPLE_BATCH     24U
+#else
+#define LINK_SAMPLE_BATCH     8U
+#endif
+#endif
+
+// record types, with their bodies
+#define LINK_TYPE_SAMPLES     0x10U  // tick u32, period ms u16, count u8,
+                                     // count x (mV u16, mA i16)
+#define LINK_TYPE_SAMPLES_RICE 0x11U // tick u32, period ms u16, count u8,
+                                     // keyframe and count - 1 coded samples
+#define LINK_TYPE_NOTIFY      0x20U  // tick u32, port u8, DPM notification u8
+#define LINK_TYPE_CABLE       0x21U  // tick u32, port u8, CAD event u8
+#define LINK_TYPE_CAPTURE     0x22U  // tick u32, cycles u32, MHz u8, dropped u16,
+                                     // captured PD messages (sniff.h)
+#define LINK_TYPE_LOG         0x30U  // tick u32, port u8, text
+#define LINK_TYPE_DLOG        0x31U  // tick u32, cycles u32, MHz u8, dropped u16,
+                                     // deferred log records (dlog.h)
+#define LINK_TYPE_TRACE       0x32U  // tick u32, cycles u32, MHz u8,
+                                     // USB-PD stack trace records (pd_trace.h)
+#define LINK_TYPE_RESPONSE    0x40U  // text
+
+/* Exported types ------------------------------------------------------------*/
+
+typedef enum
+{
+  LINK_CH_RESPONSE,       // command responses, highest priority
+  LINK_CH_EVENT,          // PD events
+  LINK_CH_LOG,            // debug text
+  LINK_CH_SAMPLE,         // measurements, lowest priority
+  LINK_CH_COUNT
+}
+link_channel_t;
+
+typedef struct
+{
+  uint32_t frames[LINK_CH_COUNT];   // frames queued
+  uint32_t bytes[LINK_CH_COUNT];    // encoded bytes queued, delimiters included
+  uint32_t dropped[LINK_CH_COUNT];  // frames over the channel limit
+}
+link_stats_t;
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+void link_init(void);
+uint8_t link_send(link_channel_t channel, uint8_t type, const void *body, size_t len);
+void link_sample(const measure_snapshot_t *sample);
+void link_event(uint8_t type, uint8_t port, uint8_t value);
+void link_log(uint8_t port, const char *format, ...)
+    __attribute__((format(printf, 2, 3)));
+void link_stats(link_stats_t *stats);
+void link_put16(uint8_t *dst, uint16_t value);
+void link_put32(uint8_t *dst, uint32_t value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LINK_H */
@@ -0,0 +1,76 @@
+/**
+  ******************************************************************************
+  * @file           : measure.h
+  * @brief          : VBUS measurement sampler (INA260) shared by the PD stack
+  *                   and the application.
+  ******************************************************************************
+  * @attention
+  *
+  * All INA260 traffic goes through this module so that the PD stack (VBUS
+  * checks from the PE task) and the periodic sampler never interleave on
+  * I2C3. Each completed sample is published as a snapshot; listeners are
+  * only notified when the reading moved by more than the deadband.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __MEASURE_H
+#define __MEASURE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+#include "stm32g4xx_hal.h"
+
+/* Exported constants --------------------------------------------------------*/
+
+// sampling period of measure_sample() as driven by the default task; at
+// its default configuration (1.1 ms conversions, no averaging) the INA260
+// has a fresh reading every 2.2 ms, and the two register reads take about
+// 0.1 ms of I2C3 in Fast-mode Plus
+#ifndef MEASURE_PERIOD_MS
+#define MEASURE_PERIOD_MS       10U
+#endif
+
+// minimum change that counts as new data for listeners
+#ifndef MEASURE_DEADBAND_MV
+#define MEASURE_DEADBAND_MV     10
+#endif
+#ifndef MEASURE_DEADBAND_MA
+#define MEASURE_DEADBAND_MA     5
+#endif
+
+/* Exported types ------------------------------------------------------------*/
+
+typedef struct
+{
+  uint32_t sequence;     // incremented by every published sample
+  uint32_t tick;         // kernel tick of the sample
+  uint32_t voltage;      // mV
+  int32_t  current;      // mA
+  int32_t  power;        // mW
+  uint32_t errors;       // failed reads since start
+}
+measure_snapshot_t;
+
+typedef void (*measure_listener_t)(void);
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+void measure_init(measure_listener_t listener);
+HAL_StatusTypeDef measure_sample(void);
+void measure_snapshot(measure_snapshot_t *snapshot);
+
+HAL_StatusTypeDef measure_voltage(uint32_t *mV);
+HAL_StatusTypeDef measure_current(int32_t *mA);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MEASURE_H */
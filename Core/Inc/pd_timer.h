@@ -0,0 +1,63 @@
+/**
+  ******************************************************************************
+  * @file           : pd_timer.h
+  * @brief          : Dedicated 1 ms timebase (TIM7) for the USB-PD stack.
+  ******************************************************************************
+  * @attention
+  *
+  * TIM7 runs from the 1 MHz prescaled kernel clock and interrupts every
+  * PD_TIMER_PERIOD_US. Each update advances the PE/PRL/DPM user timers once
+  * per elapsed period; if update events were lost (ISR held off for more
+  * than a period) the missed periods are replayed so the PD timers never fall
+  * behind, and are counted as missed.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __PD_TIMER_H
+#define __PD_TIMER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+
+// TIM7 (MX_TIM7_Init(), upd-data.ioc) counts at 1 MHz and reloads at this
+// minus one; its interrupt sits at priority 3 with the other stack
+// interrupts, so PD callbacks may use FromISR
+#define PD_TIMER_PERIOD_US     1000U
+
+// upper bound of missed periods replayed by a single interrupt
+#ifndef PD_TIMER_CATCHUP_MAX
+#define PD_TIMER_CATCHUP_MAX   8U
+#endif
+
+/* Exported types ------------------------------------------------------------*/
+
+typedef struct
+{
+  uint32_t ticks;        // periods delivered to the PD stack
+  uint32_t missed;       // update events lost and replayed
+  uint32_t dropped;      // missed periods beyond PD_TIMER_CATCHUP_MAX
+  uint32_t overruns;     // handler still running at the next update event
+  uint32_t latency_max;  // worst interrupt entry latency, in us
+  int32_t  drift;        // PD ticks minus HAL ticks since start, in ms
+}
+pd_timer_stats_t;
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+void pd_timer_init(void);
+void pd_timer_isr(void);
+void pd_timer_stats(pd_timer_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __PD_TIMER_H */
@@ -0,0 +1,77 @@
+/**
+  ******************************************************************************
+  * @file           : pd_trace.h
+  * @brief          : Lossy, non-blocking back end for the USB-PD stack tracer.
+  ******************************************************************************
+  * @attention
+  *
+  * Replaces usbpd_trace.c and the embedded tracer of the Cube package: with
+  * _TRACE defined, USBPD_TRACE_Add() copies the event into a fixed ring of
+  * PD_TRACE_RING_SIZE slots and returns. It takes no lock and never waits,
+  * from the PE and CAD tasks or the UCPD interrupt, so tracing leaves PD
+  * timing alone. An event that finds the ring full is dropped and counted
+  * against its source, the TRACE_EVENT type; payloads longer than
+  * PD_TRACE_DATA_MAX bytes are cut, the record keeps the original size.
+  *
+  * High-rate sources can be sampled: pd_trace_sample() keeps one event in n
+  * of a source. Sampled-out events are counted but are not drops.
+  *
+  * pd_trace_flush() moves the records into LINK_TYPE_TRACE frames on the
+  * log channel of link.h. Each flush that finds new drops on a source adds
+  * a marker record with the number of records lost since the last one, so
+  * the host sees where in the stream the gap is.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __PD_TRACE_H
+#define __PD_TRACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+
+// events held until the next flush, a power of two
+#ifndef PD_TRACE_RING_SIZE
+#define PD_TRACE_RING_SIZE    16U
+#endif
+
+// payload bytes kept per event, enough for a message with 7 data objects
+#ifndef PD_TRACE_DATA_MAX
+#define PD_TRACE_DATA_MAX     30U
+#endif
+
+// sources with their own counters; higher TRACE_EVENT types share the last
+#define PD_TRACE_SOURCES      16U
+
+// record type of a drop marker, above any TRACE_EVENT
+#define PD_TRACE_DROPPED      0xFFU
+
+/* Exported types ------------------------------------------------------------*/
+
+typedef struct
+{
+  uint32_t seen[PD_TRACE_SOURCES];     // events traced
+  uint32_t dropped[PD_TRACE_SOURCES];  // events that found the ring full
+  uint32_t records;                    // events stored
+  uint32_t frames;                     // frames handed to the link
+}
+pd_trace_stats_t;
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+void pd_trace_sample(uint8_t source, uint16_t every);
+void pd_trace_flush(void);
+void pd_trace_stats(pd_trace_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __PD_TRACE_H */
@@ -0,0 +1,94 @@
+/**
+  ******************************************************************************
+  * @file           : pdo.h
+  * @brief          : Source PDO decoding and on-demand renegotiation.
+  ******************************************************************************
+  * @attention
+  *
+  * pdo_decode() turns a raw source Power Data Object, as kept in
+  * DPM_Ports[].DPM_ListOfRcvSRCPDO, into millivolts, milliamps and
+  * milliwatts. pdo_request() asks the policy engine for another object of
+  * the current Source_Capabilities through USBPD_DPM_RequestMessageRequest();
+  * the DPM reports the outcome through pdo_notify(). The time from the
+  * touch that asked for the rail to the explicit contract is measured.
+  *
+  * The DPM only builds requests for fixed and battery supplies, variable
+  * supplies and PPS APDOs are listed but cannot be requested.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __PDO_H
+#define __PDO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include <stdint.h>
+
+#include "usbpd_def.h"
+
+/* Exported types ------------------------------------------------------------*/
+
+typedef enum
+{
+  PDO_FIXED,
+  PDO_BATTERY,
+  PDO_VARIABLE,
+  PDO_PPS,
+  PDO_UNKNOWN,            // other augmented PDOs
+}
+pdo_type_t;
+
+typedef struct
+{
+  pdo_type_t type;
+  uint32_t mv_min;        // equal to mv_max for fixed supplies
+  uint32_t mv_max;
+  uint32_t ma;            // maximum current, 0 for batteries
+  uint32_t mw;            // maximum power at mv_max
+}
+pdo_info_t;
+
+typedef enum
+{
+  PDO_REQUEST_IDLE,       // nothing asked since attach
+  PDO_REQUEST_PENDING,    // sent, waiting for the source
+  PDO_REQUEST_READY,      // explicit contract on the requested object
+  PDO_REQUEST_REJECTED,   // source answered Reject or Wait
+  PDO_REQUEST_FAILED,     // not sent: detached, busy or unsupported
+}
+pdo_state_t;
+
+typedef struct
+{
+  uint32_t requests;      // passed to the policy engine
+  uint32_t contracts;     // ending in an explicit contract
+  uint32_t rejected;
+  uint32_t failed;
+  pdo_state_t state;      // of the last request
+  uint8_t position;       // object position of the last request, from 1
+  uint32_t latency_last;  // us from the touch to the explicit contract
+  uint32_t latency_max;
+}
+pdo_stats_t;
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+void pdo_decode(uint32_t raw, pdo_info_t *info);
+void pdo_format(const pdo_info_t *info, char *buf, size_t len);
+uint8_t pdo_requestable(const pdo_info_t *info);
+USBPD_StatusTypeDef pdo_request(uint8_t port, uint8_t position, uint32_t edge);
+void pdo_notify(uint8_t port, USBPD_NotifyEventValue_TypeDef event);
+void pdo_reset(uint8_t port);
+void pdo_stats(pdo_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __PDO_H */
@@ -0,0 +1,129 @@
+/**
+  ******************************************************************************
+  * @file           : render.h
+  * @brief          : Retained-mode dirty-rectangle renderer for the TFT.
+  ******************************************************************************
+  * @attention
+  *
+  * The renderer keeps a small scene (background colour, filled boxes and
+  * text items on top of them) and a list of damaged rectangles. Changing a
+  * text item damages only the glyph cells whose character changed (e.g. the
+  * last digits of a reading), resizing a box only the strip it gained or
+  * lost;
+  * overlapping rectangles, and neighbours whose union wastes fewer
+  * than RENDER_MERGE_SLACK pixels, are merged as they are added. At flush
+  * time every remaining rectangle is rasterized in strips and pushed into its
+  * own ILI9341 address window by DMA, so pixels outside the damage are never
+  * sent. Glyphs come from the flash-resident atlases in glyph_atlas.h and
+  * are expanded from 1-bpp row masks straight into the strip buffers.
+  *
+  * A 320x240 framebuffer would not fit in RAM, so there are two strip
+  * buffers of RENDER_STRIP_LINES full-width scanlines each: the CPU
+  * rasterizes the next strip into one while DMA sends the other. Taller
+  * strips cost 2 * 640 bytes of RAM per line and leave fewer gaps on the
+  * bus between transfers; render_stats() reports how busy the bus was.
+  * Between flushes the strips are lent to the other code that stages
+  * pixels for DMA (asset.h, chart.h) through render_scratch().
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __RENDER_H
+#define __RENDER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+#include "stm32g4xx_hal.h"
+
+#include "glyph.h"
+#include "tft.h"
+
+/* Exported constants --------------------------------------------------------*/
+
+#ifndef RENDER_DAMAGE_MAX
+#define RENDER_DAMAGE_MAX     16U
+#endif
+
+#ifndef RENDER_TEXT_MAX
+#define RENDER_TEXT_MAX       24U
+#endif
+
+#ifndef RENDER_BOX_MAX
+#define RENDER_BOX_MAX        8U
+#endif
+
+#ifndef RENDER_TEXT_LEN
+#define RENDER_TEXT_LEN       24U
+#endif
+
+// height of each of the two rasterization buffers, in full-width scanlines
+#ifndef RENDER_STRIP_LINES
+#define RENDER_STRIP_LINES    2U
+#endif
+
+#define RENDER_STRIP_PIXELS   (TFT_WIDTH * RENDER_STRIP_LINES)
+
+// overdraw accepted to save opening another address window
+#ifndef RENDER_MERGE_SLACK
+#define RENDER_MERGE_SLACK    256U
+#endif
+
+#define RENDER_TEXT_NONE      0xFFU
+#define RENDER_BOX_NONE       0xFFU
+
+/* Exported types ------------------------------------------------------------*/
+
+typedef struct
+{
+  uint16_t x;
+  uint16_t y;
+  uint16_t w;
+  uint16_t h;
+}
+render_rect_t;
+
+typedef uint8_t render_text_id_t;
+typedef uint8_t render_box_id_t;
+
+typedef struct
+{
+  uint32_t frames;        // flushes that sent anything
+  uint32_t windows;       // address windows in the last frame
+  uint32_t pixels;        // pixels in the last frame
+  uint32_t bytes;         // SPI bytes in the last frame, commands included
+  uint32_t bytes_max;
+  uint32_t bytes_avg;
+  uint32_t time;          // duration of the last frame, in us
+  uint32_t time_max;      // in us
+  uint32_t dma;           // time the last frame kept the bus busy, in us
+  uint32_t stall;         // time the last frame waited for the bus, in us
+  uint16_t utilisation;   // dma / time of the last frame, in 0.1 %
+  uint16_t utilisation_avg;
+}
+render_stats_t;
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+void render_init(tft_color_t background);
+render_text_id_t render_text(uint16_t x, uint16_t y,
+    const glyph_atlas_t *atlas, tft_color_t fg, tft_color_t bg);
+void render_text_set(render_text_id_t id, const char *str);
+void render_text_color(render_text_id_t id, tft_color_t fg, tft_color_t bg);
+render_box_id_t render_box(const render_rect_t *rect, tft_color_t color);
+void render_box_set(render_box_id_t id, uint16_t w, tft_color_t color);
+void render_damage(const render_rect_t *rect);
+HAL_StatusTypeDef render_flush(void);
+void render_stats(render_stats_t *stats);
+tft_color_t *render_scratch(uint8_t index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RENDER_H */
@@ -0,0 +1,88 @@
+/**
+  ******************************************************************************
+  * @file           : screen.h
+  * @brief          : Event-driven display pipeline run by ScreenTask.
+  ******************************************************************************
+  * @attention
+  *
+  * Producers (measurement sampler, DPM callbacks, touch interrupt) post event
+  * bits with screen_notify(). ScreenTask sleeps in screen_wait() until one
+  * arrives, keeps collecting events until the next frame slot allowed by
+  * SCREEN_FPS_MAX, then renders once. Without events the task never runs.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __SCREEN_H
+#define __SCREEN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+#include "cmsis_os.h"
+
+/* Exported constants --------------------------------------------------------*/
+
+#define SCREEN_EVENT_MEASURE  (1U << 0U)   // new measurement snapshot
+#define SCREEN_EVENT_DPM      (1U << 1U)   // attach/detach or PD notification
+#define SCREEN_EVENT_TOUCH    (1U << 2U)   // touch press/release
+#define SCREEN_EVENT_CHART    (1U << 3U)   // chart column complete or rebuild
+#define SCREEN_EVENT_ALL      (SCREEN_EVENT_MEASURE | SCREEN_EVENT_DPM | \
+                               SCREEN_EVENT_TOUCH | SCREEN_EVENT_CHART)
+
+// upper bound of the redraw rate
+#ifndef SCREEN_FPS_MAX
+#define SCREEN_FPS_MAX        20U
+#endif
+
+// budget from the first event of a frame to the end of its rendering
+#ifndef SCREEN_DEADLINE_US
+#define SCREEN_DEADLINE_US    100000U
+#endif
+
+// latency overlay in place of the readouts, toggled by a long press on them
+#ifndef SCREEN_OVERLAY
+#if defined(DEBUG)
+#define SCREEN_OVERLAY        1
+#else
+#define SCREEN_OVERLAY        0
+#endif
+#endif
+
+// how long the splash image stays up before the first frame
+#ifndef SCREEN_SPLASH_MS
+#define SCREEN_SPLASH_MS      1000U
+#endif
+
+/* Exported types ------------------------------------------------------------*/
+
+typedef struct
+{
+  uint32_t frames;       // frames rendered
+  uint32_t events;       // notifications received, before coalescing
+  uint32_t render_last;  // render time of the last frame, in us
+  uint32_t render_avg;   // in us
+  uint32_t render_max;   // in us
+  uint16_t fps;          // frames per second over the last second, in 0.1
+}
+screen_stats_t;
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+void screen_init(osThreadId task);
+void screen_splash(void);
+void screen_notify(uint32_t events);
+uint32_t screen_wait(void);
+void screen_render(uint32_t events);
+void screen_stats(screen_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SCREEN_H */
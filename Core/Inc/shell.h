@@ -0,0 +1,138 @@
+/**
+  ******************************************************************************
+  * @file           : shell.h
+  * @brief          : SCPI-like command shell on USART2, run by ShellTask.
+  ******************************************************************************
+  * @attention
+  *
+  * Commands arrive through uart_rx.h and are parsed where the DMA left them;
+  * only a message that wraps around the end of the circular buffer is copied
+  * into a line buffer first. A message ends at a newline or when the line
+  * goes idle, so a host may send commands without a terminator. Several
+  * commands in one message are separated by ';', their responses are joined
+  * by ';' and the message is answered with one line of text in
+  * LINK_TYPE_RESPONSE frames on the response channel of link.h.
+  *
+  * Headers follow SCPI: keywords separated by ':', each matched in its short
+  * (upper case) or long form, case-insensitive, '?' for a query. Every
+  * header is taken from the root; there are no implied paths after ';'.
+  * Values are in base units (V, A, W) with three decimals.
+  *
+  *   *IDN?                     vendor,model,serial,link schema version
+  *   *CLS                      clear the error queue
+  *   SYSTem:ERRor?             oldest error: code,"message"; 0,"No error"
+  *   SYSTem:STATistics?        tx bytes, tx dropped bytes, rx bytes,
+  *                             rx errors, frames, dropped frames, commands,
+  *                             command errors, input overruns
+  *   SYSTem:COUNters:RESet     restart statistics, ISR profile and deadlines
+  *   SOURce:CAPabilities?      per object: type,Vmin,Vmax,Imax,Pmax
+  *   SOURce:PDO <n>            request object n, from 1
+  *   SOURce:PDO?               object of the last request,state
+  *   SOURce:VOLTage <V>        request the fixed object of that voltage
+  *   SOURce:VOLTage?           contract voltage
+  *   MEASure:VOLTage?          V
+  *   MEASure:CURRent?          A
+  *   MEASure:POWer?            W
+  *   MEASure?                  V,A,W
+  *   SYSTem:COMMunicate:SERial:NEGotiate? <rate>|MAX
+  *                             rate the port switches to, see baud.h
+  *   SYSTem:COMMunicate:SERial:CONFirm?
+  *                             confirm the new rate, answers it
+  *   SYSTem:COMMunicate:SERial:BAUD?
+  *                             rate,oversampling,state,switches,
+  *                             confirmed,fallbacks
+  *   SYSTem:COMMunicate:SERial:ERRors?
+  *                             framing,noise,overrun errors received
+  *   SYSTem:TRACe?             USB-PD trace records, sampled out, dropped,
+  *                             frames, see pd_trace.h
+  *   SYSTem:TRACe:DROPped?     records dropped per source (TRACE_EVENT)
+  *   SYSTem:TRACe:SAMPle <source>,<n>
+  *                             keep one event in n of a source
+  *   SYSTem:CAPTure ON|OFF     PD message capture, see sniff.h
+  *   SYSTem:CAPTure?           on,messages,dropped,frames
+  *   SYSTem:TASK:COUNt?        tasks in the last telemetry snapshot,
+  *                             context switches within its window
+  *   SYSTem:TASK? <n>          task n, from 1: "name",priority,load %,
+  *                             stack words never used,switches, see
+  *                             telemetry.h
+  *   SYSTem:MEMory?            kernel heap size,free bytes,fewest free
+  *                             bytes since boot
+  *   SYSTem:DEADline:COUNt?    registered deadlines
+  *   SYSTem:DEADline? <n>      deadline n, from 1: "name",budget us,count,
+  *                             missed,worst us,lateness us, then the 8
+  *                             histogram bins, see deadline.h
+  *   SYSTem:ISR:COUNt?         profiled handlers,deepest nesting
+  *   SYSTem:ISR? <n>           handler n, from 1: "name",calls,nested,
+  *                             min,max,average cycles,calls/s,load %,
+  *                             see isr_profile.h
+  *   SYSTem:SPI? <n>           SPI1 client n, 1 TOUCH, 2 TFT: name,grants,
+  *                             contended,yields,switches,timeouts,last,
+  *                             max,average wait us,bytes, see spi_bus.h
+  *   SYSTem:PD:TIMer?          PD timer periods delivered,missed,dropped,
+  *                             overruns,worst latency us,drift ms, see
+  *                             pd_timer.h
+  *   DISPlay:STATistics?       frames,events,frames/s,last,average,
+  *                             longest render us, see screen.h
+  *   DISPlay:RENDer?           frames,windows,pixels,bytes,average bytes,
+  *                             most bytes,us,most us,DMA us,stall us,
+  *                             bus use %,average bus use %; unqualified
+  *                             figures are the last frame's, see render.h
+  *
+  * The DPM only builds requests for fixed and battery objects, so a PPS
+  * voltage is refused with -221,"Settings conflict".
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __SHELL_H
+#define __SHELL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+#include "cmsis_os.h"
+
+/* Exported constants --------------------------------------------------------*/
+
+// longest message that can wrap around the receive buffer
+#ifndef SHELL_LINE_MAX
+#define SHELL_LINE_MAX        96U
+#endif
+
+// longest response line
+#ifndef SHELL_REPLY_MAX
+#define SHELL_REPLY_MAX       256U
+#endif
+
+// errors kept for SYSTem:ERRor?
+#ifndef SHELL_ERROR_QUEUE
+#define SHELL_ERROR_QUEUE     4U
+#endif
+
+/* Exported types ------------------------------------------------------------*/
+
+typedef struct
+{
+  uint32_t commands;      // commands executed
+  uint32_t errors;        // errors queued
+  uint32_t overruns;      // input lost to the DMA lapping the parser
+}
+shell_stats_t;
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+void shell_init(osThreadId task);
+void shell_wait(void);
+void shell_poll(void);
+void shell_stats(shell_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SHELL_H */
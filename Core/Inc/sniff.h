@@ -0,0 +1,111 @@
+/**
+  ******************************************************************************
+  * @file           : sniff.h
+  * @brief          : USB-PD message capture on the UCPD port.
+  ******************************************************************************
+  * @attention
+  *
+  * sniff_ucpd_isr() runs at the top of UCPD1_IRQHandler(), before the stack
+  * handles the interrupt, and copies every message that crossed the wire
+  * out of the UCPD DMA buffers while they still hold it:
+  *
+  *   - received messages at RXMSGEND, including those with a CRC error,
+  *   - transmitted messages at TXMSGSENT, TXMSGDISC or TXMSGABT, so a
+  *     retransmission shows up as the same message sent again,
+  *   - hard resets, sent or detected.
+  *
+  * GoodCRC messages travel the same way and are captured like any other.
+  * Each record holds the direction, the SOP type, the outcome, the cycle
+  * counter at the interrupt and up to SNIFF_DATA_MAX bytes of header, data
+  * objects and extended payload. The ring is statically allocated and
+  * written by the UCPD handler alone; a message that finds it full is
+  * counted as dropped. Capture costs a copy of at most SNIFF_DATA_MAX
+  * bytes per message, so it can stay on during negotiations.
+  *
+  * sniff_flush() sends the records in LINK_TYPE_CAPTURE frames on the event
+  * channel of link.h. Tools/pdcap.py turns them into a timeline with
+  * microsecond timestamps, or a pcapng file.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __SNIFF_H
+#define __SNIFF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+
+// messages held until the next flush, a power of two
+#ifndef SNIFF_RING_SIZE
+#define SNIFF_RING_SIZE       16U
+#endif
+
+// bytes kept per message: header, 7 data objects or a full chunk
+#ifndef SNIFF_DATA_MAX
+#define SNIFF_DATA_MAX        30U
+#endif
+
+// capture state after reset
+#ifndef SNIFF_DEFAULT
+#define SNIFF_DEFAULT         1U
+#endif
+
+// record info byte: direction, outcome, SOP type
+#define SNIFF_TX              0x80U
+#define SNIFF_RESULT_Pos      4U
+#define SNIFF_SOP_Msk         0x0FU
+
+/* Exported types ------------------------------------------------------------*/
+
+typedef enum
+{
+  SNIFF_SOP,
+  SNIFF_SOP1,             // SOP'
+  SNIFF_SOP2,             // SOP''
+  SNIFF_SOP1_DEBUG,
+  SNIFF_SOP2_DEBUG,
+  SNIFF_CABLE_RESET,
+  SNIFF_SOP_EXT1,
+  SNIFF_SOP_EXT2,
+  SNIFF_HARD_RESET,
+  SNIFF_SOP_UNKNOWN = 0x0F,
+}
+sniff_sop_t;
+
+typedef enum
+{
+  SNIFF_OK,               // received intact, or sent
+  SNIFF_CRC,              // received with an error
+  SNIFF_DISCARDED,        // not sent, the line was busy
+  SNIFF_ABORTED,          // cut short while sending
+}
+sniff_result_t;
+
+typedef struct
+{
+  uint8_t enabled;
+  uint32_t records;       // messages captured
+  uint32_t dropped;       // messages that found the ring full
+  uint32_t frames;        // frames handed to the link
+}
+sniff_stats_t;
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+void sniff_enable(uint8_t enable);
+void sniff_ucpd_isr(void);
+void sniff_flush(void);
+void sniff_stats(sniff_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SNIFF_H */
@@ -0,0 +1,93 @@
+/**
+  ******************************************************************************
+  * @file           : spi_bus.h
+  * @brief          : Arbiter for the SPI1 bus shared by the TFT and the touch
+  *                   controller.
+  ******************************************************************************
+  * @attention
+  *
+  * Every device on SPI1 is a client with its own chip select, clock
+  * prescaler and clock mode. A client owns the bus from spi_bus_acquire()
+  * to spi_bus_release(); the grant switches SPI1 to the client's clock
+  * settings and asserts its chip select. Clients waiting for the bus are
+  * queued by priority (lower spi_bus_client_t first), and the release hands
+  * the bus straight to the first one.
+  *
+  * Long holders (the display during a frame) call spi_bus_yield() at points
+  * where the device tolerates a pause, e.g. between DMA bands with nothing
+  * in flight. When a higher-priority client is queued the bus is handed
+  * over and taken back afterwards, so a touch sample slots in between two
+  * bands instead of waiting for the end of the frame.
+  *
+  * spi_bus_transfer() moves small transfers by polling and large write-only
+  * transfers by DMA. Before the scheduler starts there is no contention and
+  * grants are immediate.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __SPI_BUS_H
+#define __SPI_BUS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+#include "stm32g4xx_hal.h"
+
+/* Exported constants --------------------------------------------------------*/
+
+// write-only transfers of at least this many bytes use DMA
+#ifndef SPI_BUS_DMA_MIN
+#define SPI_BUS_DMA_MIN       32U
+#endif
+
+#define SPI_BUS_TIMEOUT_MS    50U
+
+/* Exported types ------------------------------------------------------------*/
+
+// in priority order, highest first
+typedef enum
+{
+  SPI_BUS_TOUCH,
+  SPI_BUS_TFT,
+  SPI_BUS_CLIENT_COUNT,
+  SPI_BUS_NONE = SPI_BUS_CLIENT_COUNT,
+}
+spi_bus_client_t;
+
+typedef struct
+{
+  uint32_t grants;        // times the client got the bus
+  uint32_t contended;     // grants that had to wait for another client
+  uint32_t yields;        // times the client handed the bus over mid-use
+  uint32_t switches;      // clock/mode changes made for the client
+  uint32_t timeouts;      // acquisitions given up
+  uint32_t wait_last;     // us waited for the last contended grant
+  uint32_t wait_max;      // in us
+  uint32_t wait_avg;      // in us, over contended grants
+  uint32_t bytes;         // moved by spi_bus_transfer()
+}
+spi_bus_stats_t;
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+void spi_bus_init(void);
+HAL_StatusTypeDef spi_bus_acquire(spi_bus_client_t client, uint32_t timeout);
+void spi_bus_release(spi_bus_client_t client);
+uint8_t spi_bus_contended(spi_bus_client_t client);
+uint8_t spi_bus_yield(spi_bus_client_t client);
+HAL_StatusTypeDef spi_bus_transfer(spi_bus_client_t client,
+    const uint8_t *tx, uint8_t *rx, uint16_t size);
+void spi_bus_transfer_complete(HAL_StatusTypeDef status);
+void spi_bus_stats(spi_bus_client_t client, spi_bus_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SPI_BUS_H */
@@ -0,0 +1,81 @@
+/**
+  ******************************************************************************
+  * @file           : telemetry.h
+  * @brief          : Per-task CPU load, stack high-water and context switch
+  *                   snapshots.
+  ******************************************************************************
+  * @attention
+  *
+  * Run time is accounted by the kernel from the DWT cycle counter
+  * (configGENERATE_RUN_TIME_STATS), context switches by the trace hooks
+  * installed in FreeRTOSConfig.h. Since the cycle counter wraps after ~25 s,
+  * telemetry_sample() must be called at least that often for the load figures
+  * to be meaningful. The shell reports the snapshot with SYSTem:TASK?.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __TELEMETRY_H
+#define __TELEMETRY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+
+/* Exported constants --------------------------------------------------------*/
+
+// number of tasks tracked at once (CAD, PE, screen, default, idle, ...)
+#ifndef TELEMETRY_MAX_TASKS
+#define TELEMETRY_MAX_TASKS  8U
+#endif
+
+// interval at which the default task refreshes the snapshot
+#ifndef TELEMETRY_PERIOD_MS
+#define TELEMETRY_PERIOD_MS  1000U
+#endif
+
+/* Exported types ------------------------------------------------------------*/
+
+typedef struct
+{
+  char     name[configMAX_TASK_NAME_LEN];
+  uint8_t  priority;     // current (possibly inherited) priority
+  uint16_t load;         // CPU load over the last window, in 0.1 %
+  uint16_t stack_free;   // stack high-water mark, in words never used
+  uint32_t switches;     // context switches into the task since creation
+  uint32_t run_time;     // cycles spent running (wraps, see cycles.h)
+}
+telemetry_task_t;
+
+typedef struct
+{
+  uint32_t sequence;     // incremented by every telemetry_sample()
+  uint32_t tick;         // kernel tick at which the snapshot was taken
+  uint32_t window;       // cycles covered by the load figures
+  uint32_t switches;     // total context switches within the window
+  uint8_t  count;        // valid entries in task[]
+  telemetry_task_t task[TELEMETRY_MAX_TASKS];
+}
+telemetry_snapshot_t;
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+void telemetry_sample(void);
+void telemetry_snapshot(telemetry_snapshot_t *snapshot);
+
+// kernel hooks, see FreeRTOSConfig.h
+void telemetry_configure_timer(void);
+void telemetry_task_switched_in(void *task);
+void telemetry_task_deleted(void *task);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TELEMETRY_H */
@@ -0,0 +1,91 @@
+/**
+  ******************************************************************************
+  * @file           : tft.h
+  * @brief          : Raw ILI9341 address-window writes over SPI1 with DMA.
+  ******************************************************************************
+  * @attention
+  *
+  * The ili9341 library still resets and configures the panel (orientation,
+  * touch), this module only opens column/page address windows and streams
+  * RGB565 pixel data into them with hdma_spi1_tx. Callers must own the
+  * display (screen lock) between tft_begin() and tft_end(), which also
+  * acquire and release SPI1 through the bus arbiter. Long draws call
+  * tft_yield() between bands so a touch sample does not wait for the end
+  * of the frame.
+  *
+  * Commands go out in 8-bit SPI frames. Pixels switch SPI1 to 16-bit frames
+  * and the DMA channel to half-word beats, so pixel buffers hold native
+  * RGB565 values and every pixel is a single DMA beat. Solid fills keep the
+  * DMA source address fixed on one colour instead of expanding it in RAM.
+  * tft_end() and tft_window() restore 8-bit frames.
+  *
+  * Hardware scrolling (VSCRDEF/VSCRSADD) works on GRAM lines along the
+  * panel's 320-pixel axis, which in the landscape orientation is screen x:
+  * a scroll area is a full-height band of columns, and tft_scroll() picks
+  * the column shown at its left edge. Window addresses are not affected.
+  *
+  * tft_write_async() returns as soon as the DMA transfer is started so the
+  * caller can prepare the next buffer; tft_wait() blocks until the SPI TX
+  * complete callback fires. At most one transfer is in flight, and it must
+  * be waited for before the next window, write or tft_end().
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __TFT_H
+#define __TFT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+#include "stm32g4xx_hal.h"
+
+/* Exported constants --------------------------------------------------------*/
+
+// panel size in the landscape orientation configured by ili9341_new()
+#define TFT_WIDTH             320U
+#define TFT_HEIGHT            240U
+
+#define TFT_BYTES_PER_PIXEL   2U
+#define TFT_WINDOW_BYTES      11U   // CASET + 4, PASET + 4, RAMWR
+
+// longest a single DMA transfer may take before it is reported as an error
+#ifndef TFT_DMA_TIMEOUT_MS
+#define TFT_DMA_TIMEOUT_MS    50U
+#endif
+
+/* Exported types ------------------------------------------------------------*/
+
+typedef uint16_t tft_color_t;   // RGB565
+
+/* Exported macro ------------------------------------------------------------*/
+
+#define TFT_RGB(r, g, b) \
+  ((tft_color_t)((((r) & 0xF8U) << 8U) | (((g) & 0xFCU) << 3U) | ((b) >> 3U)))
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+void tft_init(void);
+void tft_begin(void);
+void tft_end(void);
+uint8_t tft_yield(void);
+HAL_StatusTypeDef tft_window(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1);
+HAL_StatusTypeDef tft_write(const tft_color_t *pixels, uint32_t count);
+HAL_StatusTypeDef tft_write_async(const tft_color_t *pixels, uint32_t count);
+HAL_StatusTypeDef tft_fill(tft_color_t color, uint32_t count);
+HAL_StatusTypeDef tft_scroll_area(uint16_t x, uint16_t width);
+HAL_StatusTypeDef tft_scroll(uint16_t x);
+HAL_StatusTypeDef tft_wait(void);
+uint32_t tft_busy_cycles(void);
+void tft_transfer_complete(HAL_StatusTypeDef status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TFT_H */
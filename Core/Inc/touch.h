@@ -0,0 +1,148 @@
+/**
+  ******************************************************************************
+  * @file           : touch.h
+  * @brief          : Deferred, filtered XPT2046 touch input run by TouchTask.
+  ******************************************************************************
+  * @attention
+  *
+  * The pen interrupt only timestamps the edge and wakes TouchTask. The task
+  * samples the controller over the shared SPI1 bus every TOUCH_SAMPLE_MS
+  * while the pen is down: TOUCH_MEDIAN conversions per axis are reduced to
+  * their median, mapped to screen coordinates and smoothed by a first-order
+  * IIR filter (weight 1/2^TOUCH_IIR_SHIFT). Samples below TOUCH_PRESSURE_MIN
+  * count as lifted.
+  *
+  * TOUCH_PRESS_SAMPLES consecutive pressed samples make a press and
+  * TOUCH_RELEASE_SAMPLES lifted ones a release; drags are reported after
+  * TOUCH_DRAG_MIN pixels of movement and a long press once after
+  * TOUCH_LONG_PRESS_MS. Events go into a small queue drained with
+  * touch_event(), the listener is told after each one. The delay from the
+  * pen edge to the press event is measured, it is about
+  * TOUCH_PRESS_SAMPLES - 1 sample periods plus the sampling time.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __TOUCH_H
+#define __TOUCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+#include "cmsis_os.h"
+
+/* Exported constants --------------------------------------------------------*/
+
+// sample period while the pen is down
+#ifndef TOUCH_SAMPLE_MS
+#define TOUCH_SAMPLE_MS         10U
+#endif
+
+// conversions per axis and sample, odd
+#ifndef TOUCH_MEDIAN
+#define TOUCH_MEDIAN            5U
+#endif
+
+#ifndef TOUCH_IIR_SHIFT
+#define TOUCH_IIR_SHIFT         2U
+#endif
+
+// z1 + 4095 - z2, larger is firmer
+#ifndef TOUCH_PRESSURE_MIN
+#define TOUCH_PRESSURE_MIN      400U
+#endif
+
+#ifndef TOUCH_PRESS_SAMPLES
+#define TOUCH_PRESS_SAMPLES     2U
+#endif
+#ifndef TOUCH_RELEASE_SAMPLES
+#define TOUCH_RELEASE_SAMPLES   3U
+#endif
+
+#ifndef TOUCH_DRAG_MIN
+#define TOUCH_DRAG_MIN          4U
+#endif
+
+#ifndef TOUCH_LONG_PRESS_MS
+#define TOUCH_LONG_PRESS_MS     800U
+#endif
+
+#ifndef TOUCH_QUEUE_SIZE
+#define TOUCH_QUEUE_SIZE        8U
+#endif
+
+// raw 12-bit readings at the screen edges, landscape with x along the
+// controller's Y axis
+#ifndef TOUCH_RAW_X_MIN
+#define TOUCH_RAW_X_MIN         300U
+#endif
+#ifndef TOUCH_RAW_X_MAX
+#define TOUCH_RAW_X_MAX         3800U
+#endif
+#ifndef TOUCH_RAW_Y_MIN
+#define TOUCH_RAW_Y_MIN         300U
+#endif
+#ifndef TOUCH_RAW_Y_MAX
+#define TOUCH_RAW_Y_MAX         3800U
+#endif
+
+/* Exported types ------------------------------------------------------------*/
+
+typedef enum
+{
+  TOUCH_PRESS,
+  TOUCH_DRAG,
+  TOUCH_LONG_PRESS,
+  TOUCH_RELEASE,
+}
+touch_type_t;
+
+typedef struct
+{
+  touch_type_t type;
+  uint16_t x;             // screen pixels, filtered
+  uint16_t y;
+  uint32_t tick;          // osKernelSysTick() when generated
+  uint32_t edge;          // cycle counter at the pen edge for a press, at
+                          // the start of the sample behind it otherwise
+  uint32_t cycles;        // cycle counter when generated
+}
+touch_event_t;
+
+typedef struct
+{
+  uint32_t irqs;          // pen edges that woke the task
+  uint32_t samples;       // controller reads
+  uint32_t rejected;      // samples below the pressure threshold
+  uint32_t events;        // queued
+  uint32_t dropped;       // lost to a full queue
+  uint32_t bus_timeouts;  // samples skipped, SPI1 not granted in time
+  uint32_t sample_time;   // us per controller read, last
+  uint32_t latency_last;  // us from the pen edge to the press event
+  uint32_t latency_max;
+  uint32_t latency_avg;
+  uint16_t rate;          // samples per second over the last second
+}
+touch_stats_t;
+
+typedef void (*touch_listener_t)(void);
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+void touch_init(osThreadId task, touch_listener_t listener);
+void touch_irq(void);
+void touch_wait(void);
+void touch_sample(void);
+uint8_t touch_event(touch_event_t *event);
+void touch_stats(touch_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TOUCH_H */
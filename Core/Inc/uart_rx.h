@@ -0,0 +1,85 @@
+/**
+  ******************************************************************************
+  * @file           : uart_rx.h
+  * @brief          : Circular DMA receive on USART2 with idle-line detection.
+  ******************************************************************************
+  * @attention
+  *
+  * DMA1 channel 5 writes everything USART2 receives into a circular buffer
+  * that is never copied: the consumer reads bytes in place, addressed by a
+  * free-running count of bytes received. The count is rebuilt from the DMA
+  * remaining-length register and the number of completed laps. The channel
+  * and the USART2 interrupt (both at priority 6, with the transmit side) are
+  * configured in upd-data.ioc.
+  *
+  * The listener task is signalled at each half and full buffer and when the
+  * line goes idle (one character time without a start bit); the count at the
+  * last idle line tells the consumer where the host stopped sending.
+  *
+  * Nothing stops the DMA from overwriting bytes the consumer has not read
+  * yet. The consumer detects this by comparing counts and resynchronises.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __UART_RX_H
+#define __UART_RX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+#include "cmsis_os.h"
+
+/* Exported constants --------------------------------------------------------*/
+
+// circular buffer size, a power of two
+#ifndef UART_RX_BUFFER_SIZE
+#define UART_RX_BUFFER_SIZE   256U
+#endif
+
+// signal set on the listener task
+#define UART_RX_SIGNAL        0x01U
+
+/* Exported types ------------------------------------------------------------*/
+
+typedef struct
+{
+  uint32_t idles;         // idle lines detected
+  uint32_t framing;       // stop bit missing, usually a baud rate mismatch
+  uint32_t noise;         // samples of a bit disagreeing
+  uint32_t overruns;      // bytes lost before the DMA read them
+}
+uart_rx_stats_t;
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Receive errors of all kinds.
+  * @param  stats: from uart_rx_stats()
+  * @retval Framing, noise and overrun errors
+  */
+static inline uint32_t uart_rx_errors(const uart_rx_stats_t *stats)
+{
+  return stats->framing + stats->noise + stats->overruns;
+}
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+void uart_rx_init(void);
+void uart_rx_listen(osThreadId task);
+uint32_t uart_rx_received(uint32_t *idle);
+const uint8_t *uart_rx_buffer(void);
+void uart_rx_isr(void);
+void uart_rx_dma_isr(void);
+void uart_rx_stats(uart_rx_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __UART_RX_H */
@@ -0,0 +1,97 @@
+/**
+  ******************************************************************************
+  * @file           : uart_tx.h
+  * @brief          : Non-blocking, DMA-driven USART2 transmit ring.
+  ******************************************************************************
+  * @attention
+  *
+  * Any number of producers (tasks and interrupt handlers at any priority)
+  * append to one ring without locks: a write reserves its span with a
+  * compare-and-swap on the packed (head, writers) word, copies, and retires.
+  * The last writer to retire publishes everything reserved so far, so a
+  * producer preempted while copying only delays the bytes behind it, it
+  * never blocks the others.
+  *
+  * DMA1 channel 3 drains the ring in normal mode, one chunk at a time: the
+  * chunk is copied out of the ring into a small transfer buffer and the next
+  * one is chained from the transfer complete interrupt. Bytes leave the ring
+  * as soon as they are copied, which is what lets drop-oldest reclaim
+  * anything not already on the wire. The USART FIFO covers the refill
+  * latency between chunks. The FIFO mode, the channel and its interrupt
+  * (priority 6, below the PD stack) are configured in upd-data.ioc.
+  *
+  * A write is stored whole or not at all. When it does not fit, the policy
+  * decides: UART_TX_DROP_NEWEST refuses it, UART_TX_DROP_OLDEST discards
+  * queued bytes from the front (possibly cutting a line) and stores it.
+  * Either way the loss is counted and the producer returns immediately.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __UART_TX_H
+#define __UART_TX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+
+typedef enum
+{
+  UART_TX_DROP_NEWEST,    // refuse the write that does not fit
+  UART_TX_DROP_OLDEST,    // discard queued bytes to make room for it
+}
+uart_tx_policy_t;
+
+typedef struct
+{
+  uint32_t writes;        // writes stored
+  uint32_t bytes;         // bytes stored
+  uint32_t sent;          // bytes handed to the DMA
+  uint32_t transfers;     // DMA transfers started
+  uint32_t overflows;     // writes that found the ring full
+  uint32_t dropped_new;   // bytes of refused writes
+  uint32_t dropped_old;   // queued bytes discarded to make room
+  uint32_t errors;        // DMA transfer errors
+  uint32_t high_water;    // most bytes ever queued
+}
+uart_tx_stats_t;
+
+/* Exported constants --------------------------------------------------------*/
+
+// ring capacity, a power of two no larger than 16 KiB
+#ifndef UART_TX_BUFFER_SIZE
+#define UART_TX_BUFFER_SIZE   512U
+#endif
+
+// longest single DMA transfer
+#ifndef UART_TX_DMA_CHUNK
+#define UART_TX_DMA_CHUNK     64U
+#endif
+
+#ifndef UART_TX_POLICY
+#define UART_TX_POLICY        UART_TX_DROP_NEWEST
+#endif
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+void uart_tx_init(void);
+size_t uart_tx_write(const void *data, size_t len);
+size_t uart_tx_write_limit(const void *data, size_t len, size_t limit);
+size_t uart_tx_pending(void);
+uint8_t uart_tx_idle(void);
+void uart_tx_set_policy(uart_tx_policy_t policy);
+void uart_tx_isr(void);
+void uart_tx_stats(uart_tx_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __UART_TX_H */
@@ -0,0 +1,95 @@
+/**
+  ******************************************************************************
+  * @file           : ui_latency.h
+  * @brief          : Touch-to-pixel latency tracing of the UI pipeline.
+  ******************************************************************************
+  * @attention
+  *
+  * A trace follows one touch event from the pen edge (or the sample that
+  * produced it) to the moment the damage it caused is on the panel:
+  *
+  *   INPUT   edge -> event queued       TouchTask sampling and debounce
+  *   HANDLE  event -> handled           queueing and frame pacing
+  *   RENDER  handled -> last band out   rasterizing, bus and preemption
+  *   DMA     last band -> complete      the final SPI transfer
+  *   TOTAL   edge -> complete
+  *
+  * The screen task opens a trace for the first event of a frame, the
+  * renderer marks the last band and the screen closes it once the flush
+  * returned. Marks without an open trace are ignored, so traces never
+  * overlap. Each stage feeds a histogram of power-of-two buckets starting
+  * at UI_LATENCY_BUCKET_US; compare RENDER with render_stats() and the
+  * SPI1 wait figures of spi_bus_stats() to see whether the renderer, the
+  * bus or higher-priority (PD) tasks make up a slow frame.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __UI_LATENCY_H
+#define __UI_LATENCY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+
+// upper bound of the first bucket, each following one doubles it; the last
+// bucket takes everything above
+#ifndef UI_LATENCY_BUCKET_US
+#define UI_LATENCY_BUCKET_US    250U
+#endif
+#ifndef UI_LATENCY_BUCKETS
+#define UI_LATENCY_BUCKETS      10U
+#endif
+
+/* Exported types ------------------------------------------------------------*/
+
+typedef enum
+{
+  UI_LATENCY_INPUT,
+  UI_LATENCY_HANDLE,
+  UI_LATENCY_RENDER,
+  UI_LATENCY_DMA,
+  UI_LATENCY_TOTAL,
+  UI_LATENCY_STAGES
+}
+ui_latency_stage_t;
+
+typedef struct
+{
+  uint32_t count;
+  uint32_t last;          // in us
+  uint32_t max;           // in us
+  uint32_t avg;           // in us
+  uint32_t bucket[UI_LATENCY_BUCKETS];
+}
+ui_latency_hist_t;
+
+typedef struct
+{
+  uint32_t traces;        // completed
+  uint32_t skipped;       // events handled while a trace was open
+  ui_latency_hist_t stage[UI_LATENCY_STAGES];
+}
+ui_latency_stats_t;
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+void ui_latency_begin(uint32_t edge, uint32_t event);
+void ui_latency_handled(void);
+void ui_latency_rendered(void);
+void ui_latency_end(void);
+void ui_latency_stats(ui_latency_stats_t *stats);
+uint32_t ui_latency_percentile(const ui_latency_hist_t *hist, uint8_t percent);
+const char *ui_latency_name(ui_latency_stage_t stage);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __UI_LATENCY_H */
@@ -0,0 +1,86 @@
+/**
+  ******************************************************************************
+  * @file           : ui_layout.h
+  * @brief          : Static widget tree and hit-test grid, generated by
+  *                   Tools/ui_layout.py. Do not edit.
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __UI_LAYOUT_H
+#define __UI_LAYOUT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "widget.h"
+
+/* Exported constants --------------------------------------------------------*/
+
+#define UI_WIDGETS            34U
+#define UI_TEXT_SLOTS         19U
+// renderer items the tree allocates
+#define UI_TEXT_ITEMS         24U
+#define UI_BOX_ITEMS          3U
+
+#define UI_HIT_CELL           16U
+#define UI_HIT_COLS           20U
+#define UI_HIT_ROWS           15U
+#define UI_HIT_TABLE          22U
+
+#define UI_PDO_ROWS           7U
+#define UI_LATENCY_ROWS       5U
+
+/* Exported types ------------------------------------------------------------*/
+
+enum
+{
+  UI_ROOT,                    // panel
+  UI_READOUTS,                //   panel
+  UI_LIVE,                    //     panel
+  UI_VBUS_LABEL,              //       label
+  UI_VBUS,                    //       number
+  UI_IBUS_LABEL,              //       label
+  UI_IBUS,                    //       number
+  UI_PBUS_LABEL,              //       label
+  UI_PBUS,                    //       number
+  UI_POWER,                   //       bar
+  UI_PD,                      //       panel
+  UI_PD_LABEL,                //         label
+  UI_PD_DETACHED,             //         label
+  UI_PD_VOLTAGE,              //         number
+  UI_PD_CURRENT,              //         number
+  UI_PDOS,                    //     panel
+  UI_PDO,                     //       list
+  UI_PDO_0,                   //         label
+  UI_PDO_1,                   //         label
+  UI_PDO_2,                   //         label
+  UI_PDO_3,                   //         label
+  UI_PDO_4,                   //         label
+  UI_PDO_5,                   //         label
+  UI_PDO_6,                   //         label
+  UI_PDO_STATUS,              //       label
+  UI_PDO_BACK,                //       button
+  UI_OVERLAY,                 //     panel
+  UI_LATENCY,                 //       list
+  UI_LATENCY_0,               //         label
+  UI_LATENCY_1,               //         label
+  UI_LATENCY_2,               //         label
+  UI_LATENCY_3,               //         label
+  UI_LATENCY_4,               //         label
+  UI_CHART,                   //   chart
+};
+
+/* Exported variables --------------------------------------------------------*/
+
+extern const widget_def_t ui_layout[UI_WIDGETS];
+extern const uint8_t ui_hit_grid[UI_HIT_ROWS][UI_HIT_COLS];
+extern const widget_id_t ui_hit_table[UI_HIT_TABLE];
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __UI_LAYOUT_H */
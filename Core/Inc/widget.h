@@ -0,0 +1,120 @@
+/**
+  ******************************************************************************
+  * @file           : widget.h
+  * @brief          : Retained-mode widget tree on top of the renderer.
+  ******************************************************************************
+  * @attention
+  *
+  * The tree is generated by Tools/ui_layout.py into ui_layout.h/.c: one
+  * const widget_def_t per widget in depth-first order, with absolute bounds,
+  * text origins, text buffer slots and a coarse hit-test grid (per cell, the
+  * touchable widgets over it) all resolved at build time. Only the mutable
+  * part of each widget (value, text, visibility, pressed state) lives in
+  * RAM.
+  *
+  * Setters compare against the current state and mark a widget dirty only
+  * when something visible changed; widget_update() then walks the dirty set
+  * and hands just those widgets to the renderer, which in turn damages only
+  * the cells or columns that differ. Hiding a panel blanks its subtree,
+  * showing it redraws the subtree.
+  *
+  * The chart widget only reserves its bounds and takes touches, the plot
+  * itself is drawn by chart.c into the panel's scroll area.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __WIDGET_H
+#define __WIDGET_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+#include "glyph.h"
+#include "render.h"
+#include "tft.h"
+#include "touch.h"
+
+/* Exported constants --------------------------------------------------------*/
+
+// longest text held by a label, button or list row, terminator included
+#define WIDGET_TEXT_LEN       RENDER_TEXT_LEN
+
+#define WIDGET_NONE           0xFFU
+#define WIDGET_SLOT_NONE      0xFFU
+
+// widget_def_t flags
+#define WIDGET_FLAG_TOUCH     (1U << 0U)   // takes touches, in the hit grid
+#define WIDGET_FLAG_HIDDEN    (1U << 1U)   // starts hidden
+
+/* Exported types ------------------------------------------------------------*/
+
+typedef enum
+{
+  WIDGET_PANEL,           // groups children, draws nothing itself
+  WIDGET_LABEL,           // text
+  WIDGET_NUMBER,          // value in thousandths, right-aligned, with unit
+  WIDGET_BAR,             // horizontal bar, value out of range
+  WIDGET_BUTTON,          // box with a centred caption, inverted while held
+  WIDGET_CHART,           // area drawn by chart.c
+  WIDGET_LIST,            // rows of labels, the value selects one
+}
+widget_type_t;
+
+typedef uint8_t widget_id_t;
+
+typedef struct
+{
+  uint8_t type;           // widget_type_t
+  widget_id_t parent;     // WIDGET_NONE for the root
+  widget_id_t end;        // one past the last descendant
+  uint8_t flags;          // WIDGET_FLAG_*
+  render_rect_t bounds;   // screen coordinates
+  uint16_t text_x;        // origin of the text, screen coordinates
+  uint16_t text_y;
+  const glyph_atlas_t *atlas;
+  tft_color_t fg;
+  tft_color_t bg;
+  const char *text;       // initial text, unit of a number
+  uint8_t cells;          // text width in glyph cells
+  uint8_t decimals;       // numbers: fraction digits shown
+  uint8_t slot;           // text buffer, WIDGET_SLOT_NONE without
+  int32_t range;          // bars: initial full scale
+}
+widget_def_t;
+
+typedef struct
+{
+  uint32_t invalidations; // widgets marked dirty
+  uint32_t updates;       // dirty widgets handed to the renderer
+  uint32_t hits;          // touches that landed on a widget
+  uint32_t update_time;   // us spent in the last widget_update()
+}
+widget_stats_t;
+
+/* Exported functions prototypes ---------------------------------------------*/
+
+void widget_init(void);
+void widget_set_text(widget_id_t id, const char *str);
+void widget_set_value(widget_id_t id, int32_t value);
+void widget_set_range(widget_id_t id, int32_t range);
+void widget_show(widget_id_t id, uint8_t visible);
+void widget_invalidate(widget_id_t id);
+uint8_t widget_visible(widget_id_t id);
+void widget_list_set(widget_id_t id, uint8_t row, const char *str);
+uint8_t widget_list_row(widget_id_t id, uint16_t y);
+widget_id_t widget_hit(uint16_t x, uint16_t y);
+widget_id_t widget_touch(const touch_event_t *event);
+void widget_update(void);
+void widget_stats(widget_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __WIDGET_H */
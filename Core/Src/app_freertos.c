@@ -35,6 +35,20 @@
 
 #include "ina260.h"
 
+#include "telemetry.h"
+#include "isr_profile.h"
+#include "chart.h"
+#include "dlog.h"
+#include "link.h"
+#include "measure.h"
+#include "pd_trace.h"
+#include "screen.h"
+#include "shell.h"
+#include "sniff.h"
+#include "spi_bus.h"
+#include "tft.h"
+#include "touch.h"
+
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -56,6 +70,8 @@
 /* USER CODE BEGIN Variables */
 
 osThreadId screenTaskHandle;
+osThreadId touchTaskHandle;
+osThreadId shellTaskHandle;
 osSemaphoreId screenLockHandle;
 
 /* USER CODE END Variables */
@@ -65,6 +81,11 @@ osThreadId defaultTaskHandle;
 /* USER CODE BEGIN FunctionPrototypes */
 
 void ScreenTask(void const * argument);
+void TouchTask(void const * argument);
+void ShellTask(void const * argument);
+static void measureChanged(void);
+static void chartChanged(void);
+static void touchChanged(void);
 
 /* USER CODE END FunctionPrototypes */
 
@@ -72,6 +93,27 @@ void StartDefaultTask(void const * argument);
 
 void MX_FREERTOS_Init(void); /* (MISRA C 2004 rule 8.1) */
 
+/* Hook prototypes */
+void vApplicationStackOverflowHook(TaskHandle_t xTask, signed char *pcTaskName);
+
+/* USER CODE BEGIN 4 */
+/*
+ * Task stacks are checked at every context switch (configCHECK_FOR_STACK_OVERFLOW
+ * 2). Past that point the stack below the task is corrupt and nothing can be
+ * trusted: keep the name where a debugger finds it and stop, as configASSERT.
+ */
+volatile const char *stackOverflowTask;
+
+void vApplicationStackOverflowHook(TaskHandle_t xTask, signed char *pcTaskName)
+{
+  (void)xTask;
+  stackOverflowTask = (const char *)pcTaskName;
+
+  taskDISABLE_INTERRUPTS();
+  for (;;) { }
+}
+/* USER CODE END 4 */
+
 /**
   * @brief  FreeRTOS initialization
   * @param  None
@@ -82,12 +124,15 @@ void MX_FREERTOS_Init(void) {
   /* USER CODE END Init */
 
   /* USER CODE BEGIN RTOS_MUTEX */
-  /* add mutexes, ... */
+  measure_init(measureChanged);
+  chart_init(chartChanged);
   /* USER CODE END RTOS_MUTEX */
 
   /* USER CODE BEGIN RTOS_SEMAPHORES */
   osSemaphoreDef(screenLock);
   screenLockHandle = osSemaphoreCreate(osSemaphore(screenLock), 1);
+  spi_bus_init();
+  tft_init();
   /* USER CODE END RTOS_SEMAPHORES */
 
   /* USER CODE BEGIN RTOS_TIMERS */
@@ -100,12 +145,23 @@ void MX_FREERTOS_Init(void) {
 
   /* Create the thread(s) */
   /* definition and creation of defaultTask */
-  osThreadDef(defaultTask, StartDefaultTask, osPriorityNormal, 0, configMINIMAL_STACK_SIZE);
+  osThreadDef(defaultTask, StartDefaultTask, osPriorityNormal, 0, 384);
   defaultTaskHandle = osThreadCreate(osThread(defaultTask), NULL);
 
   /* USER CODE BEGIN RTOS_THREADS */
   osThreadDef(screenTask, ScreenTask, osPriorityNormal, 0, 1024);
   screenTaskHandle = osThreadCreate(osThread(screenTask), NULL);
+  screen_init(screenTaskHandle);
+
+  // above the screen task so samples preempt a frame between bands
+  osThreadDef(touchTask, TouchTask, osPriorityAboveNormal, 0, 256);
+  touchTaskHandle = osThreadCreate(osThread(touchTask), NULL);
+  touch_init(touchTaskHandle, touchChanged);
+
+  // below the measurement loop, commands are not time critical
+  osThreadDef(shellTask, ShellTask, osPriorityBelowNormal, 0, 384);
+  shellTaskHandle = osThreadCreate(osThread(shellTask), NULL);
+  shell_init(shellTaskHandle);
   /* USER CODE END RTOS_THREADS */
 
 }
@@ -120,10 +176,44 @@ void MX_FREERTOS_Init(void) {
 void StartDefaultTask(void const * argument)
 {
   /* USER CODE BEGIN StartDefaultTask */
+  /*
+   * Stack: 384 words (upd-data.ioc). The deepest path is link_sample() into
+   * link_send(), ~130 bytes with its frame buffer, then the UART queue;
+   * telemetry_sample() and the INA260 reads over HAL I2C stay below it.
+   * With a preemption on top (exception frame and saved context, FPU
+   * included, ~50 words) that is ~120 words, at the old 128-word limit.
+   * Check the stack_free telemetry reports for the task (the
+   * uxTaskGetStackHighWaterMark figure) after changing this path.
+   */
+  uint32_t elapsed = 0U;
+  uint32_t charted = 0U;
+
   /* Infinite loop */
   for(;;)
   {
-    osDelay(1);
+    osDelay(MEASURE_PERIOD_MS);
+    if (HAL_OK == measure_sample())
+    {
+      measure_snapshot_t m;
+      measure_snapshot(&m);
+      link_sample(&m);
+
+      // the chart keeps its own, slower pace so its ring spans a full plot
+      charted += MEASURE_PERIOD_MS;
+      if (charted >= CHART_PERIOD_MS)
+      {
+        charted = 0U;
+        chart_push(m.voltage, m.current);
+      }
+    }
+
+    elapsed += MEASURE_PERIOD_MS;
+    if (elapsed >= TELEMETRY_PERIOD_MS)
+    {
+      elapsed = 0U;
+      telemetry_sample();
+      isr_profile_sample();
+    }
   }
   /* USER CODE END StartDefaultTask */
 }
@@ -132,19 +222,28 @@ void StartDefaultTask(void const * argument)
 /* USER CODE BEGIN Application */
 void ScreenTask(void const * argument)
 {
+  if (NULL != screenLockHandle)
+  {
+    if (osOK == osSemaphoreWait(screenLockHandle, osWaitForever))
+    {
+      screen_splash();
+
+      osSemaphoreRelease(screenLockHandle);
+    }
+  }
+
+  // first frame draws the initial state
+  screen_notify(SCREEN_EVENT_ALL);
+
   for (;;)
   {
+    uint32_t events = screen_wait();
+
     if (NULL != screenLockHandle)
     {
       if (osOK == osSemaphoreWait(screenLockHandle, osWaitForever))
       {
-        ili9341_t *lcd = display();
-        ina260_t *pow = power();
-
-        (void)lcd;
-        (void)pow;
-
-        osDelay(1);
+        screen_render(events);
 
         osSemaphoreRelease(screenLockHandle);
       }
@@ -152,6 +251,42 @@ void ScreenTask(void const * argument)
   }
 }
 
+void TouchTask(void const * argument)
+{
+  for (;;)
+  {
+    touch_wait();
+    touch_sample();
+  }
+}
+
+void ShellTask(void const * argument)
+{
+  for (;;)
+  {
+    shell_wait();
+    shell_poll();
+    dlog_flush();
+    pd_trace_flush();
+    sniff_flush();
+  }
+}
+
+static void measureChanged(void)
+{
+  screen_notify(SCREEN_EVENT_MEASURE);
+}
+
+static void chartChanged(void)
+{
+  screen_notify(SCREEN_EVENT_CHART);
+}
+
+static void touchChanged(void)
+{
+  screen_notify(SCREEN_EVENT_TOUCH);
+}
+
 /* USER CODE END Application */
 
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
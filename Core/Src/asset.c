@@ -0,0 +1,295 @@
+/**
+  ******************************************************************************
+  * @file           : asset.c
+  * @brief          : Streaming decoder for the compressed image assets.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "asset.h"
+#include "cycles.h"
+#include "render.h"
+#include "spi_bus.h"
+
+/* Private define ------------------------------------------------------------*/
+
+#if (ASSET_BUFFER_PIXELS > RENDER_STRIP_PIXELS)
+#error "ASSET_BUFFER_PIXELS does not fit in a render strip"
+#endif
+
+/* Private variables ---------------------------------------------------------*/
+
+// decoder state, owned by the task drawing
+static uint16_t _count;         // pixels in the current buffer
+static uint8_t _buf;            // buffer being decoded into
+static tft_color_t _run_color;  // run waiting to be sent as a fill
+static uint32_t _run_count;
+static uint32_t _stall;         // cycles spent waiting for the bus
+
+static asset_stats_t _stats;
+static asset_stats_t _last;
+
+/* Private function prototypes -----------------------------------------------*/
+
+static HAL_StatusTypeDef _run(tft_color_t color, uint32_t count);
+static HAL_StatusTypeDef _literal(const tft_color_t *palette, const uint8_t *index, uint16_t count);
+static HAL_StatusTypeDef _flush(void);
+static HAL_StatusTypeDef _fill(void);
+static HAL_StatusTypeDef _wait(void);
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Decode an image straight to the display. Caller must own the
+  *         display.
+  * @param  image: compiled image
+  * @param  x, y: top-left corner, the image must fit on the screen
+  * @retval HAL status of the first failed transfer, HAL_OK otherwise
+  */
+HAL_StatusTypeDef asset_draw(const asset_image_t *image, uint16_t x, uint16_t y)
+{
+  HAL_StatusTypeDef status;
+  uint32_t start;
+
+  if ((NULL == image) || (0U == image->width) || (0U == image->height) ||
+      (((uint32_t)x + image->width) > TFT_WIDTH) ||
+      (((uint32_t)y + image->height) > TFT_HEIGHT))
+    { return HAL_ERROR; }
+
+  start = cycles_now();
+  _count = 0U;
+  _run_count = 0U;
+  _stall = 0U;
+  _last = (asset_stats_t){ 0U };
+
+  tft_begin();
+
+  status = tft_window(x, y, x + image->width - 1U, y + image->height - 1U);
+
+  for (uint16_t row = 0U; (row < image->height) && (HAL_OK == status); ++row)
+  {
+    const uint8_t *src = &image->data[image->rows[row]];
+    uint16_t left = image->width;
+
+    // drain everything queued so touch can take the bus, then reopen the
+    // window on the remaining rows
+    if (0U != spi_bus_contended(SPI_BUS_TFT))
+    {
+      status = _flush();
+      if (HAL_OK == status)
+        { status = _fill(); }
+      if (HAL_OK == status)
+        { status = _wait(); }
+      if ((HAL_OK == status) && (0U != tft_yield()))
+      {
+        status = tft_window(x, y + row,
+            x + image->width - 1U, y + image->height - 1U);
+      }
+    }
+
+    // rows never share an opcode, so a corrupt row cannot spill into the next
+    while ((left > 0U) && (HAL_OK == status))
+    {
+      uint8_t op = *src++;
+      uint16_t n;
+
+      if (op <= ASSET_LITERAL_MAX)
+      {
+        n = (uint16_t)op + 1U;
+        if (n > left)
+          { n = left; }
+        status = _literal(image->palette, src, n);
+        src += n;
+      }
+      else
+      {
+        if (ASSET_LONG_RUN == op)
+        {
+          n = (uint16_t)src[0] | ((uint16_t)src[1] << 8U);
+          src += 2U;
+        }
+        else
+          { n = (uint16_t)op - ASSET_LITERAL_MAX; }
+        if (n > left)
+          { n = left; }
+        status = _run(image->palette[*src++], n);
+      }
+
+      left -= n;
+    }
+  }
+
+  if (HAL_OK == status)
+    { status = _flush(); }
+  if (HAL_OK == status)
+    { status = _fill(); }
+  if (HAL_OK == status)
+    { status = _wait(); }
+  else
+    { (void)tft_wait(); }
+
+  tft_end();
+
+  uint32_t cycles = cycles_since(start);
+  uint32_t time = cycles_to_us(cycles);
+  uint32_t decode = cycles_to_us(cycles - _stall);
+
+  _last.pixels      = (uint32_t)image->width * image->height;
+  _last.time        = time;
+  _last.decode      = decode;
+  _last.rate        = (0U == time) ? 0U : (uint32_t)(((uint64_t)_last.pixels * 1000U) / time);
+  _last.decode_rate = (0U == decode) ? 0U : (uint32_t)(((uint64_t)_last.pixels * 1000U) / decode);
+  _last.saved       = asset_saved(image);
+
+  taskENTER_CRITICAL();
+  _last.images = _stats.images + 1U;
+  _stats = _last;
+  taskEXIT_CRITICAL();
+
+  return status;
+}
+
+/**
+  * @brief  Copy the decoder statistics.
+  * @param  stats: destination
+  * @retval None
+  */
+void asset_stats(asset_stats_t *stats)
+{
+  if (NULL == stats)
+    { return; }
+
+  taskENTER_CRITICAL();
+  *stats = _stats;
+  taskEXIT_CRITICAL();
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Queue count pixels of one colour. Long runs, and anything that
+  *         extends the run already queued, become a fill; short ones are
+  *         decoded into the line buffer.
+  */
+static HAL_StatusTypeDef _run(tft_color_t color, uint32_t count)
+{
+  HAL_StatusTypeDef status = HAL_OK;
+
+  if ((0U != _run_count) && (color == _run_color))
+  {
+    _run_count += count;
+    return HAL_OK;
+  }
+
+  if (count >= ASSET_FILL_MIN)
+  {
+    status = _flush();
+    if (HAL_OK == status)
+      { status = _fill(); }
+    _run_color = color;
+    _run_count = count;
+    return status;
+  }
+
+  status = _fill();
+
+  while ((count > 0U) && (HAL_OK == status))
+  {
+    tft_color_t *dst = &render_scratch(_buf)[_count];
+    uint32_t n = ASSET_BUFFER_PIXELS - _count;
+    if (n > count)
+      { n = count; }
+
+    for (uint32_t i = 0U; i < n; ++i)
+      { dst[i] = color; }
+    _count += (uint16_t)n;
+    count -= n;
+
+    if (_count >= ASSET_BUFFER_PIXELS)
+      { status = _flush(); }
+  }
+
+  return status;
+}
+
+static HAL_StatusTypeDef _literal(const tft_color_t *palette, const uint8_t *index, uint16_t count)
+{
+  HAL_StatusTypeDef status = _fill();
+
+  while ((count > 0U) && (HAL_OK == status))
+  {
+    tft_color_t *dst = &render_scratch(_buf)[_count];
+    uint16_t n = ASSET_BUFFER_PIXELS - _count;
+    if (n > count)
+      { n = count; }
+
+    for (uint16_t i = 0U; i < n; ++i)
+      { dst[i] = palette[index[i]]; }
+    _count += n;
+    index += n;
+    count -= n;
+
+    if (_count >= ASSET_BUFFER_PIXELS)
+      { status = _flush(); }
+  }
+
+  return status;
+}
+
+/**
+  * @brief  Send the current line buffer and switch to the other one, which
+  *         is free once the transfer before this one has completed.
+  */
+static HAL_StatusTypeDef _flush(void)
+{
+  HAL_StatusTypeDef status;
+
+  if (0U == _count)
+    { return HAL_OK; }
+
+  status = _wait();
+  if (HAL_OK == status)
+    { status = tft_write_async(render_scratch(_buf), _count); }
+
+  _buf ^= 1U;
+  _count = 0U;
+  ++_last.writes;
+
+  return status;
+}
+
+/**
+  * @brief  Send the queued run, if any, as a DMA fill.
+  */
+static HAL_StatusTypeDef _fill(void)
+{
+  HAL_StatusTypeDef status;
+
+  if (0U == _run_count)
+    { return HAL_OK; }
+
+  status = _wait();
+  if (HAL_OK == status)
+    { status = tft_fill(_run_color, _run_count); }
+
+  _last.filled += _run_count;
+  ++_last.fills;
+  _run_count = 0U;
+
+  return status;
+}
+
+static HAL_StatusTypeDef _wait(void)
+{
+  uint32_t wait = cycles_now();
+  HAL_StatusTypeDef status = tft_wait();
+
+  _stall += cycles_since(wait);
+
+  return status;
+}
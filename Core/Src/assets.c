@@ -0,0 +1,325 @@
+/**
+  ******************************************************************************
+  * @file           : assets.c
+  * @brief          : Compressed image assets, generated by
+  *                   Tools/asset_compiler.py from Assets/. Do not edit.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "assets.h"
+
+/* Private variables ---------------------------------------------------------*/
+
+// bolt: 20x20, 2 colours, 800 -> 160 bytes
+static const uint16_t _bolt_palette[] =
+{
+  0x0000, 0xFEC0,
+};
+
+static const uint16_t _bolt_rows[] =
+{
+      0,     7,    14,    20,    26,    32,    38,    44,    50,    56,
+     62,    68,    74,    80,    86,    93,   100,   106,   112,   114,
+};
+
+static const uint8_t _bolt_data[] =
+{
+  0x8A, 0x00, 0x01, 0x01, 0x01, 0x86, 0x00, 0x89, 0x00, 0x01, 0x01, 0x01, 0x87, 0x00, 0x88, 0x00,
+  0x82, 0x01, 0x87, 0x00, 0x87, 0x00, 0x82, 0x01, 0x88, 0x00, 0x87, 0x00, 0x82, 0x01, 0x88, 0x00,
+  0x86, 0x00, 0x83, 0x01, 0x88, 0x00, 0x85, 0x00, 0x83, 0x01, 0x89, 0x00, 0x85, 0x00, 0x89, 0x01,
+  0x83, 0x00, 0x84, 0x00, 0x89, 0x01, 0x84, 0x00, 0x83, 0x00, 0x89, 0x01, 0x85, 0x00, 0x82, 0x00,
+  0x89, 0x01, 0x86, 0x00, 0x88, 0x00, 0x83, 0x01, 0x86, 0x00, 0x88, 0x00, 0x82, 0x01, 0x87, 0x00,
+  0x87, 0x00, 0x82, 0x01, 0x88, 0x00, 0x87, 0x00, 0x01, 0x01, 0x01, 0x89, 0x00, 0x87, 0x00, 0x01,
+  0x01, 0x01, 0x89, 0x00, 0x87, 0x00, 0x00, 0x01, 0x8A, 0x00, 0x86, 0x00, 0x00, 0x01, 0x8B, 0x00,
+  0x93, 0x00, 0x93, 0x00,
+};
+
+// splash: 320x240, 4 colours, 153600 -> 4106 bytes
+static const uint16_t _splash_palette[] =
+{
+  0x10C6, 0xFFFF, 0xFEC0, 0x6392,
+};
+
+static const uint16_t _splash_rows[] =
+{
+      0,     4,     8,    12,    16,    20,    24,    28,    32,    36,
+     40,    44,    48,    52,    56,    60,    64,    68,    72,    76,
+     80,    84,    88,    92,    96,   100,   104,   108,   112,   116,
+    120,   124,   128,   132,   136,   140,   144,   148,   152,   156,
+    160,   164,   168,   172,   176,   180,   184,   188,   192,   196,
+    200,   204,   208,   212,   216,   220,   224,   228,   232,   236,
+    240,   244,   248,   252,   256,   260,   264,   268,   272,   276,
+    280,   314,   348,   382,   416,   450,   484,   538,   592,   646,
+    700,   754,   808,   862,   916,   970,  1024,  1078,  1132,  1186,
+   1240,  1294,  1348,  1402,  1456,  1498,  1540,  1582,  1624,  1666,
+   1708,  1758,  1808,  1858,  1908,  1958,  2008,  2046,  2084,  2122,
+   2160,  2198,  2236,  2240,  2244,  2248,  2252,  2256,  2260,  2264,
+   2268,  2272,  2276,  2280,  2284,  2292,  2300,  2308,  2316,  2324,
+   2332,  2336,  2340,  2344,  2348,  2352,  2356,  2360,  2364,  2368,
+   2372,  2376,  2380,  2384,  2388,  2392,  2396,  2452,  2508,  2582,
+   2656,  2728,  2800,  2860,  2920,  2989,  3058,  3128,  3198,  3248,
+   3298,  3302,  3306,  3310,  3314,  3318,  3322,  3326,  3330,  3334,
+   3338,  3342,  3346,  3350,  3354,  3358,  3362,  3366,  3370,  3374,
+   3378,  3382,  3386,  3390,  3394,  3398,  3402,  3406,  3410,  3414,
+   3418,  3422,  3426,  3430,  3434,  3438,  3442,  3446,  3450,  3454,
+   3458,  3462,  3466,  3470,  3474,  3478,  3482,  3486,  3490,  3494,
+   3498,  3502,  3506,  3510,  3514,  3518,  3522,  3526,  3530,  3534,
+   3538,  3542,  3546,  3550,  3554,  3558,  3562,  3566,  3570,  3574,
+   3578,  3582,  3586,  3590,  3594,  3598,  3602,  3606,  3610,  3614,
+};
+
+static const uint8_t _splash_data[] =
+{
+  0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00,
+  0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00,
+  0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00,
+  0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00,
+  0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00,
+  0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00,
+  0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00,
+  0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00,
+  0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00,
+  0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00,
+  0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00,
+  0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00,
+  0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00,
+  0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00,
+  0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00,
+  0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00,
+  0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00,
+  0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0x92, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01,
+  0x85, 0x00, 0x97, 0x01, 0x8B, 0x00, 0x91, 0x01, 0xB5, 0x00, 0x91, 0x01, 0x97, 0x00, 0x91, 0x01,
+  0x8B, 0x00, 0x9D, 0x01, 0x8B, 0x00, 0x91, 0x01, 0x98, 0x00, 0x92, 0x00, 0x85, 0x01, 0x91, 0x00,
+  0x85, 0x01, 0x85, 0x00, 0x97, 0x01, 0x8B, 0x00, 0x91, 0x01, 0xB5, 0x00, 0x91, 0x01, 0x97, 0x00,
+  0x91, 0x01, 0x8B, 0x00, 0x9D, 0x01, 0x8B, 0x00, 0x91, 0x01, 0x98, 0x00, 0x92, 0x00, 0x85, 0x01,
+  0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x97, 0x01, 0x8B, 0x00, 0x91, 0x01, 0xB5, 0x00, 0x91, 0x01,
+  0x97, 0x00, 0x91, 0x01, 0x8B, 0x00, 0x9D, 0x01, 0x8B, 0x00, 0x91, 0x01, 0x98, 0x00, 0x92, 0x00,
+  0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x97, 0x01, 0x8B, 0x00, 0x91, 0x01, 0xB5, 0x00,
+  0x91, 0x01, 0x97, 0x00, 0x91, 0x01, 0x8B, 0x00, 0x9D, 0x01, 0x8B, 0x00, 0x91, 0x01, 0x98, 0x00,
+  0x92, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x97, 0x01, 0x8B, 0x00, 0x91, 0x01,
+  0xB5, 0x00, 0x91, 0x01, 0x97, 0x00, 0x91, 0x01, 0x8B, 0x00, 0x9D, 0x01, 0x8B, 0x00, 0x91, 0x01,
+  0x98, 0x00, 0x92, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x97, 0x01, 0x8B, 0x00,
+  0x91, 0x01, 0xB5, 0x00, 0x91, 0x01, 0x97, 0x00, 0x91, 0x01, 0x8B, 0x00, 0x9D, 0x01, 0x8B, 0x00,
+  0x91, 0x01, 0x98, 0x00, 0x92, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x85, 0x01,
+  0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x85, 0x01, 0x8B, 0x00, 0x85, 0x01, 0xAF, 0x00, 0x85, 0x01,
+  0x8B, 0x00, 0x85, 0x01, 0x8B, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01,
+  0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x92, 0x00, 0x92, 0x00, 0x85, 0x01, 0x91, 0x00,
+  0x85, 0x01, 0x85, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x85, 0x01, 0x8B, 0x00,
+  0x85, 0x01, 0xAF, 0x00, 0x85, 0x01, 0x8B, 0x00, 0x85, 0x01, 0x8B, 0x00, 0x85, 0x01, 0x91, 0x00,
+  0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x92, 0x00,
+  0x92, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01,
+  0x85, 0x00, 0x85, 0x01, 0x8B, 0x00, 0x85, 0x01, 0xAF, 0x00, 0x85, 0x01, 0x8B, 0x00, 0x85, 0x01,
+  0x8B, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01,
+  0x91, 0x00, 0x85, 0x01, 0x92, 0x00, 0x92, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00,
+  0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x85, 0x01, 0x8B, 0x00, 0x85, 0x01, 0xAF, 0x00,
+  0x85, 0x01, 0x8B, 0x00, 0x85, 0x01, 0x8B, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00,
+  0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x92, 0x00, 0x92, 0x00, 0x85, 0x01,
+  0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x85, 0x01,
+  0x8B, 0x00, 0x85, 0x01, 0xAF, 0x00, 0x85, 0x01, 0x8B, 0x00, 0x85, 0x01, 0x8B, 0x00, 0x85, 0x01,
+  0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01,
+  0x92, 0x00, 0x92, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x85, 0x01, 0x91, 0x00,
+  0x85, 0x01, 0x85, 0x00, 0x85, 0x01, 0x8B, 0x00, 0x85, 0x01, 0xAF, 0x00, 0x85, 0x01, 0x8B, 0x00,
+  0x85, 0x01, 0x8B, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00,
+  0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x92, 0x00, 0x92, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01,
+  0x85, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01,
+  0xA9, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01,
+  0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x92, 0x00, 0x92, 0x00,
+  0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00,
+  0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0xA9, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00,
+  0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00,
+  0x85, 0x01, 0x92, 0x00, 0x92, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x85, 0x01,
+  0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0xA9, 0x00, 0x85, 0x01,
+  0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01,
+  0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x92, 0x00, 0x92, 0x00, 0x85, 0x01, 0x91, 0x00,
+  0x85, 0x01, 0x85, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x85, 0x01, 0x91, 0x00,
+  0x85, 0x01, 0xA9, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x85, 0x01, 0x91, 0x00,
+  0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x92, 0x00,
+  0x92, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01,
+  0x85, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0xA9, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01,
+  0x85, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01,
+  0x91, 0x00, 0x85, 0x01, 0x92, 0x00, 0x92, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00,
+  0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0xA9, 0x00,
+  0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00,
+  0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x92, 0x00, 0x92, 0x00, 0x85, 0x01,
+  0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x97, 0x01, 0x8B, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01,
+  0x85, 0x00, 0x9D, 0x01, 0x85, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x85, 0x01,
+  0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01,
+  0x92, 0x00, 0x92, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x97, 0x01, 0x8B, 0x00,
+  0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x9D, 0x01, 0x85, 0x00, 0x85, 0x01, 0x91, 0x00,
+  0x85, 0x01, 0x85, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00,
+  0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x92, 0x00, 0x92, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01,
+  0x85, 0x00, 0x97, 0x01, 0x8B, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x9D, 0x01,
+  0x85, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01,
+  0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x92, 0x00, 0x92, 0x00,
+  0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x97, 0x01, 0x8B, 0x00, 0x85, 0x01, 0x91, 0x00,
+  0x85, 0x01, 0x85, 0x00, 0x9D, 0x01, 0x85, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00,
+  0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00,
+  0x85, 0x01, 0x92, 0x00, 0x92, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x97, 0x01,
+  0x8B, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x9D, 0x01, 0x85, 0x00, 0x85, 0x01,
+  0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01,
+  0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x92, 0x00, 0x92, 0x00, 0x85, 0x01, 0x91, 0x00,
+  0x85, 0x01, 0x85, 0x00, 0x97, 0x01, 0x8B, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00,
+  0x9D, 0x01, 0x85, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x85, 0x01, 0x91, 0x00,
+  0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x92, 0x00,
+  0x92, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x85, 0x01, 0x9D, 0x00, 0x85, 0x01,
+  0x91, 0x00, 0x85, 0x01, 0xA9, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x9D, 0x01,
+  0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x9D, 0x01, 0x92, 0x00, 0x92, 0x00, 0x85, 0x01, 0x91, 0x00,
+  0x85, 0x01, 0x85, 0x00, 0x85, 0x01, 0x9D, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0xA9, 0x00,
+  0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x9D, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00,
+  0x9D, 0x01, 0x92, 0x00, 0x92, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x85, 0x01,
+  0x9D, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0xA9, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01,
+  0x85, 0x00, 0x9D, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x9D, 0x01, 0x92, 0x00, 0x92, 0x00,
+  0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x85, 0x01, 0x9D, 0x00, 0x85, 0x01, 0x91, 0x00,
+  0x85, 0x01, 0xA9, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x9D, 0x01, 0x91, 0x00,
+  0x85, 0x01, 0x91, 0x00, 0x9D, 0x01, 0x92, 0x00, 0x92, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01,
+  0x85, 0x00, 0x85, 0x01, 0x9D, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0xA9, 0x00, 0x85, 0x01,
+  0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x9D, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x9D, 0x01,
+  0x92, 0x00, 0x92, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x85, 0x01, 0x9D, 0x00,
+  0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0xA9, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00,
+  0x9D, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x9D, 0x01, 0x92, 0x00, 0x92, 0x00, 0x85, 0x01,
+  0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x85, 0x01, 0x9D, 0x00, 0x85, 0x01, 0x8B, 0x00, 0x85, 0x01,
+  0xAF, 0x00, 0x85, 0x01, 0x8B, 0x00, 0x85, 0x01, 0x8B, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01,
+  0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x92, 0x00, 0x92, 0x00,
+  0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x85, 0x01, 0x9D, 0x00, 0x85, 0x01, 0x8B, 0x00,
+  0x85, 0x01, 0xAF, 0x00, 0x85, 0x01, 0x8B, 0x00, 0x85, 0x01, 0x8B, 0x00, 0x85, 0x01, 0x91, 0x00,
+  0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x92, 0x00,
+  0x92, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x85, 0x01, 0x9D, 0x00, 0x85, 0x01,
+  0x8B, 0x00, 0x85, 0x01, 0xAF, 0x00, 0x85, 0x01, 0x8B, 0x00, 0x85, 0x01, 0x8B, 0x00, 0x85, 0x01,
+  0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01,
+  0x92, 0x00, 0x92, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x85, 0x01, 0x9D, 0x00,
+  0x85, 0x01, 0x8B, 0x00, 0x85, 0x01, 0xAF, 0x00, 0x85, 0x01, 0x8B, 0x00, 0x85, 0x01, 0x8B, 0x00,
+  0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00,
+  0x85, 0x01, 0x92, 0x00, 0x92, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00, 0x85, 0x01,
+  0x9D, 0x00, 0x85, 0x01, 0x8B, 0x00, 0x85, 0x01, 0xAF, 0x00, 0x85, 0x01, 0x8B, 0x00, 0x85, 0x01,
+  0x8B, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01,
+  0x91, 0x00, 0x85, 0x01, 0x92, 0x00, 0x92, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x85, 0x00,
+  0x85, 0x01, 0x9D, 0x00, 0x85, 0x01, 0x8B, 0x00, 0x85, 0x01, 0xAF, 0x00, 0x85, 0x01, 0x8B, 0x00,
+  0x85, 0x01, 0x8B, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00,
+  0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x92, 0x00, 0x98, 0x00, 0x91, 0x01, 0x8B, 0x00, 0x85, 0x01,
+  0x9D, 0x00, 0x91, 0x01, 0xB5, 0x00, 0x91, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01,
+  0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x92, 0x00, 0x98, 0x00,
+  0x91, 0x01, 0x8B, 0x00, 0x85, 0x01, 0x9D, 0x00, 0x91, 0x01, 0xB5, 0x00, 0x91, 0x01, 0x91, 0x00,
+  0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00,
+  0x85, 0x01, 0x92, 0x00, 0x98, 0x00, 0x91, 0x01, 0x8B, 0x00, 0x85, 0x01, 0x9D, 0x00, 0x91, 0x01,
+  0xB5, 0x00, 0x91, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01,
+  0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x92, 0x00, 0x98, 0x00, 0x91, 0x01, 0x8B, 0x00,
+  0x85, 0x01, 0x9D, 0x00, 0x91, 0x01, 0xB5, 0x00, 0x91, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00,
+  0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x92, 0x00,
+  0x98, 0x00, 0x91, 0x01, 0x8B, 0x00, 0x85, 0x01, 0x9D, 0x00, 0x91, 0x01, 0xB5, 0x00, 0x91, 0x01,
+  0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01,
+  0x91, 0x00, 0x85, 0x01, 0x92, 0x00, 0x98, 0x00, 0x91, 0x01, 0x8B, 0x00, 0x85, 0x01, 0x9D, 0x00,
+  0x91, 0x01, 0xB5, 0x00, 0x91, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00,
+  0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x91, 0x00, 0x85, 0x01, 0x92, 0x00, 0xFF, 0x40, 0x01, 0x00,
+  0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00,
+  0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00,
+  0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xA7, 0x00, 0xFF, 0xF0,
+  0x00, 0x02, 0xA7, 0x00, 0xA7, 0x00, 0xFF, 0xF0, 0x00, 0x02, 0xA7, 0x00, 0xA7, 0x00, 0xFF, 0xF0,
+  0x00, 0x02, 0xA7, 0x00, 0xA7, 0x00, 0xFF, 0xF0, 0x00, 0x02, 0xA7, 0x00, 0xA7, 0x00, 0xFF, 0xF0,
+  0x00, 0x02, 0xA7, 0x00, 0xA7, 0x00, 0xFF, 0xF0, 0x00, 0x02, 0xA7, 0x00, 0xFF, 0x40, 0x01, 0x00,
+  0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00,
+  0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00,
+  0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00,
+  0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xDE, 0x00, 0x01, 0x03,
+  0x03, 0x85, 0x00, 0x01, 0x03, 0x03, 0x83, 0x00, 0x87, 0x03, 0x01, 0x00, 0x00, 0x87, 0x03, 0x8F,
+  0x00, 0x87, 0x03, 0x83, 0x00, 0x85, 0x03, 0x93, 0x00, 0x87, 0x03, 0x83, 0x00, 0x85, 0x03, 0x83,
+  0x00, 0x01, 0x03, 0x03, 0x85, 0x00, 0x05, 0x03, 0x03, 0x00, 0x00, 0x03, 0x03, 0x85, 0x00, 0x01,
+  0x03, 0x03, 0xDE, 0x00, 0xDE, 0x00, 0x01, 0x03, 0x03, 0x85, 0x00, 0x01, 0x03, 0x03, 0x83, 0x00,
+  0x87, 0x03, 0x01, 0x00, 0x00, 0x87, 0x03, 0x8F, 0x00, 0x87, 0x03, 0x83, 0x00, 0x85, 0x03, 0x93,
+  0x00, 0x87, 0x03, 0x83, 0x00, 0x85, 0x03, 0x83, 0x00, 0x01, 0x03, 0x03, 0x85, 0x00, 0x05, 0x03,
+  0x03, 0x00, 0x00, 0x03, 0x03, 0x85, 0x00, 0x01, 0x03, 0x03, 0xDE, 0x00, 0xDE, 0x00, 0x01, 0x03,
+  0x03, 0x85, 0x00, 0x05, 0x03, 0x03, 0x00, 0x00, 0x03, 0x03, 0x89, 0x00, 0x01, 0x03, 0x03, 0x85,
+  0x00, 0x01, 0x03, 0x03, 0x8D, 0x00, 0x01, 0x03, 0x03, 0x85, 0x00, 0x05, 0x03, 0x03, 0x00, 0x00,
+  0x03, 0x03, 0x83, 0x00, 0x01, 0x03, 0x03, 0x8F, 0x00, 0x01, 0x03, 0x03, 0x8D, 0x00, 0x01, 0x03,
+  0x03, 0x85, 0x00, 0x01, 0x03, 0x03, 0x85, 0x00, 0x05, 0x03, 0x03, 0x00, 0x00, 0x03, 0x03, 0x83,
+  0x00, 0x01, 0x03, 0x03, 0xE0, 0x00, 0xDE, 0x00, 0x01, 0x03, 0x03, 0x85, 0x00, 0x05, 0x03, 0x03,
+  0x00, 0x00, 0x03, 0x03, 0x89, 0x00, 0x01, 0x03, 0x03, 0x85, 0x00, 0x01, 0x03, 0x03, 0x8D, 0x00,
+  0x01, 0x03, 0x03, 0x85, 0x00, 0x05, 0x03, 0x03, 0x00, 0x00, 0x03, 0x03, 0x83, 0x00, 0x01, 0x03,
+  0x03, 0x8F, 0x00, 0x01, 0x03, 0x03, 0x8D, 0x00, 0x01, 0x03, 0x03, 0x85, 0x00, 0x01, 0x03, 0x03,
+  0x85, 0x00, 0x05, 0x03, 0x03, 0x00, 0x00, 0x03, 0x03, 0x83, 0x00, 0x01, 0x03, 0x03, 0xE0, 0x00,
+  0xDE, 0x00, 0x01, 0x03, 0x03, 0x85, 0x00, 0x05, 0x03, 0x03, 0x00, 0x00, 0x03, 0x03, 0x89, 0x00,
+  0x01, 0x03, 0x03, 0x85, 0x00, 0x01, 0x03, 0x03, 0x8D, 0x00, 0x01, 0x03, 0x03, 0x85, 0x00, 0x05,
+  0x03, 0x03, 0x00, 0x00, 0x03, 0x03, 0x85, 0x00, 0x01, 0x03, 0x03, 0x8D, 0x00, 0x01, 0x03, 0x03,
+  0x8D, 0x00, 0x01, 0x03, 0x03, 0x85, 0x00, 0x83, 0x03, 0x83, 0x00, 0x09, 0x03, 0x03, 0x00, 0x00,
+  0x03, 0x03, 0x00, 0x00, 0x03, 0x03, 0xE2, 0x00, 0xDE, 0x00, 0x01, 0x03, 0x03, 0x85, 0x00, 0x05,
+  0x03, 0x03, 0x00, 0x00, 0x03, 0x03, 0x89, 0x00, 0x01, 0x03, 0x03, 0x85, 0x00, 0x01, 0x03, 0x03,
+  0x8D, 0x00, 0x01, 0x03, 0x03, 0x85, 0x00, 0x05, 0x03, 0x03, 0x00, 0x00, 0x03, 0x03, 0x85, 0x00,
+  0x01, 0x03, 0x03, 0x8D, 0x00, 0x01, 0x03, 0x03, 0x8D, 0x00, 0x01, 0x03, 0x03, 0x85, 0x00, 0x83,
+  0x03, 0x83, 0x00, 0x09, 0x03, 0x03, 0x00, 0x00, 0x03, 0x03, 0x00, 0x00, 0x03, 0x03, 0xE2, 0x00,
+  0xDE, 0x00, 0x01, 0x03, 0x03, 0x85, 0x00, 0x01, 0x03, 0x03, 0x83, 0x00, 0x85, 0x03, 0x83, 0x00,
+  0x87, 0x03, 0x8F, 0x00, 0x87, 0x03, 0x83, 0x00, 0x01, 0x03, 0x03, 0x85, 0x00, 0x01, 0x03, 0x03,
+  0x8F, 0x00, 0x85, 0x03, 0x87, 0x00, 0x01, 0x03, 0x03, 0x85, 0x00, 0x0B, 0x03, 0x03, 0x00, 0x00,
+  0x03, 0x03, 0x00, 0x00, 0x03, 0x03, 0x00, 0x00, 0x83, 0x03, 0xE4, 0x00, 0xDE, 0x00, 0x01, 0x03,
+  0x03, 0x85, 0x00, 0x01, 0x03, 0x03, 0x83, 0x00, 0x85, 0x03, 0x83, 0x00, 0x87, 0x03, 0x8F, 0x00,
+  0x87, 0x03, 0x83, 0x00, 0x01, 0x03, 0x03, 0x85, 0x00, 0x01, 0x03, 0x03, 0x8F, 0x00, 0x85, 0x03,
+  0x87, 0x00, 0x01, 0x03, 0x03, 0x85, 0x00, 0x0B, 0x03, 0x03, 0x00, 0x00, 0x03, 0x03, 0x00, 0x00,
+  0x03, 0x03, 0x00, 0x00, 0x83, 0x03, 0xE4, 0x00, 0xDE, 0x00, 0x01, 0x03, 0x03, 0x85, 0x00, 0x01,
+  0x03, 0x03, 0x89, 0x00, 0x05, 0x03, 0x03, 0x00, 0x00, 0x03, 0x03, 0x85, 0x00, 0x01, 0x03, 0x03,
+  0x8D, 0x00, 0x01, 0x03, 0x03, 0x89, 0x00, 0x01, 0x03, 0x03, 0x85, 0x00, 0x01, 0x03, 0x03, 0x95,
+  0x00, 0x01, 0x03, 0x03, 0x85, 0x00, 0x01, 0x03, 0x03, 0x85, 0x00, 0x01, 0x03, 0x03, 0x83, 0x00,
+  0x83, 0x03, 0x07, 0x00, 0x00, 0x03, 0x03, 0x00, 0x00, 0x03, 0x03, 0xE2, 0x00, 0xDE, 0x00, 0x01,
+  0x03, 0x03, 0x85, 0x00, 0x01, 0x03, 0x03, 0x89, 0x00, 0x05, 0x03, 0x03, 0x00, 0x00, 0x03, 0x03,
+  0x85, 0x00, 0x01, 0x03, 0x03, 0x8D, 0x00, 0x01, 0x03, 0x03, 0x89, 0x00, 0x01, 0x03, 0x03, 0x85,
+  0x00, 0x01, 0x03, 0x03, 0x95, 0x00, 0x01, 0x03, 0x03, 0x85, 0x00, 0x01, 0x03, 0x03, 0x85, 0x00,
+  0x01, 0x03, 0x03, 0x83, 0x00, 0x83, 0x03, 0x07, 0x00, 0x00, 0x03, 0x03, 0x00, 0x00, 0x03, 0x03,
+  0xE2, 0x00, 0xDE, 0x00, 0x01, 0x03, 0x03, 0x85, 0x00, 0x01, 0x03, 0x03, 0x89, 0x00, 0x05, 0x03,
+  0x03, 0x00, 0x00, 0x03, 0x03, 0x85, 0x00, 0x01, 0x03, 0x03, 0x8D, 0x00, 0x01, 0x03, 0x03, 0x89,
+  0x00, 0x01, 0x03, 0x03, 0x83, 0x00, 0x01, 0x03, 0x03, 0x97, 0x00, 0x01, 0x03, 0x03, 0x85, 0x00,
+  0x01, 0x03, 0x03, 0x85, 0x00, 0x01, 0x03, 0x03, 0x85, 0x00, 0x05, 0x03, 0x03, 0x00, 0x00, 0x03,
+  0x03, 0x83, 0x00, 0x01, 0x03, 0x03, 0xE0, 0x00, 0xDE, 0x00, 0x01, 0x03, 0x03, 0x85, 0x00, 0x01,
+  0x03, 0x03, 0x89, 0x00, 0x05, 0x03, 0x03, 0x00, 0x00, 0x03, 0x03, 0x85, 0x00, 0x01, 0x03, 0x03,
+  0x8D, 0x00, 0x01, 0x03, 0x03, 0x89, 0x00, 0x01, 0x03, 0x03, 0x83, 0x00, 0x01, 0x03, 0x03, 0x97,
+  0x00, 0x01, 0x03, 0x03, 0x85, 0x00, 0x01, 0x03, 0x03, 0x85, 0x00, 0x01, 0x03, 0x03, 0x85, 0x00,
+  0x05, 0x03, 0x03, 0x00, 0x00, 0x03, 0x03, 0x83, 0x00, 0x01, 0x03, 0x03, 0xE0, 0x00, 0xE0, 0x00,
+  0x85, 0x03, 0x83, 0x00, 0x87, 0x03, 0x83, 0x00, 0x87, 0x03, 0x8F, 0x00, 0x01, 0x03, 0x03, 0x89,
+  0x00, 0x85, 0x03, 0x91, 0x00, 0x87, 0x03, 0x85, 0x00, 0x85, 0x03, 0x83, 0x00, 0x01, 0x03, 0x03,
+  0x85, 0x00, 0x05, 0x03, 0x03, 0x00, 0x00, 0x03, 0x03, 0x85, 0x00, 0x01, 0x03, 0x03, 0xDE, 0x00,
+  0xE0, 0x00, 0x85, 0x03, 0x83, 0x00, 0x87, 0x03, 0x83, 0x00, 0x87, 0x03, 0x8F, 0x00, 0x01, 0x03,
+  0x03, 0x89, 0x00, 0x85, 0x03, 0x91, 0x00, 0x87, 0x03, 0x85, 0x00, 0x85, 0x03, 0x83, 0x00, 0x01,
+  0x03, 0x03, 0x85, 0x00, 0x05, 0x03, 0x03, 0x00, 0x00, 0x03, 0x03, 0x85, 0x00, 0x01, 0x03, 0x03,
+  0xDE, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40,
+  0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40,
+  0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40,
+  0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40,
+  0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40,
+  0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40,
+  0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40,
+  0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40,
+  0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40,
+  0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40,
+  0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40,
+  0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40,
+  0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40,
+  0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40,
+  0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40,
+  0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40,
+  0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40,
+  0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40,
+  0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40,
+  0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40, 0x01, 0x00, 0xFF, 0x40,
+  0x01, 0x00,
+};
+
+/* Exported constants --------------------------------------------------------*/
+
+const asset_image_t asset_bolt =
+{
+  .width   = 20U,
+  .height  = 20U,
+  .colors  = 2U,
+  .size    = 160U,
+  .palette = _bolt_palette,
+  .rows    = _bolt_rows,
+  .data    = _bolt_data,
+};
+
+const asset_image_t asset_splash =
+{
+  .width   = 320U,
+  .height  = 240U,
+  .colors  = 4U,
+  .size    = 4106U,
+  .palette = _splash_palette,
+  .rows    = _splash_rows,
+  .data    = _splash_data,
+};
@@ -0,0 +1,239 @@
+/**
+  ******************************************************************************
+  * @file           : baud.c
+  * @brief          : USART2 baud rate negotiation with verification and
+  *                   fallback.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "stm32g4xx_ll_rcc.h"
+#include "stm32g4xx_ll_usart.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "cmsis_os.h"
+
+#include "baud.h"
+#include "uart_rx.h"
+#include "uart_tx.h"
+
+/* Private variables ---------------------------------------------------------*/
+
+// rates offered, ascending, the first one is BAUD_SAFE_RATE
+static const uint32_t _rates[] =
+{
+  BAUD_SAFE_RATE, 230400U, 460800U, 921600U, 1000000U, 2000000U,
+  3000000U, 4000000U, 6000000U, 8000000U, 12000000U,
+};
+
+#define BAUD_RATES            (sizeof(_rates) / sizeof(_rates[0]))
+
+static uint8_t _strikes[BAUD_RATES];
+
+static uint8_t _current;         // index of the rate in use
+static uint8_t _previous;        // index to return to if a trial fails
+static uint8_t _next;            // index of the pending switch
+static uint32_t _since;          // tick of the last state change or window
+static uint32_t _errors;         // receive errors at _since
+
+static baud_stats_t _stats =
+{
+  .rate = BAUD_SAFE_RATE,
+  .oversampling = 16U,
+  .state = BAUD_STEADY,
+};
+
+/* Private function prototypes -----------------------------------------------*/
+
+static uint8_t _oversampling(uint32_t clock, uint32_t rate);
+static void _apply(uint8_t index);
+static void _fail(uint8_t fallback);
+static uint32_t _rx_errors(void);
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Pick a faster rate and schedule the switch to it; the caller
+  *         answers with the rate before baud_poll() applies it.
+  * @param  rate: most the host can do, UINT32_MAX for no limit
+  * @retval Rate to switch to, the current one if nothing better qualifies
+  */
+uint32_t baud_negotiate(uint32_t rate)
+{
+  uint32_t clock = LL_RCC_GetUSARTClockFreq(LL_RCC_USART2_CLKSOURCE);
+  uint8_t best = 0U;
+
+  // a negotiation in progress is settled first
+  if (BAUD_STEADY != _stats.state)
+    { return _stats.rate; }
+
+  for (uint8_t i = 0U; i < BAUD_RATES; ++i)
+  {
+    if ((_rates[i] <= rate) && (_strikes[i] < BAUD_STRIKES_MAX) &&
+        (0U != _oversampling(clock, _rates[i])))
+      { best = i; }
+  }
+
+  if (best != _current)
+  {
+    _next   = best;
+    _since  = osKernelSysTick();
+    _stats.state = BAUD_SWITCH;
+  }
+
+  return _rates[best];
+}
+
+/**
+  * @brief  The host reads the new rate back: the trial succeeded.
+  * @retval 1 if a trial was confirmed
+  */
+uint8_t baud_confirm(void)
+{
+  if (BAUD_TRIAL != _stats.state)
+    { return 0U; }
+
+  _strikes[_current] = 0U;
+  _errors = _rx_errors();
+  _since  = osKernelSysTick();
+  ++_stats.confirmed;
+  _stats.state = BAUD_STEADY;
+
+  return 1U;
+}
+
+/**
+  * @brief  Switch, time out trials and watch the error counters. Call from
+  *         ShellTask after each poll, at least every few tens of ms.
+  * @retval None
+  */
+void baud_poll(void)
+{
+  uint32_t now = osKernelSysTick();
+  uint32_t errors;
+
+  switch (_stats.state)
+  {
+    case BAUD_SWITCH:
+      if ((0U == uart_tx_idle()) && ((now - _since) < BAUD_DRAIN_MS))
+        { break; }
+      _previous = _current;
+      _apply(_next);
+      _errors = _rx_errors();
+      _since  = now;
+      ++_stats.switches;
+      _stats.state = BAUD_TRIAL;
+      break;
+
+    case BAUD_TRIAL:
+      // a host left at the old rate shows up as framing errors
+      if ((_rx_errors() != _errors) || ((now - _since) >= BAUD_CONFIRM_MS))
+        { _fail(_previous); }
+      break;
+
+    case BAUD_STEADY:
+    default:
+      if ((now - _since) < BAUD_WINDOW_MS)
+        { break; }
+      errors = _rx_errors();
+      if ((0U != _current) && ((errors - _errors) > BAUD_ERRORS_MAX))
+        { _fail(0U); }
+      _errors = errors;
+      _since  = now;
+      break;
+  }
+}
+
+/**
+  * @brief  Copy the negotiation state and counters.
+  * @param  stats: destination
+  * @retval None
+  */
+void baud_stats(baud_stats_t *stats)
+{
+  if (NULL == stats)
+    { return; }
+
+  taskENTER_CRITICAL();
+  *stats = _stats;
+  taskEXIT_CRITICAL();
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Oversampling that generates a rate within tolerance, preferring
+  *         16x for its better noise and clock tolerance.
+  * @retval 16, 8, or 0 if the rate cannot be generated
+  */
+static uint8_t _oversampling(uint32_t clock, uint32_t rate)
+{
+  for (uint8_t over = 16U; over >= 8U; over /= 2U)
+  {
+    // BRR = fck / rate at 16x, 2 * fck / rate at 8x, at least 16 either way
+    uint64_t scaled = (uint64_t)clock * (16U / over);
+    uint32_t div = (uint32_t)((scaled + rate / 2U) / rate);
+
+    if (div >= 16U)
+    {
+      uint32_t actual = (uint32_t)(scaled / div);
+      uint32_t error = (actual > rate) ? (actual - rate) : (rate - actual);
+
+      if ((uint64_t)error * 1000U <= (uint64_t)rate * BAUD_TOLERANCE_PERMILLE)
+        { return over; }
+    }
+  }
+
+  return 0U;
+}
+
+/**
+  * @brief  Reprogram the USART. Whatever is on the wire is cut; DMA in both
+  *         directions picks up again once the USART is enabled.
+  */
+static void _apply(uint8_t index)
+{
+  uint32_t clock = LL_RCC_GetUSARTClockFreq(LL_RCC_USART2_CLKSOURCE);
+  uint8_t over = _oversampling(clock, _rates[index]);
+  uint32_t mode = (8U == over) ? LL_USART_OVERSAMPLING_8 : LL_USART_OVERSAMPLING_16;
+
+  taskENTER_CRITICAL();
+  // OVER8 and BRR may only change while the USART is disabled
+  LL_USART_Disable(USART2);
+  LL_USART_SetOverSampling(USART2, mode);
+  LL_USART_SetBaudRate(USART2, clock, LL_USART_PRESCALER_DIV1, mode, _rates[index]);
+  LL_USART_Enable(USART2);
+  _current = index;
+  _stats.rate = _rates[index];
+  _stats.oversampling = over;
+  taskEXIT_CRITICAL();
+
+  while ((0U == LL_USART_IsActiveFlag_TEACK(USART2)) ||
+      (0U == LL_USART_IsActiveFlag_REACK(USART2)))
+    { }
+}
+
+/**
+  * @brief  Give up the current rate: strike it and go back.
+  */
+static void _fail(uint8_t fallback)
+{
+  if (_strikes[_current] < BAUD_STRIKES_MAX)
+    { ++_strikes[_current]; }
+
+  _apply(fallback);
+  _errors = _rx_errors();
+  _since  = osKernelSysTick();
+  ++_stats.fallbacks;
+  _stats.state = BAUD_STEADY;
+}
+
+static uint32_t _rx_errors(void)
+{
+  uart_rx_stats_t stats;
+
+  uart_rx_stats(&stats);
+  return uart_rx_errors(&stats);
+}
@@ -0,0 +1,376 @@
+/**
+  ******************************************************************************
+  * @file           : chart.c
+  * @brief          : Hardware-scrolled VBUS/IBUS strip chart.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "chart.h"
+#include "render.h"
+
+/* Private define ------------------------------------------------------------*/
+
+#if (TFT_HEIGHT > RENDER_STRIP_PIXELS)
+#error "a chart column does not fit in a render strip"
+#endif
+
+#define CHART_TOP             4U
+#define CHART_BOTTOM          (TFT_HEIGHT - 5U)
+
+#define CHART_BACKGROUND      TFT_RGB(0x00U, 0x00U, 0x00U)
+#define CHART_GRID            TFT_RGB(0x30U, 0x30U, 0x30U)
+#define CHART_VBUS            TFT_RGB(0xFFU, 0xD8U, 0x00U)
+#define CHART_IBUS            TFT_RGB(0x00U, 0xC0U, 0xFFU)
+
+/* Private typedef -----------------------------------------------------------*/
+
+typedef struct
+{
+  uint16_t mV;
+  uint16_t mA;
+}
+chart_sample_t;
+
+typedef struct
+{
+  uint16_t mV_min;
+  uint16_t mV_max;
+  uint16_t mA_min;
+  uint16_t mA_max;
+}
+chart_column_t;
+
+/* Private variables ---------------------------------------------------------*/
+
+static chart_listener_t _listener;
+
+static chart_sample_t _ring[CHART_RING_SIZE];
+static uint32_t _count;
+
+// column being accumulated by chart_push()
+static chart_column_t _acc;
+static uint16_t _acc_samples;
+
+// completed columns not drawn yet
+static chart_column_t _pending[CHART_PENDING_MAX];
+static uint8_t _pending_head;
+static uint8_t _pending_count;
+
+static uint16_t _timebase = CHART_TIMEBASE;
+static uint32_t _full_mV = CHART_FULL_MV;
+static uint32_t _full_mA = CHART_FULL_MA;
+static uint8_t _rebuild = 1U;
+
+// owned by the screen task
+static uint8_t _area;
+static uint16_t _oldest = CHART_X;
+
+static chart_stats_t _stats;
+
+/* Private function prototypes -----------------------------------------------*/
+
+static void _accumulate(chart_column_t *c, uint16_t n, const chart_sample_t *s);
+static uint8_t _span(uint32_t end, uint16_t timebase, uint16_t back, chart_column_t *c);
+static HAL_StatusTypeDef _draw(uint16_t x, const chart_column_t *c,
+    uint32_t full_mV, uint32_t full_mA);
+static uint16_t _y(uint32_t value, uint32_t full);
+static void _bar(tft_color_t *column, uint16_t v_min, uint16_t v_max,
+    uint32_t full, tft_color_t color);
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Set the function told about new columns and rebuild requests.
+  * @param  listener: called from the task pushing samples, may be NULL
+  * @retval None
+  */
+void chart_init(chart_listener_t listener)
+{
+  _listener = listener;
+}
+
+/**
+  * @brief  Append a sample. Call from a single task.
+  * @param  mV: VBUS voltage
+  * @param  mA: VBUS current, negative values plot as 0
+  * @retval None
+  */
+void chart_push(uint32_t mV, int32_t mA)
+{
+  chart_sample_t s =
+  {
+    .mV = (mV > UINT16_MAX) ? UINT16_MAX : (uint16_t)mV,
+    .mA = (mA < 0) ? 0U : ((mA > UINT16_MAX) ? UINT16_MAX : (uint16_t)mA),
+  };
+  uint8_t notify = 0U;
+
+  taskENTER_CRITICAL();
+
+  _ring[_count % CHART_RING_SIZE] = s;
+  ++_count;
+  ++_stats.samples;
+
+  _accumulate(&_acc, _acc_samples, &s);
+  if (++_acc_samples >= _timebase)
+  {
+    if (_pending_count < CHART_PENDING_MAX)
+    {
+      _pending[(_pending_head + _pending_count) % CHART_PENDING_MAX] = _acc;
+      ++_pending_count;
+    }
+    else
+    {
+      // the screen fell behind: redraw everything from the ring instead
+      ++_stats.overruns;
+      _rebuild = 1U;
+    }
+    _acc_samples = 0U;
+    notify = 1U;
+  }
+
+  taskEXIT_CRITICAL();
+
+  if ((0U != notify) && (NULL != _listener))
+    { _listener(); }
+}
+
+/**
+  * @brief  Change the number of samples per pixel column and rebuild.
+  * @param  samples: at least 1
+  * @retval None
+  */
+void chart_timebase(uint16_t samples)
+{
+  taskENTER_CRITICAL();
+  _timebase = (0U == samples) ? 1U : samples;
+  _acc_samples = 0U;
+  _rebuild = 1U;
+  taskEXIT_CRITICAL();
+
+  if (NULL != _listener)
+    { _listener(); }
+}
+
+/**
+  * @brief  Change the full-scale values and rebuild.
+  * @param  full_mV: voltage at the top of the plot
+  * @param  full_mA: current at the top of the plot
+  * @retval None
+  */
+void chart_zoom(uint32_t full_mV, uint32_t full_mA)
+{
+  taskENTER_CRITICAL();
+  _full_mV = (0U == full_mV) ? CHART_FULL_MV : full_mV;
+  _full_mA = (0U == full_mA) ? CHART_FULL_MA : full_mA;
+  _rebuild = 1U;
+  taskEXIT_CRITICAL();
+
+  if (NULL != _listener)
+    { _listener(); }
+}
+
+/**
+  * @brief  Bring the plot up to date: scroll in the pending columns, or
+  *         redraw every column from the ring after a zoom/timebase change.
+  *         Caller must own the display.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef chart_draw(void)
+{
+  HAL_StatusTypeDef status = HAL_OK;
+  uint8_t rebuild;
+  uint16_t timebase;
+  uint32_t full_mV;
+  uint32_t full_mA;
+  uint32_t end;
+
+  taskENTER_CRITICAL();
+  rebuild = _rebuild;
+  _rebuild = 0U;
+  if (0U != rebuild)
+    { _pending_count = 0U; }
+  timebase = _timebase;
+  full_mV = _full_mV;
+  full_mA = _full_mA;
+  // samples of the column still being accumulated are not plotted yet
+  end = _count - _acc_samples;
+  taskEXIT_CRITICAL();
+
+  tft_begin();
+
+  if (0U == _area)
+  {
+    status = tft_scroll_area(CHART_X, CHART_WIDTH);
+    _area = (HAL_OK == status);
+    rebuild = 1U;
+  }
+
+  if (0U != rebuild)
+  {
+    // oldest column on the left, unscrolled
+    for (uint16_t i = 0U; (i < CHART_WIDTH) && (HAL_OK == status); ++i)
+    {
+      chart_column_t c;
+      uint8_t valid = _span(end, timebase, CHART_WIDTH - 1U - i, &c);
+      status = _draw(CHART_X + i, valid ? &c : NULL, full_mV, full_mA);
+    }
+    _oldest = CHART_X;
+
+    taskENTER_CRITICAL();
+    ++_stats.rebuilds;
+    taskEXIT_CRITICAL();
+  }
+  else
+  {
+    uint32_t drawn = 0U;
+
+    for (;;)
+    {
+      chart_column_t c;
+
+      taskENTER_CRITICAL();
+      uint8_t any = (_pending_count > 0U);
+      if (any)
+      {
+        c = _pending[_pending_head];
+        _pending_head = (_pending_head + 1U) % CHART_PENDING_MAX;
+        --_pending_count;
+      }
+      taskEXIT_CRITICAL();
+
+      if (!any || (HAL_OK != status))
+        { break; }
+
+      // overwrite the column that just left the plot, it reappears on the right
+      status = _draw(_oldest, &c, full_mV, full_mA);
+      _oldest = CHART_X + ((_oldest - CHART_X + 1U) % CHART_WIDTH);
+      ++drawn;
+    }
+
+    taskENTER_CRITICAL();
+    _stats.columns += drawn;
+    taskEXIT_CRITICAL();
+
+    if (0U == drawn)
+    {
+      tft_end();
+      return status;
+    }
+  }
+
+  if (HAL_OK == status)
+    { status = tft_scroll(_oldest); }
+
+  tft_end();
+
+  return status;
+}
+
+/**
+  * @brief  Copy the chart counters.
+  * @param  stats: destination
+  * @retval None
+  */
+void chart_stats(chart_stats_t *stats)
+{
+  if (NULL == stats)
+    { return; }
+
+  taskENTER_CRITICAL();
+  *stats = _stats;
+  taskEXIT_CRITICAL();
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+static void _accumulate(chart_column_t *c, uint16_t n, const chart_sample_t *s)
+{
+  if ((0U == n) || (s->mV < c->mV_min))
+    { c->mV_min = s->mV; }
+  if ((0U == n) || (s->mV > c->mV_max))
+    { c->mV_max = s->mV; }
+  if ((0U == n) || (s->mA < c->mA_min))
+    { c->mA_min = s->mA; }
+  if ((0U == n) || (s->mA > c->mA_max))
+    { c->mA_max = s->mA; }
+}
+
+/**
+  * @brief  Min/max of the samples of a past column.
+  * @param  end: sample count at the end of the newest complete column
+  * @param  back: columns before the newest one
+  * @retval 0 if the samples are not (or no longer) in the ring
+  */
+static uint8_t _span(uint32_t end, uint16_t timebase, uint16_t back, chart_column_t *c)
+{
+  uint32_t offset = ((uint32_t)back + 1U) * timebase;
+  uint8_t valid;
+
+  if (offset > end)
+    { return 0U; }
+
+  uint32_t first = end - offset;
+
+  taskENTER_CRITICAL();
+  valid = ((_count - first) <= CHART_RING_SIZE);
+  for (uint16_t i = 0U; valid && (i < timebase); ++i)
+    { _accumulate(c, i, &_ring[(first + i) % CHART_RING_SIZE]); }
+  taskEXIT_CRITICAL();
+
+  return valid;
+}
+
+/**
+  * @brief  Rasterize one column and write it into GRAM column x.
+  * @param  c: min/max values, NULL for an empty column
+  */
+static HAL_StatusTypeDef _draw(uint16_t x, const chart_column_t *c,
+    uint32_t full_mV, uint32_t full_mA)
+{
+  // the column is staged in a renderer strip, free outside render_flush()
+  tft_color_t *column = render_scratch(0U);
+  HAL_StatusTypeDef status;
+
+  for (uint16_t y = 0U; y < TFT_HEIGHT; ++y)
+    { column[y] = CHART_BACKGROUND; }
+
+  column[CHART_TOP] = CHART_GRID;
+  column[(CHART_TOP + CHART_BOTTOM) / 2U] = CHART_GRID;
+  column[CHART_BOTTOM] = CHART_GRID;
+
+  if (NULL != c)
+  {
+    _bar(column, c->mA_min, c->mA_max, full_mA, CHART_IBUS);
+    _bar(column, c->mV_min, c->mV_max, full_mV, CHART_VBUS);
+  }
+
+  // every column is a window of its own, touch may take the bus in between
+  (void)tft_yield();
+
+  status = tft_window(x, 0U, x, TFT_HEIGHT - 1U);
+  if (HAL_OK == status)
+    { status = tft_write(column, TFT_HEIGHT); }
+
+  return status;
+}
+
+static uint16_t _y(uint32_t value, uint32_t full)
+{
+  if (value >= full)
+    { return CHART_TOP; }
+
+  return CHART_BOTTOM - (uint16_t)((value * (CHART_BOTTOM - CHART_TOP)) / full);
+}
+
+static void _bar(tft_color_t *column, uint16_t v_min, uint16_t v_max,
+    uint32_t full, tft_color_t color)
+{
+  for (uint16_t y = _y(v_max, full); y <= _y(v_min, full); ++y)
+    { column[y] = color; }
+}
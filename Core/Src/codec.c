@@ -0,0 +1,191 @@
+/**
+  ******************************************************************************
+  * @file           : codec.c
+  * @brief          : Streaming delta / adaptive Rice codec for measurements.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "codec.h"
+
+/* Private define ------------------------------------------------------------*/
+
+// initial statistics, k = 2 until the first values come in
+#define CODEC_SUM_INIT        4U
+
+/* Private function prototypes -----------------------------------------------*/
+
+static uint8_t _k(const codec_channel_t *channel);
+static void _value(codec_channel_t *channel, codec_bits_t *bits, uint16_t value);
+static void _put(codec_bits_t *bits, uint32_t value, uint8_t count);
+static size_t _room(const codec_bits_t *bits);
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Reset the statistics of all channels.
+  * @param  codec: state
+  * @retval None
+  */
+void codec_init(codec_t *codec)
+{
+  if (NULL == codec)
+    { return; }
+
+  for (uint32_t i = 0U; i < CODEC_CHANNELS; ++i)
+  {
+    codec->channel[i].prev  = 0U;
+    codec->channel[i].sum   = CODEC_SUM_INIT;
+    codec->channel[i].count = 1U;
+  }
+}
+
+/**
+  * @brief  Start writing into a buffer.
+  * @param  bits: writer
+  * @param  buf: destination
+  * @param  size: bytes available
+  * @retval None
+  */
+void codec_begin(codec_bits_t *bits, uint8_t *buf, size_t size)
+{
+  bits->buf     = buf;
+  bits->size    = size;
+  bits->len     = 0U;
+  bits->acc     = 0U;
+  bits->pending = 0U;
+}
+
+/**
+  * @brief  Write a keyframe: absolute values and the current k of each
+  *         channel, from which the statistics restart.
+  * @param  codec: state
+  * @param  bits: writer
+  * @param  value: one value per channel
+  * @retval 1 if written, 0 if it does not fit (nothing written)
+  */
+uint8_t codec_keyframe(codec_t *codec, codec_bits_t *bits, const uint16_t value[CODEC_CHANNELS])
+{
+  if (_room(bits) < CODEC_KEYFRAME_BITS)
+    { return 0U; }
+
+  for (uint32_t i = 0U; i < CODEC_CHANNELS; ++i)
+  {
+    codec_channel_t *channel = &codec->channel[i];
+    uint8_t k = _k(channel);
+
+    _put(bits, k, 4U);
+    _put(bits, value[i], 16U);
+
+    channel->prev  = value[i];
+    channel->sum   = 1UL << k;
+    channel->count = 1U;
+  }
+
+  return 1U;
+}
+
+/**
+  * @brief  Write one sample as differences to the previous one.
+  * @param  codec: state
+  * @param  bits: writer
+  * @param  value: one value per channel
+  * @retval 1 if written, 0 if the worst case does not fit (nothing written)
+  */
+uint8_t codec_encode(codec_t *codec, codec_bits_t *bits, const uint16_t value[CODEC_CHANNELS])
+{
+  if (_room(bits) < CODEC_SAMPLE_BITS_MAX)
+    { return 0U; }
+
+  for (uint32_t i = 0U; i < CODEC_CHANNELS; ++i)
+    { _value(&codec->channel[i], bits, value[i]); }
+
+  return 1U;
+}
+
+/**
+  * @brief  Pad and write the last partial byte.
+  * @param  bits: writer
+  * @retval Bytes written in total
+  */
+size_t codec_end(codec_bits_t *bits)
+{
+  if (0U != bits->pending)
+  {
+    bits->buf[bits->len++] = (uint8_t)(bits->acc << (8U - bits->pending));
+    bits->pending = 0U;
+  }
+
+  return bits->len;
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Rice parameter for the next value: the smallest k with
+  *         count * 2^k >= sum.
+  */
+static uint8_t _k(const codec_channel_t *channel)
+{
+  uint8_t k = 0U;
+
+  while ((k < CODEC_K_MAX) && ((channel->count << k) < channel->sum))
+    { ++k; }
+
+  return k;
+}
+
+/**
+  * @brief  Code one value and update the channel statistics.
+  */
+static void _value(codec_channel_t *channel, codec_bits_t *bits, uint16_t value)
+{
+  int16_t delta = (int16_t)(uint16_t)(value - channel->prev);
+  uint16_t zz = (uint16_t)(((uint16_t)delta << 1U) ^ (uint16_t)(delta >> 15));
+  uint8_t k = _k(channel);
+  uint32_t q = (uint32_t)zz >> k;
+
+  if (q < CODEC_ESCAPE)
+  {
+    _put(bits, ((1UL << q) - 1U) << 1U, (uint8_t)(q + 1U));
+    _put(bits, zz, k);
+  }
+  else
+  {
+    _put(bits, (1UL << CODEC_ESCAPE) - 1U, CODEC_ESCAPE);
+    _put(bits, zz, 16U);
+  }
+
+  channel->prev = value;
+  channel->sum += zz;
+  if (++channel->count >= CODEC_RESET)
+  {
+    channel->sum   >>= 1U;
+    channel->count >>= 1U;
+  }
+}
+
+/**
+  * @brief  Append the count low bits of value, MSB first. count <= 24.
+  */
+static void _put(codec_bits_t *bits, uint32_t value, uint8_t count)
+{
+  if (0U == count)
+    { return; }
+
+  bits->acc = (bits->acc << count) | (value & ((1UL << count) - 1U));
+  bits->pending += count;
+  while (bits->pending >= 8U)
+  {
+    bits->pending -= 8U;
+    bits->buf[bits->len++] = (uint8_t)(bits->acc >> bits->pending);
+  }
+}
+
+/**
+  * @brief  Bits left in the buffer.
+  */
+static size_t _room(const codec_bits_t *bits)
+{
+  return ((bits->size - bits->len) * 8U) - bits->pending;
+}
@@ -0,0 +1,233 @@
+/**
+  ******************************************************************************
+  * @file           : deadline.c
+  * @brief          : Lightweight deadline monitor for tasks and ISRs.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "cycles.h"
+#include "deadline.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+typedef struct
+{
+  deadline_stats_t stats;
+  uint32_t budget;        // cycles
+  uint32_t start;         // cycles, valid while pending
+  uint32_t worst;         // cycles
+  uint8_t  pending;
+}
+deadline_t;
+
+/* Private variables ---------------------------------------------------------*/
+
+static deadline_t _deadline[DEADLINE_MAX];
+static uint32_t _count;
+
+/* Private function prototypes -----------------------------------------------*/
+
+static void _record(deadline_t *dl, uint32_t elapsed);
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Register a named deadline. Registering the same name (pointer)
+  *         again returns the existing deadline.
+  * @param  name: static string identifying the deadline
+  * @param  budget_us: maximum allowed latency in microseconds
+  * @retval Deadline id, or DEADLINE_NONE if the table is full
+  */
+deadline_id_t deadline_register(const char *name, uint32_t budget_us)
+{
+  deadline_id_t id = DEADLINE_NONE;
+
+  cycles_init();
+
+  UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+  for (uint32_t i = 0U; i < _count; ++i)
+  {
+    if (name == _deadline[i].stats.name)
+    {
+      id = (deadline_id_t)i;
+      break;
+    }
+  }
+  if ((DEADLINE_NONE == id) && (_count < DEADLINE_MAX))
+  {
+    deadline_t *dl = &_deadline[_count];
+    memset(dl, 0, sizeof(*dl));
+    dl->stats.name      = name;
+    dl->stats.budget_us = budget_us;
+    dl->budget          = cycles_from_us(budget_us);
+    id = (deadline_id_t)_count++;
+  }
+  taskEXIT_CRITICAL_FROM_ISR(mask);
+
+  return id;
+}
+
+/**
+  * @brief  Begin an occurrence. If one is already pending its (earlier) start
+  *         time is kept, so several wake-ups before the consumer runs are
+  *         measured from the first one.
+  * @param  id: deadline id
+  * @retval None
+  */
+void deadline_start(deadline_id_t id)
+{
+  if (id >= _count)
+    { return; }
+
+  deadline_t *dl = &_deadline[id];
+  UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+  if (0U == dl->pending)
+  {
+    dl->start   = cycles_now();
+    dl->pending = 1U;
+  }
+  taskEXIT_CRITICAL_FROM_ISR(mask);
+}
+
+/**
+  * @brief  Complete the pending occurrence, if any.
+  * @param  id: deadline id
+  * @retval None
+  */
+void deadline_finish(deadline_id_t id)
+{
+  if (id >= _count)
+    { return; }
+
+  deadline_t *dl = &_deadline[id];
+  UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+  if (0U != dl->pending)
+  {
+    dl->pending = 0U;
+    _record(dl, cycles_since(dl->start));
+  }
+  taskEXIT_CRITICAL_FROM_ISR(mask);
+}
+
+/**
+  * @brief  Periodic activity: record the interval since the previous mark and
+  *         start the next one.
+  * @param  id: deadline id
+  * @retval None
+  */
+void deadline_mark(deadline_id_t id)
+{
+  if (id >= _count)
+    { return; }
+
+  deadline_t *dl = &_deadline[id];
+  uint32_t now = cycles_now();
+  UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+  if (0U != dl->pending)
+    { _record(dl, now - dl->start); }
+  dl->start   = now;
+  dl->pending = 1U;
+  taskEXIT_CRITICAL_FROM_ISR(mask);
+}
+
+/**
+  * @brief  Drop the pending occurrence without recording it (e.g. a periodic
+  *         activity that is being paused on purpose).
+  * @param  id: deadline id
+  * @retval None
+  */
+void deadline_cancel(deadline_id_t id)
+{
+  if (id < _count)
+    { _deadline[id].pending = 0U; }
+}
+
+/**
+  * @brief  Number of registered deadlines, ids are 0 .. count-1.
+  * @retval Deadline count
+  */
+uint32_t deadline_count(void)
+{
+  return _count;
+}
+
+/**
+  * @brief  Copy the statistics of a deadline.
+  * @param  id: deadline id
+  * @param  stats: destination
+  * @retval None
+  */
+void deadline_stats(deadline_id_t id, deadline_stats_t *stats)
+{
+  if ((id >= _count) || (NULL == stats))
+    { return; }
+
+  UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+  *stats = _deadline[id].stats;
+  taskEXIT_CRITICAL_FROM_ISR(mask);
+
+  stats->worst_us = cycles_to_us(_deadline[id].worst);
+}
+
+/**
+  * @brief  Clear the statistics of a deadline, keeping its registration.
+  * @param  id: deadline id
+  * @retval None
+  */
+void deadline_reset(deadline_id_t id)
+{
+  if (id >= _count)
+    { return; }
+
+  deadline_t *dl = &_deadline[id];
+  UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+  dl->stats.count       = 0U;
+  dl->stats.missed      = 0U;
+  dl->stats.lateness_us = 0U;
+  dl->worst             = 0U;
+  memset(dl->stats.histogram, 0, sizeof(dl->stats.histogram));
+  taskEXIT_CRITICAL_FROM_ISR(mask);
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Account one completed occurrence. Called with interrupts masked.
+  * @param  dl: deadline
+  * @param  elapsed: latency in cycles
+  * @retval None
+  */
+static void _record(deadline_t *dl, uint32_t elapsed)
+{
+  uint32_t budget = dl->budget;
+  uint32_t bin;
+
+  if      (elapsed <= (budget >> 3))            { bin = 0U; }
+  else if (elapsed <= (budget >> 2))            { bin = 1U; }
+  else if (elapsed <= (budget >> 1))            { bin = 2U; }
+  else if (elapsed <= (budget - (budget >> 2))) { bin = 3U; }
+  else if (elapsed <= budget)                   { bin = 4U; }
+  else if (elapsed <= (budget << 1))            { bin = 5U; }
+  else if (elapsed <= (budget << 2))            { bin = 6U; }
+  else                                          { bin = 7U; }
+
+  ++dl->stats.histogram[bin];
+  ++dl->stats.count;
+
+  if (elapsed > dl->worst)
+    { dl->worst = elapsed; }
+
+  if (elapsed > budget)
+  {
+    uint32_t late = cycles_to_us(elapsed - budget);
+    ++dl->stats.missed;
+    if (late > dl->stats.lateness_us)
+      { dl->stats.lateness_us = late; }
+  }
+}
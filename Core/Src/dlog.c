@@ -0,0 +1,290 @@
+/**
+  ******************************************************************************
+  * @file           : dlog.c
+  * @brief          : Deferred binary logging, formatted on the host.
+  ******************************************************************************
+  * @attention
+  *
+  * The ring is an array of fixed-size slots, each with a state word telling
+  * which pass over the ring it belongs to: LAP(pos) while free for position
+  * pos, LAP(pos) + 1 once the record at pos is complete. Writers claim a
+  * position with one compare-and-swap on _head and publish the slot with a
+  * release store; the single reader, dlog_flush(), frees it by moving it to
+  * the next pass. A zeroed ring is a valid empty ring, so DLOG() works
+  * before anything is initialised.
+  *
+  * A writer preempted between its claim and its publish only holds back
+  * the flush at its own slot, the others keep writing.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "cycles.h"
+#include "dlog.h"
+#include "link.h"
+
+/* Private define ------------------------------------------------------------*/
+
+#if (DLOG_RING_SIZE & (DLOG_RING_SIZE - 1U))
+#error "DLOG_RING_SIZE must be a power of two"
+#endif
+
+#define DLOG_MASK             (DLOG_RING_SIZE - 1U)
+
+// state of a free slot for a position; wraps along with the position
+#define LAP(pos)              (((pos) / DLOG_RING_SIZE) * 2U)
+
+// frame: tick u32, cycles u32, MHz u8, dropped u16
+#define DLOG_FRAME_HEADER     11U
+// record: format ID u16, port << 4 | count u8, cycles u32, count x u32
+#define DLOG_RECORD_HEADER    7U
+#define DLOG_RECORD_MAX       (DLOG_RECORD_HEADER + DLOG_ARGS_MAX * 4U)
+
+#if (DLOG_FRAME_HEADER + DLOG_RECORD_MAX) > LINK_BODY_MAX
+#error "a record does not fit in LINK_BODY_MAX"
+#endif
+
+/* Private typedef -----------------------------------------------------------*/
+
+typedef struct
+{
+  uint32_t state;         // LAP(pos) free, LAP(pos) + 1 complete
+  uint32_t cycles;
+  uint16_t id;
+  uint8_t port;
+  uint8_t count;
+  uint32_t args[DLOG_ARGS_MAX];
+}
+dlog_slot_t;
+
+/* Private variables ---------------------------------------------------------*/
+
+static dlog_slot_t _ring[DLOG_RING_SIZE];
+
+static uint32_t _head;           // next position to claim
+static uint32_t _tail;           // next position to flush
+static uint32_t _dropped;        // records that found the ring full
+static uint32_t _reported;       // of those, sent in a frame header
+static uint32_t _frames;
+
+/* Private function prototypes -----------------------------------------------*/
+
+static dlog_slot_t *_claim(uint32_t *pos);
+static void _publish(dlog_slot_t *slot, uint32_t pos, uint16_t id, uint8_t port, uint8_t count);
+static size_t _begin(uint8_t *body);
+static void _send(uint8_t *body, size_t len);
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Record entry points used by DLOG(), one per argument count.
+  *         Callable from any task or interrupt handler.
+  * @param  id: format ID, the address of the string in .dlog
+  * @param  port: USB-PD port, or 0
+  * @retval None
+  */
+void dlog_write0(uint16_t id, uint8_t port)
+{
+  uint32_t pos;
+  dlog_slot_t *slot = _claim(&pos);
+
+  if (NULL != slot)
+    { _publish(slot, pos, id, port, 0U); }
+}
+
+void dlog_write1(uint16_t id, uint8_t port, uint32_t a)
+{
+  uint32_t pos;
+  dlog_slot_t *slot = _claim(&pos);
+
+  if (NULL != slot)
+  {
+    slot->args[0] = a;
+    _publish(slot, pos, id, port, 1U);
+  }
+}
+
+void dlog_write2(uint16_t id, uint8_t port, uint32_t a, uint32_t b)
+{
+  uint32_t pos;
+  dlog_slot_t *slot = _claim(&pos);
+
+  if (NULL != slot)
+  {
+    slot->args[0] = a;
+    slot->args[1] = b;
+    _publish(slot, pos, id, port, 2U);
+  }
+}
+
+void dlog_write3(uint16_t id, uint8_t port, uint32_t a, uint32_t b, uint32_t c)
+{
+  uint32_t pos;
+  dlog_slot_t *slot = _claim(&pos);
+
+  if (NULL != slot)
+  {
+    slot->args[0] = a;
+    slot->args[1] = b;
+    slot->args[2] = c;
+    _publish(slot, pos, id, port, 3U);
+  }
+}
+
+void dlog_write4(uint16_t id, uint8_t port, uint32_t a, uint32_t b, uint32_t c, uint32_t d)
+{
+  uint32_t pos;
+  dlog_slot_t *slot = _claim(&pos);
+
+  if (NULL != slot)
+  {
+    slot->args[0] = a;
+    slot->args[1] = b;
+    slot->args[2] = c;
+    slot->args[3] = d;
+    _publish(slot, pos, id, port, 4U);
+  }
+}
+
+/**
+  * @brief  Send every complete record, packed into as few frames as they
+  *         fit in. Call periodically from one task only.
+  * @retval None
+  */
+void dlog_flush(void)
+{
+  uint8_t body[LINK_BODY_MAX];
+  size_t len = 0U;
+
+  for (;;)
+  {
+    dlog_slot_t *slot = &_ring[_tail & DLOG_MASK];
+    size_t size;
+
+    if ((LAP(_tail) + 1U) != __atomic_load_n(&slot->state, __ATOMIC_ACQUIRE))
+      { break; }
+
+    size = DLOG_RECORD_HEADER + slot->count * 4U;
+    if ((0U != len) && ((len + size) > sizeof(body)))
+    {
+      _send(body, len);
+      len = 0U;
+    }
+    if (0U == len)
+      { len = _begin(body); }
+
+    link_put16(&body[len], slot->id);
+    body[len + 2U] = (uint8_t)((slot->port << 4U) | slot->count);
+    link_put32(&body[len + 3U], slot->cycles);
+    for (uint8_t i = 0U; i < slot->count; ++i)
+      { link_put32(&body[len + DLOG_RECORD_HEADER + i * 4U], slot->args[i]); }
+    len += size;
+
+    __atomic_store_n(&slot->state, LAP(_tail + DLOG_RING_SIZE), __ATOMIC_RELEASE);
+    ++_tail;
+  }
+
+  // a frame with only the drop count if nothing else told the host
+  if ((0U == len) && (_reported != __atomic_load_n(&_dropped, __ATOMIC_RELAXED)))
+    { len = _begin(body); }
+
+  if (0U != len)
+    { _send(body, len); }
+}
+
+/**
+  * @brief  Copy the logging statistics.
+  * @param  stats: destination
+  * @retval None
+  */
+void dlog_stats(dlog_stats_t *stats)
+{
+  if (NULL == stats)
+    { return; }
+
+  stats->records = __atomic_load_n(&_head, __ATOMIC_RELAXED);
+  stats->dropped = __atomic_load_n(&_dropped, __ATOMIC_RELAXED);
+  stats->frames  = _frames;
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Claim the slot at the head, or count a drop if the reader has
+  *         not freed it yet.
+  */
+static dlog_slot_t *_claim(uint32_t *pos)
+{
+  uint32_t head = __atomic_load_n(&_head, __ATOMIC_RELAXED);
+
+  for (;;)
+  {
+    dlog_slot_t *slot = &_ring[head & DLOG_MASK];
+    uint32_t state = __atomic_load_n(&slot->state, __ATOMIC_ACQUIRE);
+
+    if (LAP(head) == state)
+    {
+      // on failure head is reloaded and the next slot looked at
+      if (__atomic_compare_exchange_n(&_head, &head, head + 1U, 1,
+          __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+      {
+        *pos = head;
+        return slot;
+      }
+    }
+    else
+    {
+      uint32_t now = __atomic_load_n(&_head, __ATOMIC_RELAXED);
+
+      // still the head: the slot holds a record from the previous pass
+      if (now == head)
+      {
+        __atomic_fetch_add(&_dropped, 1U, __ATOMIC_RELAXED);
+        return NULL;
+      }
+      head = now;
+    }
+  }
+}
+
+/**
+  * @brief  Fill in the record header and hand the slot to the reader.
+  */
+static void _publish(dlog_slot_t *slot, uint32_t pos, uint16_t id, uint8_t port, uint8_t count)
+{
+  slot->cycles = cycles_now();
+  slot->id     = id;
+  slot->port   = port;
+  slot->count  = count;
+
+  __atomic_store_n(&slot->state, LAP(pos) + 1U, __ATOMIC_RELEASE);
+}
+
+/**
+  * @brief  Write a frame header: the time base for the records' cycle
+  *         counts and the records dropped since the last frame.
+  */
+static size_t _begin(uint8_t *body)
+{
+  uint32_t dropped = __atomic_load_n(&_dropped, __ATOMIC_RELAXED);
+  uint32_t lost = dropped - _reported;
+
+  link_put32(&body[0], xTaskGetTickCount());
+  link_put32(&body[4], cycles_now());
+  body[8] = (uint8_t)(SystemCoreClock / 1000000U);
+  link_put16(&body[9], (uint16_t)((lost > 0xFFFFU) ? 0xFFFFU : lost));
+  _reported += (lost > 0xFFFFU) ? 0xFFFFU : lost;
+
+  return DLOG_FRAME_HEADER;
+}
+
+static void _send(uint8_t *body, size_t len)
+{
+  (void)link_send(LINK_CH_LOG, LINK_TYPE_DLOG, body, len);
+  ++_frames;
+}
@@ -0,0 +1,209 @@
+/**
+  ******************************************************************************
+  * @file           : isr_profile.c
+  * @brief          : Interrupt handler duration and rate profiler.
+  ******************************************************************************
+  * @attention
+  *
+  * Exclusive time is tracked with a single "child time" accumulator: entry
+  * saves and clears it, exit charges (total - child) to the handler and adds
+  * the handler's total to the saved value of the enclosing one.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+
+#include "cycles.h"
+#include "isr_profile.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+typedef struct
+{
+  uint32_t count;
+  uint32_t nested;
+  uint32_t min;
+  uint32_t max;
+  uint64_t total;
+}
+isr_profile_acc_t;
+
+/* Private variables ---------------------------------------------------------*/
+
+static const char * const _name[ISR_PROFILE_COUNT] =
+{
+  [ISR_PROFILE_DMA1_CH1]  = "DMA1_CH1",
+  [ISR_PROFILE_DMA1_CH2]  = "DMA1_CH2",
+  [ISR_PROFILE_DMA1_CH3]  = "DMA1_CH3",
+  [ISR_PROFILE_DMA1_CH4]  = "DMA1_CH4",
+  [ISR_PROFILE_DMA1_CH5]  = "DMA1_CH5",
+  [ISR_PROFILE_SPI1]      = "SPI1",
+  [ISR_PROFILE_USART2]    = "USART2",
+  [ISR_PROFILE_EXTI15_10] = "EXTI15_10",
+  [ISR_PROFILE_TIM6]      = "TIM6",
+  [ISR_PROFILE_TIM7]      = "TIM7",
+  [ISR_PROFILE_UCPD1]     = "UCPD1",
+  [ISR_PROFILE_I2C3_EV]   = "I2C3_EV",
+  [ISR_PROFILE_I2C3_ER]   = "I2C3_ER",
+};
+
+static isr_profile_acc_t _acc[ISR_PROFILE_COUNT];
+static uint32_t _child;
+static uint32_t _depth;
+static uint32_t _depth_max;
+
+// sampling state, owned by the task calling isr_profile_sample()
+static isr_profile_acc_t _prev[ISR_PROFILE_COUNT];
+static isr_profile_stats_t _stats[ISR_PROFILE_COUNT];
+static uint32_t _sample_cycles;
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Handler entry, use ISR_PROFILE_ENTER() instead.
+  * @param  id: handler
+  * @param  frame: per-invocation state on the handler's stack
+  * @retval None
+  */
+void isr_profile_enter(isr_profile_id_t id, isr_profile_frame_t *frame)
+{
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  frame->start = cycles_now();
+  frame->child = _child;
+  _child = 0U;
+
+  if (++_depth > 1U)
+    { ++_acc[id].nested; }
+  if (_depth > _depth_max)
+    { _depth_max = _depth; }
+
+  __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  Handler exit, use ISR_PROFILE_EXIT() instead.
+  * @param  id: handler
+  * @param  frame: state filled in by isr_profile_enter()
+  * @retval None
+  */
+void isr_profile_exit(isr_profile_id_t id, isr_profile_frame_t *frame)
+{
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  uint32_t total = cycles_since(frame->start);
+  uint32_t self = total - _child;
+  isr_profile_acc_t *acc = &_acc[id];
+
+  _child = frame->child + total;
+  --_depth;
+
+  if ((0U == acc->count) || (self < acc->min))
+    { acc->min = self; }
+  if (self > acc->max)
+    { acc->max = self; }
+  acc->total += self;
+  ++acc->count;
+
+  __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  Refresh the rate and load figures, covering the time since the
+  *         previous call. Must only be called from a single task.
+  * @retval None
+  */
+void isr_profile_sample(void)
+{
+  uint32_t now = cycles_now();
+  uint32_t window = now - _sample_cycles;
+  _sample_cycles = now;
+
+  for (uint32_t i = 0U; i < ISR_PROFILE_COUNT; ++i)
+  {
+    isr_profile_acc_t acc;
+    isr_profile_stats_t stats;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    acc = _acc[i];
+    __set_PRIMASK(primask);
+
+    // counters went backwards: reset in between, restart the window
+    if (acc.count < _prev[i].count)
+      { memset(&_prev[i], 0, sizeof(_prev[i])); }
+
+    uint32_t calls = acc.count - _prev[i].count;
+    uint64_t busy = acc.total - _prev[i].total;
+
+    stats.count  = acc.count;
+    stats.nested = acc.nested;
+    stats.min    = acc.min;
+    stats.max    = acc.max;
+    stats.avg    = (0U == acc.count) ? 0U : (uint32_t)(acc.total / acc.count);
+    stats.rate   = (0U == window) ? 0U :
+        (uint32_t)(((uint64_t)calls * SystemCoreClock) / window);
+    stats.load   = (0U == window) ? 0U :
+        (uint16_t)((busy * 1000U) / window);
+
+    _prev[i] = acc;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    _stats[i] = stats;
+    __set_PRIMASK(primask);
+  }
+}
+
+/**
+  * @brief  Copy the statistics published by the last isr_profile_sample().
+  * @param  id: handler
+  * @param  stats: destination
+  * @retval None
+  */
+void isr_profile_stats(isr_profile_id_t id, isr_profile_stats_t *stats)
+{
+  if ((id >= ISR_PROFILE_COUNT) || (NULL == stats))
+    { return; }
+
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  *stats = _stats[id];
+  __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  Deepest handler nesting observed since reset.
+  * @retval Nesting depth, 1 means no handler was ever preempted
+  */
+uint32_t isr_profile_depth_max(void)
+{
+  return _depth_max;
+}
+
+/**
+  * @brief  Printable name of a handler.
+  * @param  id: handler
+  * @retval Name, or "?" if out of range
+  */
+const char *isr_profile_name(isr_profile_id_t id)
+{
+  return (id < ISR_PROFILE_COUNT) ? _name[id] : "?";
+}
+
+/**
+  * @brief  Clear all accumulated counters.
+  * @retval None
+  */
+void isr_profile_reset(void)
+{
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  memset(_acc, 0, sizeof(_acc));
+  _depth_max = _depth;
+  __set_PRIMASK(primask);
+}
@@ -0,0 +1,342 @@
+/**
+  ******************************************************************************
+  * @file           : link.c
+  * @brief          : Framed binary telemetry link over USART2.
+  ******************************************************************************
+  * @attention
+  *
+  * A frame is encoded straight into its transmit buffer: the CRC unit is fed
+  * the header and body in place, then the COBS encoder walks header, body
+  * and CRC as one byte stream. The CRC unit is shared by every caller, so
+  * its use is kept in a short section with interrupts masked.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "main.h"
+#include "stm32g4xx_ll_bus.h"
+#include "stm32g4xx_ll_crc.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "codec.h"
+#include "link.h"
+
+/* Private define ------------------------------------------------------------*/
+
+#define LINK_SAMPLE_HEADER    7U   // tick, period, count
+#define LINK_SAMPLE_SIZE      4U   // mV, mA
+
+#if LINK_SAMPLE_CODEC
+#if (LINK_SAMPLE_HEADER * 8U + CODEC_KEYFRAME_BITS) > (LINK_BODY_MAX * 8U)
+#error "a keyframe does not fit in LINK_BODY_MAX"
+#endif
+#elif (LINK_SAMPLE_HEADER + LINK_SAMPLE_BATCH * LINK_SAMPLE_SIZE) > LINK_BODY_MAX
+#error "LINK_SAMPLE_BATCH samples do not fit in LINK_BODY_MAX"
+#endif
+
+#if (LINK_HEADER_SIZE + LINK_BODY_MAX + LINK_CRC_SIZE) > 254U
+#error "frames longer than one COBS block are not supported"
+#endif
+
+/* Private typedef -----------------------------------------------------------*/
+
+typedef struct
+{
+  uint8_t *out;
+  uint32_t code;          // index of the pending code byte
+  uint32_t pos;           // next free index
+}
+link_cobs_t;
+
+/* Private variables ---------------------------------------------------------*/
+
+static uint16_t _sequence[LINK_CH_COUNT];
+static link_stats_t _stats;
+
+static const uint32_t _limit[LINK_CH_COUNT] =
+{
+  [LINK_CH_RESPONSE] = LINK_LIMIT_RESPONSE,
+  [LINK_CH_EVENT]    = LINK_LIMIT_EVENT,
+  [LINK_CH_LOG]      = LINK_LIMIT_LOG,
+  [LINK_CH_SAMPLE]   = LINK_LIMIT_SAMPLE,
+};
+
+// batch being filled by link_sample()
+#if LINK_SAMPLE_CODEC
+static uint8_t _batch[LINK_BODY_MAX];
+static codec_t _codec;
+static codec_bits_t _bits;
+#else
+static uint8_t _batch[LINK_SAMPLE_HEADER + LINK_SAMPLE_BATCH * LINK_SAMPLE_SIZE];
+#endif
+static uint8_t _batched;
+
+/* Private function prototypes -----------------------------------------------*/
+
+static void _flush(void);
+static uint16_t _crc(const uint8_t *header, const uint8_t *body, size_t len);
+static void _cobs_put(link_cobs_t *cobs, const uint8_t *data, size_t len);
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Configure the CRC unit for CRC-16/CCITT-FALSE. Call before the
+  *         first frame is sent.
+  * @retval None
+  */
+void link_init(void)
+{
+  LL_AHB1_GRP1_EnableClock(LL_AHB1_GRP1_PERIPH_CRC);
+
+  LL_CRC_SetPolynomialSize(CRC, LL_CRC_POLYLENGTH_16B);
+  LL_CRC_SetPolynomialCoef(CRC, 0x1021U);
+  LL_CRC_SetInitialData(CRC, 0xFFFFU);
+  LL_CRC_SetInputDataReverseMode(CRC, LL_CRC_INDATA_REVERSE_NONE);
+  LL_CRC_SetOutputDataReverseMode(CRC, LL_CRC_OUTDATA_REVERSE_NONE);
+
+#if LINK_SAMPLE_CODEC
+  codec_init(&_codec);
+#endif
+}
+
+/**
+  * @brief  Frame a record and queue it, never blocks. Callable from any task
+  *         or interrupt handler.
+  * @param  channel: logical channel, sets the priority
+  * @param  type: record type, LINK_TYPE_*
+  * @param  body: record body, may be NULL if len is 0
+  * @param  len: body length, at most LINK_BODY_MAX
+  * @retval 1 if queued, 0 if dropped
+  */
+uint8_t link_send(link_channel_t channel, uint8_t type, const void *body, size_t len)
+{
+  uint8_t frame[LINK_FRAME_MAX];
+  uint8_t header[LINK_HEADER_SIZE];
+  uint8_t crc[LINK_CRC_SIZE];
+  link_cobs_t cobs = { .out = frame, .code = 0U, .pos = 1U };
+  uint16_t sequence;
+
+  if ((channel >= LINK_CH_COUNT) || (len > LINK_BODY_MAX) ||
+      ((NULL == body) && (0U != len)))
+    { return 0U; }
+
+  sequence = __atomic_fetch_add(&_sequence[channel], 1U, __ATOMIC_RELAXED);
+
+  header[0] = LINK_SCHEMA_VERSION;
+  header[1] = (uint8_t)channel;
+  header[2] = type;
+  link_put16(&header[3], sequence);
+  link_put16(crc, _crc(header, body, len));
+
+  _cobs_put(&cobs, header, LINK_HEADER_SIZE);
+  _cobs_put(&cobs, body, len);
+  _cobs_put(&cobs, crc, LINK_CRC_SIZE);
+  frame[cobs.code] = (uint8_t)(cobs.pos - cobs.code);
+  frame[cobs.pos++] = 0U;
+
+  if (cobs.pos != uart_tx_write_limit(frame, cobs.pos, _limit[channel]))
+  {
+    __atomic_fetch_add(&_stats.dropped[channel], 1U, __ATOMIC_RELAXED);
+    return 0U;
+  }
+
+  __atomic_fetch_add(&_stats.frames[channel], 1U, __ATOMIC_RELAXED);
+  __atomic_fetch_add(&_stats.bytes[channel], cobs.pos, __ATOMIC_RELAXED);
+  return 1U;
+}
+
+/**
+  * @brief  Add a measurement to the current batch, sent once it holds
+  *         LINK_SAMPLE_BATCH samples or, compressed, once the worst case of
+  *         the next sample would not fit. Each compressed frame starts with
+  *         a keyframe, so a lost frame only loses its own samples. Call from
+  *         the sampling task only.
+  * @param  sample: published measurement
+  * @retval None
+  */
+void link_sample(const measure_snapshot_t *sample)
+{
+  uint16_t value[2];
+
+  if (NULL == sample)
+    { return; }
+
+  value[0] = (uint16_t)((sample->voltage > 0xFFFFU) ? 0xFFFFU : sample->voltage);
+  value[1] = (uint16_t)(int16_t)((sample->current > INT16_MAX) ? INT16_MAX :
+      (sample->current < INT16_MIN) ? INT16_MIN : sample->current);
+
+#if LINK_SAMPLE_CODEC
+  if ((0U != _batched) && (0U == codec_encode(&_codec, &_bits, value)))
+    { _flush(); }
+#endif
+
+  if (0U == _batched)
+  {
+    link_put32(&_batch[0], sample->tick);
+    link_put16(&_batch[4], MEASURE_PERIOD_MS);
+#if LINK_SAMPLE_CODEC
+    codec_begin(&_bits, &_batch[LINK_SAMPLE_HEADER],
+        sizeof(_batch) - LINK_SAMPLE_HEADER);
+    (void)codec_keyframe(&_codec, &_bits, value);
+#endif
+  }
+
+#if !LINK_SAMPLE_CODEC
+  uint8_t *slot = &_batch[LINK_SAMPLE_HEADER + _batched * LINK_SAMPLE_SIZE];
+  link_put16(&slot[0], value[0]);
+  link_put16(&slot[2], value[1]);
+#endif
+
+  if (++_batched >= LINK_SAMPLE_BATCH)
+    { _flush(); }
+}
+
+/**
+  * @brief  Send a PD event.
+  * @param  type: LINK_TYPE_NOTIFY or LINK_TYPE_CABLE
+  * @param  port: USB-PD port
+  * @param  value: DPM notification or CAD event
+  * @retval None
+  */
+void link_event(uint8_t type, uint8_t port, uint8_t value)
+{
+  uint8_t body[6];
+
+  link_put32(&body[0], xTaskGetTickCount());
+  body[4] = port;
+  body[5] = value;
+
+  (void)link_send(LINK_CH_EVENT, type, body, sizeof(body));
+}
+
+/**
+  * @brief  Send a line of debug text, truncated to what fits in one frame.
+  * @param  port: USB-PD port the text is about
+  * @param  format: printf format
+  * @retval None
+  */
+void link_log(uint8_t port, const char *format, ...)
+{
+  uint8_t body[LINK_BODY_MAX];
+  va_list args;
+  int len;
+
+  link_put32(&body[0], xTaskGetTickCount());
+  body[4] = port;
+
+  va_start(args, format);
+  len = vsnprintf((char *)&body[5], sizeof(body) - 5U, format, args);
+  va_end(args);
+
+  if (len < 0)
+    { return; }
+  if ((size_t)len > sizeof(body) - 6U)
+    { len = (int)(sizeof(body) - 6U); }
+
+  (void)link_send(LINK_CH_LOG, LINK_TYPE_LOG, body, 5U + (size_t)len);
+}
+
+/**
+  * @brief  Copy the link statistics.
+  * @param  stats: destination
+  * @retval None
+  */
+void link_stats(link_stats_t *stats)
+{
+  if (NULL == stats)
+    { return; }
+
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  *stats = _stats;
+  __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  Store a 16-bit value little-endian, as every field of a body.
+  * @param  dst: destination, 2 bytes
+  * @param  value: value to store
+  * @retval None
+  */
+void link_put16(uint8_t *dst, uint16_t value)
+{
+  dst[0] = (uint8_t)value;
+  dst[1] = (uint8_t)(value >> 8U);
+}
+
+/**
+  * @brief  Store a 32-bit value little-endian, as every field of a body.
+  * @param  dst: destination, 4 bytes
+  * @param  value: value to store
+  * @retval None
+  */
+void link_put32(uint8_t *dst, uint32_t value)
+{
+  dst[0] = (uint8_t)value;
+  dst[1] = (uint8_t)(value >> 8U);
+  dst[2] = (uint8_t)(value >> 16U);
+  dst[3] = (uint8_t)(value >> 24U);
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Send the current batch of samples.
+  */
+static void _flush(void)
+{
+  _batch[6] = _batched;
+#if LINK_SAMPLE_CODEC
+  (void)link_send(LINK_CH_SAMPLE, LINK_TYPE_SAMPLES_RICE, _batch,
+      LINK_SAMPLE_HEADER + codec_end(&_bits));
+#else
+  (void)link_send(LINK_CH_SAMPLE, LINK_TYPE_SAMPLES, _batch,
+      LINK_SAMPLE_HEADER + _batched * LINK_SAMPLE_SIZE);
+#endif
+  _batched = 0U;
+}
+
+/**
+  * @brief  CRC of a header followed by a body.
+  */
+static uint16_t _crc(const uint8_t *header, const uint8_t *body, size_t len)
+{
+  uint32_t primask = __get_PRIMASK();
+  uint16_t crc;
+
+  __disable_irq();
+  LL_CRC_ResetCRCCalculationUnit(CRC);
+  for (size_t i = 0U; i < LINK_HEADER_SIZE; ++i)
+    { LL_CRC_FeedData8(CRC, header[i]); }
+  for (size_t i = 0U; i < len; ++i)
+    { LL_CRC_FeedData8(CRC, body[i]); }
+  crc = LL_CRC_ReadData16(CRC);
+  __set_PRIMASK(primask);
+
+  return crc;
+}
+
+/**
+  * @brief  COBS-encode bytes, continuing the current block. The caller
+  *         closes the last block.
+  */
+static void _cobs_put(link_cobs_t *cobs, const uint8_t *data, size_t len)
+{
+  for (size_t i = 0U; i < len; ++i)
+  {
+    if (0U == data[i])
+    {
+      cobs->out[cobs->code] = (uint8_t)(cobs->pos - cobs->code);
+      cobs->code = cobs->pos++;
+    }
+    else
+      { cobs->out[cobs->pos++] = data[i]; }
+  }
+}
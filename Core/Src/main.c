@@ -24,6 +24,7 @@
 #include "dma.h"
 #include "i2c.h"
 #include "spi.h"
+#include "tim.h"
 #include "ucpd.h"
 #include "usart.h"
 #include "usbpd.h"
@@ -31,7 +32,15 @@
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
-
+#include "cycles.h"
+#include "link.h"
+#include "pd_timer.h"
+#include "screen.h"
+#include "spi_bus.h"
+#include "tft.h"
+#include "touch.h"
+#include "uart_rx.h"
+#include "uart_tx.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -77,16 +86,6 @@ ina260_t *power(void)
   return _pow;
 }
 
-void screenTouchBegin(ili9341_t *dev, uint16_t x, uint16_t y)
-{
-  ;
-}
-
-void screenTouchEnd(ili9341_t *dev, uint16_t x, uint16_t y)
-{
-  ;
-}
-
 /* USER CODE END 0 */
 
 /**
@@ -96,7 +95,9 @@ void screenTouchEnd(ili9341_t *dev, uint16_t x, uint16_t y)
 int main(void)
 {
   /* USER CODE BEGIN 1 */
-
+  // cycle counter feeds the ISR profiler, start it before HAL_Init() enables
+  // the tick interrupt
+  cycles_init();
   /* USER CODE END 1 */
 
 
@@ -118,12 +119,13 @@ int main(void)
 
   /* Initialize all configured peripherals */
   MX_GPIO_Init();
-  MX_USART2_UART_Init();
   MX_DMA_Init();
+  MX_USART2_UART_Init();
   MX_UCPD1_Init();
   MX_USBPD_Init();
   MX_SPI1_Init();
   MX_I2C3_Init();
+  MX_TIM7_Init();
   /* USER CODE BEGIN 2 */
 
   _pow = ina260_new(
@@ -141,8 +143,15 @@ int main(void)
       itsSupported,
       itnNormalized);
 
-  ili9341_set_touch_pressed_begin(_lcd, screenTouchBegin);
-  ili9341_set_touch_pressed_end(_lcd, screenTouchEnd);
+  // PD stack timebase, independent of the HAL tick on TIM6
+  pd_timer_init();
+
+  // stdout and traces go out through the DMA ring from here on
+  uart_tx_init();
+  link_init();
+
+  // commands come in on the same port, see shell.h
+  uart_rx_init();
 
   /* USER CODE END 2 */
 
@@ -225,7 +234,8 @@ void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
   switch (GPIO_Pin)
   {
     case TOUCH_IRQ_Pin:
-      ili9341_touch_interrupt(_lcd);
+      // sampled by TouchTask over the shared bus
+      touch_irq();
       break;
 
     default:
@@ -234,6 +244,24 @@ void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
   }
 }
 
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+  if (hspi->Instance == SPI1)
+  {
+    tft_transfer_complete(HAL_OK);
+    spi_bus_transfer_complete(HAL_OK);
+  }
+}
+
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
+{
+  if (hspi->Instance == SPI1)
+  {
+    tft_transfer_complete(HAL_ERROR);
+    spi_bus_transfer_complete(HAL_ERROR);
+  }
+}
+
 /* USER CODE END 4 */
 
 /**
@@ -247,7 +275,6 @@ void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
 void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
 {
   /* USER CODE BEGIN Callback 0 */
-  USBPD_DPM_TimerCounter();
 
   /* USER CODE END Callback 0 */
   if (htim->Instance == TIM6) {
@@ -0,0 +1,161 @@
+/**
+  ******************************************************************************
+  * @file           : measure.c
+  * @brief          : VBUS measurement sampler (INA260) shared by the PD stack
+  *                   and the application.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdlib.h>
+
+#include "main.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "cmsis_os.h"
+
+#include "measure.h"
+
+/* Private variables ---------------------------------------------------------*/
+
+static osMutexId _lock;
+static measure_listener_t _listener;
+
+static measure_snapshot_t _snapshot;
+static uint32_t _notified_mV;
+static int32_t _notified_mA;
+
+/* Private function prototypes -----------------------------------------------*/
+
+static void _lock_bus(void);
+static void _unlock_bus(void);
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Create the bus lock. Call from MX_FREERTOS_Init(), reads made
+  *         before are not serialized (nothing else runs yet).
+  * @param  listener: called from the sampling task when a sample moved by
+  *         more than the deadband, may be NULL
+  * @retval None
+  */
+void measure_init(measure_listener_t listener)
+{
+  osMutexDef(measureLock);
+  _lock = osMutexCreate(osMutex(measureLock));
+  _listener = listener;
+}
+
+/**
+  * @brief  Read voltage and current, publish them as a new snapshot and
+  *         notify the listener if they changed. Call from a single task.
+  * @retval HAL status of the I2C transfers
+  */
+HAL_StatusTypeDef measure_sample(void)
+{
+  ina260_t *pow = power();
+  HAL_StatusTypeDef status;
+  float mV = 0.0F;
+  float mA = 0.0F;
+
+  _lock_bus();
+  status = ina260_get_voltage(pow, &mV);
+  if (HAL_OK == status)
+    { status = ina260_get_current(pow, &mA); }
+  _unlock_bus();
+
+  if (HAL_OK != status)
+  {
+    taskENTER_CRITICAL();
+    ++_snapshot.errors;
+    taskEXIT_CRITICAL();
+    return status;
+  }
+
+  uint32_t voltage = (uint32_t)mV;
+  int32_t current = (int32_t)mA;
+
+  taskENTER_CRITICAL();
+  ++_snapshot.sequence;
+  _snapshot.tick    = osKernelSysTick();
+  _snapshot.voltage = voltage;
+  _snapshot.current = current;
+  _snapshot.power   = (int32_t)(((int64_t)voltage * current) / 1000);
+  taskEXIT_CRITICAL();
+
+  if ((abs((int32_t)voltage - (int32_t)_notified_mV) >= MEASURE_DEADBAND_MV) ||
+      (abs(current - _notified_mA) >= MEASURE_DEADBAND_MA))
+  {
+    _notified_mV = voltage;
+    _notified_mA = current;
+    if (NULL != _listener)
+      { _listener(); }
+  }
+
+  return status;
+}
+
+/**
+  * @brief  Copy the most recent snapshot.
+  * @param  snapshot: destination
+  * @retval None
+  */
+void measure_snapshot(measure_snapshot_t *snapshot)
+{
+  if (NULL == snapshot)
+    { return; }
+
+  taskENTER_CRITICAL();
+  *snapshot = _snapshot;
+  taskEXIT_CRITICAL();
+}
+
+/**
+  * @brief  Fresh VBUS voltage reading for the PD stack.
+  * @param  mV: destination
+  * @retval HAL status of the I2C transfer
+  */
+HAL_StatusTypeDef measure_voltage(uint32_t *mV)
+{
+  HAL_StatusTypeDef status;
+  float value = 0.0F;
+
+  _lock_bus();
+  status = ina260_get_voltage(power(), &value);
+  _unlock_bus();
+
+  *mV = (HAL_OK == status) ? (uint32_t)value : 0U;
+  return status;
+}
+
+/**
+  * @brief  Fresh VBUS current reading for the PD stack.
+  * @param  mA: destination
+  * @retval HAL status of the I2C transfer
+  */
+HAL_StatusTypeDef measure_current(int32_t *mA)
+{
+  HAL_StatusTypeDef status;
+  float value = 0.0F;
+
+  _lock_bus();
+  status = ina260_get_current(power(), &value);
+  _unlock_bus();
+
+  *mA = (HAL_OK == status) ? (int32_t)value : 0;
+  return status;
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+static void _lock_bus(void)
+{
+  if ((NULL != _lock) && (taskSCHEDULER_RUNNING == xTaskGetSchedulerState()))
+    { (void)osMutexWait(_lock, osWaitForever); }
+}
+
+static void _unlock_bus(void)
+{
+  if ((NULL != _lock) && (taskSCHEDULER_RUNNING == xTaskGetSchedulerState()))
+    { (void)osMutexRelease(_lock); }
+}
@@ -0,0 +1,110 @@
+/**
+  ******************************************************************************
+  * @file           : pd_timer.c
+  * @brief          : Dedicated 1 ms timebase (TIM7) for the USB-PD stack.
+  ******************************************************************************
+  * @attention
+  *
+  * Lost update events are detected from the cycle counter: the time of the
+  * update event is recovered as (entry time - CNT), and the distance between
+  * two consecutive update events is rounded to whole periods.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "stm32g4xx_ll_tim.h"
+
+#include "usbpd.h"
+
+#include "cycles.h"
+#include "pd_timer.h"
+
+/* Private variables ---------------------------------------------------------*/
+
+static pd_timer_stats_t _stats;
+static uint32_t _event;          // cycle count of the last update event
+static uint32_t _period;         // cycles per period
+static uint32_t _tick0;          // HAL tick when the timer was started
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Start TIM7. Call after MX_TIM7_Init() and before the scheduler
+  *         starts.
+  * @retval None
+  */
+void pd_timer_init(void)
+{
+  cycles_init();
+
+  _period = cycles_from_us(PD_TIMER_PERIOD_US);
+
+  // LL_TIM_Init() loaded the prescaler with an update event; only counter
+  // overflows interrupt from here on
+  LL_TIM_SetUpdateSource(TIM7, LL_TIM_UPDATESOURCE_COUNTER);
+  LL_TIM_ClearFlag_UPDATE(TIM7);
+  LL_TIM_EnableIT_UPDATE(TIM7);
+
+  _tick0 = HAL_GetTick();
+  _event = cycles_now();
+  LL_TIM_EnableCounter(TIM7);
+}
+
+/**
+  * @brief  TIM7 update interrupt, called from TIM7_DAC_IRQHandler().
+  * @retval None
+  */
+void pd_timer_isr(void)
+{
+  if (0U == LL_TIM_IsActiveFlag_UPDATE(TIM7))
+    { return; }
+  LL_TIM_ClearFlag_UPDATE(TIM7);
+
+  uint32_t latency = LL_TIM_GetCounter(TIM7);
+  uint32_t event = cycles_now() - cycles_from_us(latency);
+  uint32_t periods = ((event - _event) + (_period >> 1U)) / _period;
+  _event = event;
+
+  if (latency > _stats.latency_max)
+    { _stats.latency_max = latency; }
+
+  if (0U == periods)
+    { periods = 1U; }
+  if (periods > 1U)
+    { _stats.missed += periods - 1U; }
+  if (periods > PD_TIMER_CATCHUP_MAX)
+  {
+    _stats.dropped += periods - PD_TIMER_CATCHUP_MAX;
+    periods = PD_TIMER_CATCHUP_MAX;
+  }
+
+  while (periods-- > 0U)
+  {
+    USBPD_DPM_TimerCounter();
+    ++_stats.ticks;
+  }
+
+  // next update already happened while we were busy
+  if (0U != LL_TIM_IsActiveFlag_UPDATE(TIM7))
+    { ++_stats.overruns; }
+}
+
+/**
+  * @brief  Copy the timer statistics.
+  * @param  stats: destination
+  * @retval None
+  */
+void pd_timer_stats(pd_timer_stats_t *stats)
+{
+  if (NULL == stats)
+    { return; }
+
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  *stats = _stats;
+  __set_PRIMASK(primask);
+
+  stats->drift = (int32_t)(stats->ticks - (HAL_GetTick() - _tick0));
+}
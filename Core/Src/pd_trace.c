@@ -0,0 +1,289 @@
+/**
+  ******************************************************************************
+  * @file           : pd_trace.c
+  * @brief          : Lossy, non-blocking back end for the USB-PD stack tracer.
+  ******************************************************************************
+  * @attention
+  *
+  * The ring works as the one of dlog.c: fixed-size slots whose state word
+  * tells the pass over the ring they belong to, claimed with one
+  * compare-and-swap on _head, published with a release store and freed by
+  * the single reader, pd_trace_flush().
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+
+#include "main.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "cycles.h"
+#include "link.h"
+#include "pd_trace.h"
+
+#if defined(_TRACE)
+#include "usbpd_core.h"
+#include "usbpd_trace.h"
+#endif /* _TRACE */
+
+/* Private define ------------------------------------------------------------*/
+
+#if (PD_TRACE_RING_SIZE & (PD_TRACE_RING_SIZE - 1U))
+#error "PD_TRACE_RING_SIZE must be a power of two"
+#endif
+
+#define PD_TRACE_MASK         (PD_TRACE_RING_SIZE - 1U)
+
+// state of a free slot for a position; wraps along with the position
+#define LAP(pos)              (((pos) / PD_TRACE_RING_SIZE) * 2U)
+
+// frame: tick u32, cycles u32, MHz u8
+#define PD_TRACE_FRAME_HEADER 9U
+// record: type u8, port << 4 | SOP u8, size u8, cycles u32, data
+// marker: PD_TRACE_DROPPED u8, source u8, 4 u8, cycles u32, dropped u32
+#define PD_TRACE_RECORD_HEADER 7U
+#define PD_TRACE_RECORD_MAX   (PD_TRACE_RECORD_HEADER + PD_TRACE_DATA_MAX)
+
+#if (PD_TRACE_FRAME_HEADER + PD_TRACE_RECORD_MAX) > LINK_BODY_MAX
+#error "a record does not fit in LINK_BODY_MAX"
+#endif
+
+/* Private typedef -----------------------------------------------------------*/
+
+typedef struct
+{
+  uint32_t state;         // LAP(pos) free, LAP(pos) + 1 complete
+  uint32_t cycles;
+  uint8_t type;
+  uint8_t port;
+  uint8_t sop;
+  uint8_t size;           // payload size traced, up to 255
+  uint8_t data[PD_TRACE_DATA_MAX];
+}
+pd_trace_slot_t;
+
+/* Private variables ---------------------------------------------------------*/
+
+static pd_trace_slot_t _ring[PD_TRACE_RING_SIZE];
+
+static uint32_t _head;           // next position to claim
+static uint32_t _tail;           // next position to flush
+static uint32_t _frames;
+
+static uint32_t _seen[PD_TRACE_SOURCES];
+static uint32_t _dropped[PD_TRACE_SOURCES];
+static uint32_t _reported[PD_TRACE_SOURCES];  // of the drops, marked
+static uint16_t _every[PD_TRACE_SOURCES];     // 0 and 1 keep every event
+
+/* Private function prototypes -----------------------------------------------*/
+
+static size_t _begin(uint8_t *body);
+static size_t _room(uint8_t *body, size_t len, size_t size);
+static void _send(uint8_t *body, size_t len);
+
+/* Exported functions --------------------------------------------------------*/
+
+#if defined(_TRACE)
+
+/**
+  * @brief  Hand the stack's own events (messages, PE states) to
+  *         USBPD_TRACE_Add() as well. Called from USBPD_DPM_UserInit(),
+  *         before the stack's tasks are created.
+  * @retval None
+  */
+void USBPD_TRACE_Init(void)
+{
+  USBPD_PE_SetTrace(USBPD_TRACE_Add, 3U);
+}
+
+void USBPD_TRACE_DeInit(void)
+{
+  USBPD_PE_SetTrace(NULL, 0U);
+}
+
+/**
+  * @brief  Store a trace event, or count it as dropped. Callable from any
+  *         task or interrupt handler; never blocks.
+  * @param  Type: event type, its source
+  * @param  PortNum: USB-PD port
+  * @param  Sop: SOP type of a message
+  * @param  Ptr: payload
+  * @param  Size: payload size
+  * @retval None
+  */
+void USBPD_TRACE_Add(TRACE_EVENT Type, uint8_t PortNum, uint8_t Sop, uint8_t *Ptr, uint32_t Size)
+{
+  uint8_t source = ((uint32_t)Type < PD_TRACE_SOURCES) ? (uint8_t)Type : (PD_TRACE_SOURCES - 1U);
+  uint32_t seen = __atomic_fetch_add(&_seen[source], 1U, __ATOMIC_RELAXED);
+  uint16_t every = __atomic_load_n(&_every[source], __ATOMIC_RELAXED);
+  uint32_t head;
+
+  if ((every > 1U) && (0U != (seen % every)))
+    { return; }
+
+  head = __atomic_load_n(&_head, __ATOMIC_RELAXED);
+
+  for (;;)
+  {
+    pd_trace_slot_t *slot = &_ring[head & PD_TRACE_MASK];
+
+    if (LAP(head) == __atomic_load_n(&slot->state, __ATOMIC_ACQUIRE))
+    {
+      // on failure head is reloaded and the next slot looked at
+      if (__atomic_compare_exchange_n(&_head, &head, head + 1U, 1,
+          __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+      {
+        slot->cycles = cycles_now();
+        slot->type   = (uint8_t)Type;
+        slot->port   = PortNum;
+        slot->sop    = Sop;
+        slot->size   = (Size > UINT8_MAX) ? UINT8_MAX : (uint8_t)Size;
+        if (NULL != Ptr)
+          { memcpy(slot->data, Ptr, (Size > PD_TRACE_DATA_MAX) ? PD_TRACE_DATA_MAX : Size); }
+
+        __atomic_store_n(&slot->state, LAP(head) + 1U, __ATOMIC_RELEASE);
+        return;
+      }
+    }
+    else
+    {
+      uint32_t now = __atomic_load_n(&_head, __ATOMIC_RELAXED);
+
+      // still the head: the slot holds an event from the previous pass
+      if (now == head)
+      {
+        __atomic_fetch_add(&_dropped[source], 1U, __ATOMIC_RELAXED);
+        return;
+      }
+      head = now;
+    }
+  }
+}
+
+#endif /* _TRACE */
+
+/**
+  * @brief  Keep one event in every few of a source.
+  * @param  source: TRACE_EVENT type
+  * @param  every: 1 to keep all events
+  * @retval None
+  */
+void pd_trace_sample(uint8_t source, uint16_t every)
+{
+  if (source < PD_TRACE_SOURCES)
+    { __atomic_store_n(&_every[source], every, __ATOMIC_RELAXED); }
+}
+
+/**
+  * @brief  Send every complete record, and a marker for each source that
+  *         dropped events since the last flush. Call periodically from one
+  *         task only.
+  * @retval None
+  */
+void pd_trace_flush(void)
+{
+  uint8_t body[LINK_BODY_MAX];
+  size_t len = 0U;
+
+  for (uint8_t i = 0U; i < PD_TRACE_SOURCES; ++i)
+  {
+    uint32_t lost = __atomic_load_n(&_dropped[i], __ATOMIC_RELAXED) - _reported[i];
+
+    if (0U == lost)
+      { continue; }
+
+    len = _room(body, len, PD_TRACE_RECORD_HEADER + 4U);
+    body[len]      = PD_TRACE_DROPPED;
+    body[len + 1U] = i;
+    body[len + 2U] = 4U;
+    link_put32(&body[len + 3U], cycles_now());
+    link_put32(&body[len + PD_TRACE_RECORD_HEADER], lost);
+    len += PD_TRACE_RECORD_HEADER + 4U;
+    _reported[i] += lost;
+  }
+
+  for (;;)
+  {
+    pd_trace_slot_t *slot = &_ring[_tail & PD_TRACE_MASK];
+    size_t kept;
+
+    if ((LAP(_tail) + 1U) != __atomic_load_n(&slot->state, __ATOMIC_ACQUIRE))
+      { break; }
+
+    kept = (slot->size > PD_TRACE_DATA_MAX) ? PD_TRACE_DATA_MAX : slot->size;
+    len = _room(body, len, PD_TRACE_RECORD_HEADER + kept);
+    body[len]      = slot->type;
+    body[len + 1U] = (uint8_t)((slot->port << 4U) | (slot->sop & 0x0FU));
+    body[len + 2U] = slot->size;
+    link_put32(&body[len + 3U], slot->cycles);
+    memcpy(&body[len + PD_TRACE_RECORD_HEADER], slot->data, kept);
+    len += PD_TRACE_RECORD_HEADER + kept;
+
+    __atomic_store_n(&slot->state, LAP(_tail + PD_TRACE_RING_SIZE), __ATOMIC_RELEASE);
+    ++_tail;
+  }
+
+  if (0U != len)
+    { _send(body, len); }
+}
+
+/**
+  * @brief  Copy the trace statistics.
+  * @param  stats: destination
+  * @retval None
+  */
+void pd_trace_stats(pd_trace_stats_t *stats)
+{
+  if (NULL == stats)
+    { return; }
+
+  for (uint8_t i = 0U; i < PD_TRACE_SOURCES; ++i)
+  {
+    stats->seen[i]    = __atomic_load_n(&_seen[i], __ATOMIC_RELAXED);
+    stats->dropped[i] = __atomic_load_n(&_dropped[i], __ATOMIC_RELAXED);
+  }
+  stats->records = __atomic_load_n(&_head, __ATOMIC_RELAXED);
+  stats->frames  = _frames;
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Write a frame header: the time base for the records' cycle
+  *         counts.
+  */
+static size_t _begin(uint8_t *body)
+{
+  link_put32(&body[0], xTaskGetTickCount());
+  link_put32(&body[4], cycles_now());
+  body[8] = (uint8_t)(SystemCoreClock / 1000000U);
+
+  return PD_TRACE_FRAME_HEADER;
+}
+
+/**
+  * @brief  Make room for a record: send the frame if it is full, start one
+  *         if there is none.
+  * @retval Length of the frame so far
+  */
+static size_t _room(uint8_t *body, size_t len, size_t size)
+{
+  if ((0U != len) && ((len + size) > LINK_BODY_MAX))
+  {
+    _send(body, len);
+    len = 0U;
+  }
+  if (0U == len)
+    { len = _begin(body); }
+
+  return len;
+}
+
+static void _send(uint8_t *body, size_t len)
+{
+  (void)link_send(LINK_CH_LOG, LINK_TYPE_TRACE, body, len);
+  ++_frames;
+}
@@ -0,0 +1,310 @@
+/**
+  ******************************************************************************
+  * @file           : pdo.c
+  * @brief          : Source PDO decoding and on-demand renegotiation.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "usbpd.h"
+
+#include "cycles.h"
+#include "pdo.h"
+
+/* Private define ------------------------------------------------------------*/
+
+// PD 3.0, 6.4.1: object type in bits 31..30, APDO kind in bits 29..28
+#define PDO_TYPE(raw)         (((raw) >> 30U) & 0x3U)
+#define PDO_APDO_TYPE(raw)    (((raw) >> 28U) & 0x3U)
+#define PDO_FIELD(raw, lsb, bits)  (((raw) >> (lsb)) & ((1UL << (bits)) - 1U))
+
+/* Private typedef -----------------------------------------------------------*/
+
+// DPM fields rewritten by a request, restored if it does not complete
+typedef struct
+{
+  uint32_t position;
+  uint32_t message;
+  uint32_t voltage;
+  uint32_t current;
+}
+pdo_saved_t;
+
+/* Private variables ---------------------------------------------------------*/
+
+static uint8_t _port;
+static uint32_t _edge;
+static pdo_saved_t _saved;
+
+static pdo_stats_t _stats;
+
+/* Private function prototypes -----------------------------------------------*/
+
+static void _restore(uint8_t port);
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Decode a source Power Data Object.
+  * @param  raw: object as received
+  * @param  info: destination
+  * @retval None
+  */
+void pdo_decode(uint32_t raw, pdo_info_t *info)
+{
+  if (NULL == info)
+    { return; }
+
+  switch (PDO_TYPE(raw))
+  {
+    case 0U:
+      info->type   = PDO_FIXED;
+      info->mv_min = PDO_FIELD(raw, 10U, 10U) * 50U;
+      info->mv_max = info->mv_min;
+      info->ma     = PDO_FIELD(raw, 0U, 10U) * 10U;
+      info->mw     = (info->mv_max * info->ma) / 1000U;
+      break;
+
+    case 1U:
+      info->type   = PDO_BATTERY;
+      info->mv_max = PDO_FIELD(raw, 20U, 10U) * 50U;
+      info->mv_min = PDO_FIELD(raw, 10U, 10U) * 50U;
+      info->ma     = 0U;
+      info->mw     = PDO_FIELD(raw, 0U, 10U) * 250U;
+      break;
+
+    case 2U:
+      info->type   = PDO_VARIABLE;
+      info->mv_max = PDO_FIELD(raw, 20U, 10U) * 50U;
+      info->mv_min = PDO_FIELD(raw, 10U, 10U) * 50U;
+      info->ma     = PDO_FIELD(raw, 0U, 10U) * 10U;
+      info->mw     = (info->mv_max * info->ma) / 1000U;
+      break;
+
+    default:
+      if (0U == PDO_APDO_TYPE(raw))
+      {
+        info->type   = PDO_PPS;
+        info->mv_max = PDO_FIELD(raw, 17U, 8U) * 100U;
+        info->mv_min = PDO_FIELD(raw, 8U, 8U) * 100U;
+        info->ma     = PDO_FIELD(raw, 0U, 7U) * 50U;
+        info->mw     = (info->mv_max * info->ma) / 1000U;
+      }
+      else
+      {
+        info->type   = PDO_UNKNOWN;
+        info->mv_min = 0U;
+        info->mv_max = 0U;
+        info->ma     = 0U;
+        info->mw     = 0U;
+      }
+      break;
+  }
+}
+
+/**
+  * @brief  Format a decoded object in at most 13 characters, e.g.
+  *         " 9V 3.0A  27W", "3.3-21V 3.0A" or " 5-20V  60W".
+  * @param  info: decoded object
+  * @param  buf: destination
+  * @param  len: size of buf
+  * @retval None
+  */
+void pdo_format(const pdo_info_t *info, char *buf, size_t len)
+{
+  if ((NULL == info) || (NULL == buf) || (0U == len))
+    { return; }
+
+  // voltages to the nearest volt, currents truncated to 0.1 A
+  uint32_t v_min = (info->mv_min + 500U) / 1000U;
+  uint32_t v_max = (info->mv_max + 500U) / 1000U;
+  uint32_t a = info->ma / 1000U;
+  uint32_t da = (info->ma % 1000U) / 100U;
+
+  switch (info->type)
+  {
+    case PDO_FIXED:
+      snprintf(buf, len, "%2luV %lu.%luA%4luW", v_max, a, da, info->mw / 1000U);
+      break;
+    case PDO_BATTERY:
+      snprintf(buf, len, "%2lu-%luV%4luW", v_min, v_max, info->mw / 1000U);
+      break;
+    case PDO_VARIABLE:
+      snprintf(buf, len, "%2lu-%luV %lu.%luA", v_min, v_max, a, da);
+      break;
+    case PDO_PPS:
+      snprintf(buf, len, "%lu.%lu-%luV %lu.%luA", info->mv_min / 1000U,
+          (info->mv_min % 1000U) / 100U, v_max, a, da);
+      break;
+    default:
+      snprintf(buf, len, "?");
+      break;
+  }
+}
+
+/**
+  * @brief  Whether the DPM can build a request for an object.
+  * @param  info: decoded object
+  * @retval 1 for fixed and battery supplies
+  */
+uint8_t pdo_requestable(const pdo_info_t *info)
+{
+  return (NULL != info) &&
+      ((PDO_FIXED == info->type) || (PDO_BATTERY == info->type));
+}
+
+/**
+  * @brief  Ask the source for another object of its capabilities. Call from
+  *         a task.
+  * @param  port: USB-PD port
+  * @param  position: object position in DPM_ListOfRcvSRCPDO, from 1
+  * @param  edge: cycle counter at the touch that asked for it
+  * @retval Status of USBPD_DPM_RequestMessageRequest(), USBPD_ERROR if the
+  *         object cannot be requested
+  */
+USBPD_StatusTypeDef pdo_request(uint8_t port, uint8_t position, uint32_t edge)
+{
+  USBPD_HandleTypeDef *h;
+  USBPD_StatusTypeDef status = USBPD_ERROR;
+  uint8_t attempted = 0U;
+  pdo_info_t info;
+
+  if (port >= USBPD_PORT_COUNT)
+    { return USBPD_ERROR; }
+
+  h = &DPM_Ports[port];
+
+  if ((0U != h->DPM_IsConnected) && (position >= 1U) &&
+      (position <= h->DPM_NumberOfRcvSRCPDO))
+  {
+    pdo_decode(h->DPM_ListOfRcvSRCPDO[position - 1U], &info);
+    if (0U != pdo_requestable(&info))
+    {
+      taskENTER_CRITICAL();
+      _port = port;
+      _edge = edge;
+      _saved.position = h->DPM_RDOPosition;
+      _saved.message  = h->DPM_RequestDOMsg;
+      _saved.voltage  = h->DPM_RequestedVoltage;
+      _saved.current  = h->DPM_RequestedCurrent;
+      _stats.state    = PDO_REQUEST_PENDING;
+      _stats.position = position;
+      taskEXIT_CRITICAL();
+
+      attempted = 1U;
+      status = USBPD_DPM_RequestMessageRequest(port, position,
+          (uint16_t)info.mv_min);
+    }
+  }
+
+  taskENTER_CRITICAL();
+  if (USBPD_OK == status)
+    { ++_stats.requests; }
+  else
+  {
+    // the DPM may have rewritten the request fields before giving up
+    if (0U != attempted)
+      { _restore(port); }
+    _stats.state = PDO_REQUEST_FAILED;
+    _stats.position = position;
+    ++_stats.failed;
+  }
+  taskEXIT_CRITICAL();
+
+  return status;
+}
+
+/**
+  * @brief  Follow the outcome of a request. Call from
+  *         USBPD_DPM_Notification().
+  * @param  port: USB-PD port
+  * @param  event: DPM notification
+  * @retval None
+  */
+void pdo_notify(uint8_t port, USBPD_NotifyEventValue_TypeDef event)
+{
+  if (port != _port)
+    { return; }
+
+  taskENTER_CRITICAL();
+  switch (event)
+  {
+    case USBPD_NOTIFY_POWER_EXPLICIT_CONTRACT:
+      if (PDO_REQUEST_PENDING == _stats.state)
+      {
+        uint32_t us = cycles_to_us(cycles_since(_edge));
+        _stats.state = PDO_REQUEST_READY;
+        _stats.latency_last = us;
+        if (us > _stats.latency_max)
+          { _stats.latency_max = us; }
+        ++_stats.contracts;
+      }
+      break;
+
+    case USBPD_NOTIFY_REQUEST_REJECTED:
+    case USBPD_NOTIFY_REQUEST_WAIT:
+      if (PDO_REQUEST_PENDING == _stats.state)
+      {
+        _restore(port);
+        _stats.state = PDO_REQUEST_REJECTED;
+        ++_stats.rejected;
+      }
+      break;
+
+    default:
+      break;
+  }
+  taskEXIT_CRITICAL();
+}
+
+/**
+  * @brief  Forget the last request, the capabilities it referred to are
+  *         gone. Call from the cable detection on detach.
+  * @param  port: USB-PD port
+  * @retval None
+  */
+void pdo_reset(uint8_t port)
+{
+  if (port != _port)
+    { return; }
+
+  taskENTER_CRITICAL();
+  _stats.state = PDO_REQUEST_IDLE;
+  _stats.position = 0U;
+  taskEXIT_CRITICAL();
+}
+
+/**
+  * @brief  Copy the request statistics.
+  * @param  stats: destination
+  * @retval None
+  */
+void pdo_stats(pdo_stats_t *stats)
+{
+  if (NULL == stats)
+    { return; }
+
+  taskENTER_CRITICAL();
+  *stats = _stats;
+  taskEXIT_CRITICAL();
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Put back the request fields of the contract still in place.
+  *         Called in a critical section.
+  */
+static void _restore(uint8_t port)
+{
+  USBPD_HandleTypeDef *h = &DPM_Ports[port];
+
+  h->DPM_RDOPosition      = _saved.position;
+  h->DPM_RequestDOMsg     = _saved.message;
+  h->DPM_RequestedVoltage = _saved.voltage;
+  h->DPM_RequestedCurrent = _saved.current;
+}
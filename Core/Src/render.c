@@ -0,0 +1,590 @@
+/**
+  ******************************************************************************
+  * @file           : render.c
+  * @brief          : Retained-mode dirty-rectangle renderer for the TFT.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "cycles.h"
+#include "render.h"
+#include "ui_latency.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+typedef struct
+{
+  uint16_t x;
+  uint16_t y;
+  const glyph_atlas_t *atlas;
+  uint8_t len;
+  tft_color_t fg;
+  tft_color_t bg;
+  char text[RENDER_TEXT_LEN];
+}
+render_text_t;
+
+typedef struct
+{
+  render_rect_t rect;
+  tft_color_t color;
+}
+render_box_t;
+
+/* Private variables ---------------------------------------------------------*/
+
+static tft_color_t _background;
+
+static render_text_t _text[RENDER_TEXT_MAX];
+static uint8_t _text_count;
+
+// painted in order, under every text item
+static render_box_t _box[RENDER_BOX_MAX];
+static uint8_t _box_count;
+
+static render_rect_t _damage[RENDER_DAMAGE_MAX];
+static uint8_t _damage_count;
+
+// ping-pong: one is rasterized while DMA sends the other
+static tft_color_t _strip[2U][RENDER_STRIP_PIXELS];
+
+static render_stats_t _stats;
+static uint64_t _bytes_total;
+static uint64_t _time_total;
+static uint64_t _dma_total;
+
+/* Private function prototypes -----------------------------------------------*/
+
+static uint32_t _area(const render_rect_t *r);
+static render_rect_t _union(const render_rect_t *a, const render_rect_t *b);
+static uint8_t _overlap(const render_rect_t *a, const render_rect_t *b);
+static render_rect_t _text_extent(const render_text_t *t, uint8_t len);
+static uint16_t _blank_rows(const render_rect_t *r, uint16_t y0);
+static uint8_t _clip_rows(const render_rect_t *e, const render_rect_t *r,
+    uint16_t y0, uint16_t *rows);
+static void _paint(tft_color_t *buf, const render_rect_t *r, uint16_t y0, uint16_t rows);
+static void _paint_text(tft_color_t *buf, const render_text_t *t,
+    const render_rect_t *r, uint16_t y0, uint16_t rows);
+static void _paint_box(tft_color_t *buf, const render_box_t *b,
+    const render_rect_t *r, uint16_t y0, uint16_t rows);
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Reset the scene to a plain background and damage the whole screen.
+  * @param  background: colour of everything not covered by an item
+  * @retval None
+  */
+void render_init(tft_color_t background)
+{
+  render_rect_t all = { 0U, 0U, TFT_WIDTH, TFT_HEIGHT };
+
+  _background = background;
+  _text_count = 0U;
+  _box_count = 0U;
+  _damage_count = 0U;
+
+  render_damage(&all);
+}
+
+/**
+  * @brief  Add a text item to the scene, initially empty.
+  * @param  x, y: top-left corner
+  * @param  atlas: glyph source
+  * @param  fg, bg: glyph and cell colours
+  * @retval Item id, RENDER_TEXT_NONE if the scene is full
+  */
+render_text_id_t render_text(uint16_t x, uint16_t y,
+    const glyph_atlas_t *atlas, tft_color_t fg, tft_color_t bg)
+{
+  if ((_text_count >= RENDER_TEXT_MAX) || (NULL == atlas))
+    { return RENDER_TEXT_NONE; }
+
+  render_text_t *t = &_text[_text_count];
+  memset(t, 0, sizeof(*t));
+  t->x = x;
+  t->y = y;
+  t->atlas = atlas;
+  t->fg = fg;
+  t->bg = bg;
+
+  return _text_count++;
+}
+
+/**
+  * @brief  Change the string of a text item, damaging only the cells whose
+  *         character differs from the one shown.
+  * @param  id: item from render_text()
+  * @param  str: new string, truncated to RENDER_TEXT_LEN - 1 characters
+  * @retval None
+  */
+void render_text_set(render_text_id_t id, const char *str)
+{
+  if ((id >= _text_count) || (NULL == str))
+    { return; }
+
+  render_text_t *t = &_text[id];
+  size_t len = strnlen(str, RENDER_TEXT_LEN - 1U);
+  // cells past the end of the shorter string are blank on that side
+  size_t span = (len > t->len) ? len : t->len;
+  uint16_t cell = t->atlas->advance;
+
+  for (size_t i = 0U; i < span; ++i)
+  {
+    char was = (i < t->len) ? t->text[i] : ' ';
+    char now = (i < len) ? str[i] : ' ';
+
+    if (was != now)
+    {
+      render_rect_t r = { t->x + (uint16_t)(i * cell), t->y, cell, t->atlas->height };
+      render_damage(&r);
+    }
+  }
+
+  memcpy(t->text, str, len);
+  t->text[len] = '\0';
+  t->len = (uint8_t)len;
+}
+
+/**
+  * @brief  Change the colours of a text item, damaging the cells it covers.
+  * @param  id: item from render_text()
+  * @param  fg, bg: glyph and cell colours
+  * @retval None
+  */
+void render_text_color(render_text_id_t id, tft_color_t fg, tft_color_t bg)
+{
+  if (id >= _text_count)
+    { return; }
+
+  render_text_t *t = &_text[id];
+  if ((fg == t->fg) && (bg == t->bg))
+    { return; }
+
+  render_rect_t e = _text_extent(t, t->len);
+  render_damage(&e);
+  t->fg = fg;
+  t->bg = bg;
+}
+
+/**
+  * @brief  Add a filled box to the scene. Boxes are painted in the order
+  *         they were added, under all text.
+  * @param  rect: initial extent
+  * @param  color: fill colour
+  * @retval Item id, RENDER_BOX_NONE if the scene is full
+  */
+render_box_id_t render_box(const render_rect_t *rect, tft_color_t color)
+{
+  if ((_box_count >= RENDER_BOX_MAX) || (NULL == rect))
+    { return RENDER_BOX_NONE; }
+
+  render_box_t *b = &_box[_box_count];
+  b->rect = *rect;
+  b->color = color;
+  render_damage(&b->rect);
+
+  return _box_count++;
+}
+
+/**
+  * @brief  Resize a box from its left edge or recolour it. A new width only
+  *         damages the columns gained or lost, a new colour the whole box.
+  * @param  id: item from render_box()
+  * @param  w: width in pixels, 0 hides the box
+  * @param  color: fill colour
+  * @retval None
+  */
+void render_box_set(render_box_id_t id, uint16_t w, tft_color_t color)
+{
+  if (id >= _box_count)
+    { return; }
+
+  render_box_t *b = &_box[id];
+  uint16_t lo = (w < b->rect.w) ? w : b->rect.w;
+  uint16_t hi = (w < b->rect.w) ? b->rect.w : w;
+
+  if (color != b->color)
+  {
+    render_rect_t d = { b->rect.x, b->rect.y, hi, b->rect.h };
+    render_damage(&d);
+  }
+  else if (lo != hi)
+  {
+    render_rect_t d = { b->rect.x + lo, b->rect.y, hi - lo, b->rect.h };
+    render_damage(&d);
+  }
+
+  b->rect.w = w;
+  b->color = color;
+}
+
+/**
+  * @brief  Mark a rectangle for repaint, merging it with the damage list.
+  * @param  rect: area in screen coordinates, clipped to the screen
+  * @retval None
+  */
+void render_damage(const render_rect_t *rect)
+{
+  if ((NULL == rect) || (rect->x >= TFT_WIDTH) || (rect->y >= TFT_HEIGHT))
+    { return; }
+
+  render_rect_t r = *rect;
+  if (r.w > (TFT_WIDTH - r.x))
+    { r.w = TFT_WIDTH - r.x; }
+  if (r.h > (TFT_HEIGHT - r.y))
+    { r.h = TFT_HEIGHT - r.y; }
+  if ((0U == r.w) || (0U == r.h))
+    { return; }
+
+  for (;;)
+  {
+    uint8_t merged = 0U;
+
+    for (uint8_t i = 0U; i < _damage_count; ++i)
+    {
+      render_rect_t u = _union(&r, &_damage[i]);
+      if (_overlap(&r, &_damage[i]) ||
+          (_area(&u) <= (_area(&r) + _area(&_damage[i]) + RENDER_MERGE_SLACK)))
+      {
+        // the grown rectangle may now reach others: start over
+        r = u;
+        _damage[i] = _damage[--_damage_count];
+        merged = 1U;
+        break;
+      }
+    }
+
+    if (0U != merged)
+      { continue; }
+
+    if (_damage_count < RENDER_DAMAGE_MAX)
+      { break; }
+
+    // list full: fold into the rectangle that grows the least
+    uint8_t best = 0U;
+    uint32_t best_cost = UINT32_MAX;
+    for (uint8_t i = 0U; i < _damage_count; ++i)
+    {
+      render_rect_t u = _union(&r, &_damage[i]);
+      uint32_t cost = _area(&u) - _area(&_damage[i]);
+      if (cost < best_cost)
+      {
+        best = i;
+        best_cost = cost;
+      }
+    }
+    r = _union(&r, &_damage[best]);
+    _damage[best] = _damage[--_damage_count];
+  }
+
+  _damage[_damage_count++] = r;
+}
+
+/**
+  * @brief  Send every damaged rectangle to the display and clear the damage.
+  *         Strips are rasterized while the previous one is on the bus.
+  *         Caller must own the display.
+  * @retval HAL status of the first failed transfer, HAL_OK otherwise
+  */
+HAL_StatusTypeDef render_flush(void)
+{
+  HAL_StatusTypeDef status = HAL_OK;
+  uint32_t start;
+  uint32_t busy;
+  uint32_t stall = 0U;
+  uint32_t pixels = 0U;
+  uint32_t windows = _damage_count;
+  uint8_t buf = 0U;
+
+  if (0U == _damage_count)
+    { return HAL_OK; }
+
+  start = cycles_now();
+  busy = tft_busy_cycles();
+  tft_begin();
+
+  for (uint8_t i = 0U; (i < _damage_count) && (HAL_OK == status); ++i)
+  {
+    const render_rect_t *r = &_damage[i];
+    uint16_t rows_max = (uint16_t)(RENDER_STRIP_PIXELS / r->w);
+
+    for (uint16_t y = 0U; (y < r->h) && (HAL_OK == status); )
+    {
+      // plain background is filled from a single colour, the rest rasterized
+      uint16_t rows = _blank_rows(r, r->y + y);
+      uint8_t fill = (rows > 0U);
+
+      if (0U == fill)
+      {
+        rows = ((r->h - y) < rows_max) ? (r->h - y) : rows_max;
+        // overlaps the transfer of the other buffer
+        _paint(_strip[buf], r, r->y + y, rows);
+      }
+
+      uint32_t wait = cycles_now();
+      status = tft_wait();
+      stall += cycles_since(wait);
+
+      // a new window can only be opened once the previous data is out; a
+      // touch sample taking the bus between bands closes the current one
+      uint8_t yielded = (HAL_OK == status) ? tft_yield() : 0U;
+      if ((HAL_OK == status) && ((0U == y) || (0U != yielded)))
+        { status = tft_window(r->x, r->y + y, r->x + r->w - 1U, r->y + r->h - 1U); }
+      if (HAL_OK == status)
+      {
+        uint32_t count = (uint32_t)r->w * rows;
+        if (0U != fill)
+          { status = tft_fill(_background, count); }
+        else
+        {
+          status = tft_write_async(_strip[buf], count);
+          buf ^= 1U;
+        }
+      }
+
+      y += rows;
+    }
+
+    pixels += (uint32_t)r->w * r->h;
+  }
+
+  ui_latency_rendered();
+
+  uint32_t wait = cycles_now();
+  if (HAL_OK == status)
+    { status = tft_wait(); }
+  else
+    { (void)tft_wait(); }
+  stall += cycles_since(wait);
+
+  tft_end();
+  _damage_count = 0U;
+
+  uint32_t time = cycles_to_us(cycles_since(start));
+  uint32_t dma = cycles_to_us(tft_busy_cycles() - busy);
+  uint32_t bytes = (pixels * TFT_BYTES_PER_PIXEL) + (windows * TFT_WINDOW_BYTES);
+
+  taskENTER_CRITICAL();
+  ++_stats.frames;
+  _bytes_total += bytes;
+  _time_total  += time;
+  _dma_total   += dma;
+  _stats.windows   = windows;
+  _stats.pixels    = pixels;
+  _stats.bytes     = bytes;
+  _stats.bytes_avg = (uint32_t)(_bytes_total / _stats.frames);
+  _stats.time      = time;
+  _stats.dma       = dma;
+  _stats.stall     = cycles_to_us(stall);
+  _stats.utilisation = (0U == time) ? 0U : (uint16_t)(((uint64_t)dma * 1000U) / time);
+  _stats.utilisation_avg = (0U == _time_total) ? 0U :
+      (uint16_t)((_dma_total * 1000U) / _time_total);
+  if (bytes > _stats.bytes_max)
+    { _stats.bytes_max = bytes; }
+  if (time > _stats.time_max)
+    { _stats.time_max = time; }
+  taskEXIT_CRITICAL();
+
+  return status;
+}
+
+/**
+  * @brief  Copy the per-frame statistics.
+  * @param  stats: destination
+  * @retval None
+  */
+void render_stats(render_stats_t *stats)
+{
+  if (NULL == stats)
+    { return; }
+
+  taskENTER_CRITICAL();
+  *stats = _stats;
+  taskEXIT_CRITICAL();
+}
+
+/**
+  * @brief  Lend a strip buffer to code drawing with the display owned. Its
+  *         content is lost at the next render_flush(), which must not start
+  *         before the transfers out of it have completed.
+  * @param  index: 0 or 1
+  * @retval RENDER_STRIP_PIXELS pixels
+  */
+tft_color_t *render_scratch(uint8_t index)
+{
+  return _strip[index & 1U];
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+static uint32_t _area(const render_rect_t *r)
+{
+  return (uint32_t)r->w * r->h;
+}
+
+static render_rect_t _union(const render_rect_t *a, const render_rect_t *b)
+{
+  uint16_t x0 = (a->x < b->x) ? a->x : b->x;
+  uint16_t y0 = (a->y < b->y) ? a->y : b->y;
+  uint16_t x1 = ((a->x + a->w) > (b->x + b->w)) ? (a->x + a->w) : (b->x + b->w);
+  uint16_t y1 = ((a->y + a->h) > (b->y + b->h)) ? (a->y + a->h) : (b->y + b->h);
+
+  return (render_rect_t){ x0, y0, x1 - x0, y1 - y0 };
+}
+
+static uint8_t _overlap(const render_rect_t *a, const render_rect_t *b)
+{
+  return (a->x < (b->x + b->w)) && (b->x < (a->x + a->w)) &&
+         (a->y < (b->y + b->h)) && (b->y < (a->y + a->h));
+}
+
+static render_rect_t _text_extent(const render_text_t *t, uint8_t len)
+{
+  return (render_rect_t)
+  {
+    t->x, t->y,
+    (uint16_t)(len * t->atlas->advance),
+    t->atlas->height,
+  };
+}
+
+/**
+  * @brief  Number of rows from y0 down that no item touches inside the
+  *         damaged rectangle, i.e. that are plain background.
+  */
+static uint16_t _blank_rows(const render_rect_t *r, uint16_t y0)
+{
+  uint16_t rows = r->y + r->h - y0;
+
+  for (uint8_t i = 0U; i < _box_count; ++i)
+  {
+    if (0U == _clip_rows(&_box[i].rect, r, y0, &rows))
+      { return 0U; }
+  }
+
+  for (uint8_t i = 0U; i < _text_count; ++i)
+  {
+    render_rect_t e = _text_extent(&_text[i], _text[i].len);
+    if (0U == _clip_rows(&e, r, y0, &rows))
+      { return 0U; }
+  }
+
+  return rows;
+}
+
+/**
+  * @brief  Shorten a run of blank rows from y0 down to end above an item.
+  * @retval 0 if the item covers row y0 itself
+  */
+static uint8_t _clip_rows(const render_rect_t *e, const render_rect_t *r,
+    uint16_t y0, uint16_t *rows)
+{
+  if ((0U == e->w) || (e->x >= (r->x + r->w)) || (r->x >= (e->x + e->w)) ||
+      ((e->y + e->h) <= y0))
+    { return 1U; }
+  if (e->y <= y0)
+    { return 0U; }
+  if ((e->y - y0) < *rows)
+    { *rows = e->y - y0; }
+
+  return 1U;
+}
+
+/**
+  * @brief  Rasterize rows y0..y0+rows of a damaged rectangle into a strip
+  *         buffer.
+  */
+static void _paint(tft_color_t *buf, const render_rect_t *r, uint16_t y0, uint16_t rows)
+{
+  uint32_t count = (uint32_t)r->w * rows;
+
+  for (uint32_t i = 0U; i < count; ++i)
+    { buf[i] = _background; }
+
+  for (uint8_t i = 0U; i < _box_count; ++i)
+    { _paint_box(buf, &_box[i], r, y0, rows); }
+
+  for (uint8_t i = 0U; i < _text_count; ++i)
+    { _paint_text(buf, &_text[i], r, y0, rows); }
+}
+
+/**
+  * @brief  Fill the part of a box that falls inside the strip.
+  */
+static void _paint_box(tft_color_t *buf, const render_box_t *b,
+    const render_rect_t *r, uint16_t y0, uint16_t rows)
+{
+  const render_rect_t *e = &b->rect;
+  render_rect_t s = { r->x, y0, r->w, rows };
+
+  if ((0U == e->w) || !_overlap(e, &s))
+    { return; }
+
+  uint16_t cx0 = (e->x > s.x) ? e->x : s.x;
+  uint16_t cy0 = (e->y > s.y) ? e->y : s.y;
+  uint16_t cx1 = ((e->x + e->w) < (s.x + s.w)) ? (e->x + e->w) : (s.x + s.w);
+  uint16_t cy1 = ((e->y + e->h) < (s.y + s.h)) ? (e->y + e->h) : (s.y + s.h);
+
+  for (uint16_t y = cy0; y < cy1; ++y)
+  {
+    tft_color_t *p = &buf[((uint32_t)(y - y0) * s.w) + (cx0 - s.x)];
+    for (uint16_t x = cx0; x < cx1; ++x)
+      { *p++ = b->color; }
+  }
+}
+
+/**
+  * @brief  Overlay the part of a text item that falls inside the strip,
+  *         expanding the atlas row masks one glyph cell at a time.
+  */
+static void _paint_text(tft_color_t *buf, const render_text_t *t,
+    const render_rect_t *r, uint16_t y0, uint16_t rows)
+{
+  render_rect_t e = _text_extent(t, t->len);
+  render_rect_t s = { r->x, y0, r->w, rows };
+
+  if ((0U == e.w) || !_overlap(&e, &s))
+    { return; }
+
+  uint16_t cx0 = (e.x > s.x) ? e.x : s.x;
+  uint16_t cy0 = (e.y > s.y) ? e.y : s.y;
+  uint16_t cx1 = ((e.x + e.w) < (s.x + s.w)) ? (e.x + e.w) : (s.x + s.w);
+  uint16_t cy1 = ((e.y + e.h) < (s.y + s.h)) ? (e.y + e.h) : (s.y + s.h);
+  const glyph_atlas_t *a = t->atlas;
+
+  for (uint16_t y = cy0; y < cy1; ++y)
+  {
+    uint16_t row = y - t->y;
+    tft_color_t *p = &buf[((uint32_t)(y - y0) * s.w) + (cx0 - s.x)];
+    uint16_t x = cx0;
+
+    while (x < cx1)
+    {
+      uint16_t lx = x - t->x;
+      uint16_t col = lx % a->advance;
+      uint16_t end = a->advance;
+      const uint8_t *mask = glyph_find(a, t->text[lx / a->advance]);
+
+      // this cell may be cut by the strip's right edge
+      if ((end - col) > (cx1 - x))
+        { end = col + (cx1 - x); }
+      x += end - col;
+
+      if (NULL != mask)
+        { mask += row * a->stride; }
+
+      for (; col < end; ++col)
+      {
+        uint8_t on = (NULL != mask) && (col < a->width) &&
+            (0U != (mask[col >> 3U] & (0x80U >> (col & 7U))));
+        *p++ = on ? t->fg : t->bg;
+      }
+    }
+  }
+}
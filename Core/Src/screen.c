@@ -0,0 +1,399 @@
+/**
+  ******************************************************************************
+  * @file           : screen.c
+  * @brief          : Event-driven display pipeline run by ScreenTask.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+
+#include "main.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "cmsis_os.h"
+#include "usbpd.h"
+
+#include "asset.h"
+#include "assets.h"
+#include "chart.h"
+#include "cycles.h"
+#include "deadline.h"
+#include "measure.h"
+#include "pdo.h"
+#include "render.h"
+#include "screen.h"
+#include "touch.h"
+#include "ui_latency.h"
+#include "ui_layout.h"
+#include "widget.h"
+
+/* Private define ------------------------------------------------------------*/
+
+#define SCREEN_FRAME_MS     (1000U / SCREEN_FPS_MAX)
+#define SCREEN_FPS_WINDOW   1000U
+
+#define SCREEN_LINE_LEN     WIDGET_TEXT_LEN
+
+// below the last readout
+#define SCREEN_ICON_X       6U
+#define SCREEN_ICON_Y       214U
+
+// power bar scale without a contract: 5 V at the Type-C 3 A current
+#define SCREEN_POWER_DEFAULT_MW  15000
+
+/* Private variables ---------------------------------------------------------*/
+
+// samples per chart column, cycled by tapping the chart
+static const uint16_t _timebases[] = { 1U, 4U, 16U, 64U };
+
+static osThreadId _task;
+static deadline_id_t _deadline = DEADLINE_NONE;
+
+static uint32_t _frame_tick;
+static uint32_t _fps_tick;
+static uint32_t _fps_frames;
+
+static screen_stats_t _stats;
+static uint64_t _render_total;
+
+static uint8_t _icon;
+static uint8_t _timebase;
+static widget_id_t _page = UI_LIVE;
+
+/* Private function prototypes -----------------------------------------------*/
+
+static void _update(void);
+static void _update_pdo(void);
+static void _update_latency(void);
+static void _show(widget_id_t page);
+static void _touch(const touch_event_t *event);
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Bind the pipeline to the task that renders it.
+  * @param  task: ScreenTask handle
+  * @retval None
+  */
+void screen_init(osThreadId task)
+{
+  _task = task;
+  _deadline = deadline_register("screen", SCREEN_DEADLINE_US);
+
+  render_init(TFT_RGB(0U, 0U, 0U));
+  widget_init();
+}
+
+/**
+  * @brief  Show the splash image until the first frame replaces it. Call
+  *         from the screen task, which is held for SCREEN_SPLASH_MS.
+  * @retval None
+  */
+void screen_splash(void)
+{
+  if (HAL_OK == asset_draw(&asset_splash, 0U, 0U))
+    { osDelay(SCREEN_SPLASH_MS); }
+}
+
+/**
+  * @brief  Post events to the screen task. Safe from tasks and from ISRs up
+  *         to the syscall priority.
+  * @param  events: SCREEN_EVENT_* bits
+  * @retval None
+  */
+void screen_notify(uint32_t events)
+{
+  if (NULL == _task)
+    { return; }
+
+  UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+  ++_stats.events;
+  taskEXIT_CRITICAL_FROM_ISR(mask);
+
+  deadline_start(_deadline);
+  (void)osSignalSet(_task, (int32_t)events);
+}
+
+/**
+  * @brief  Block until there is something to draw, then keep collecting
+  *         events until the next frame slot. Call from the screen task only.
+  * @retval Accumulated SCREEN_EVENT_* bits
+  */
+uint32_t screen_wait(void)
+{
+  uint32_t events = 0U;
+  osEvent event;
+
+  event = osSignalWait(SCREEN_EVENT_ALL, osWaitForever);
+  if (osEventSignal == event.status)
+    { events |= (uint32_t)event.value.signals; }
+
+  for (;;)
+  {
+    uint32_t elapsed = osKernelSysTick() - _frame_tick;
+    if (elapsed >= SCREEN_FRAME_MS)
+      { break; }
+
+    event = osSignalWait(SCREEN_EVENT_ALL, SCREEN_FRAME_MS - elapsed);
+    if (osEventSignal == event.status)
+      { events |= (uint32_t)event.value.signals; }
+  }
+
+  return events;
+}
+
+/**
+  * @brief  Draw one frame, only the rectangles damaged by changed widgets
+  *         and the new chart columns are sent to the display. Caller must
+  *         own the display.
+  * @param  events: SCREEN_EVENT_* bits that led to this frame
+  * @retval None
+  */
+void screen_render(uint32_t events)
+{
+  touch_event_t touch;
+  uint32_t start = cycles_now();
+
+  // traced from the first event to the end of the flush it leads to
+  while (0U != touch_event(&touch))
+  {
+    ui_latency_begin(touch.edge, touch.cycles);
+    _touch(&touch);
+  }
+  ui_latency_handled();
+
+  // only the page on screen is fed
+  if (UI_PDOS == _page)
+    { _update_pdo(); }
+  else if (UI_OVERLAY == _page)
+    { _update_latency(); }
+  else
+    { _update(); }
+
+  widget_update();
+  (void)render_flush();
+  ui_latency_end();
+
+  // static decoration, once the first flush has cleared the splash
+  if (0U == _icon)
+    { _icon = (HAL_OK == asset_draw(&asset_bolt, SCREEN_ICON_X, SCREEN_ICON_Y)); }
+
+  // after the first flush, which clears the whole screen
+  if (0U != (events & SCREEN_EVENT_CHART))
+    { (void)chart_draw(); }
+
+  deadline_finish(_deadline);
+
+  uint32_t render = cycles_to_us(cycles_since(start));
+  uint32_t now = osKernelSysTick();
+
+  _frame_tick = now;
+  ++_fps_frames;
+
+  taskENTER_CRITICAL();
+  ++_stats.frames;
+  _render_total += render;
+  _stats.render_last = render;
+  _stats.render_avg  = (uint32_t)(_render_total / _stats.frames);
+  if (render > _stats.render_max)
+    { _stats.render_max = render; }
+  if ((now - _fps_tick) >= SCREEN_FPS_WINDOW)
+  {
+    _stats.fps = (uint16_t)((_fps_frames * 10000U) / (now - _fps_tick));
+    _fps_tick = now;
+    _fps_frames = 0U;
+  }
+  taskEXIT_CRITICAL();
+}
+
+/**
+  * @brief  Copy the frame statistics.
+  * @param  stats: destination
+  * @retval None
+  */
+void screen_stats(screen_stats_t *stats)
+{
+  if (NULL == stats)
+    { return; }
+
+  taskENTER_CRITICAL();
+  *stats = _stats;
+  // no frame for a whole window: the display is idle
+  if ((osKernelSysTick() - _frame_tick) >= SCREEN_FPS_WINDOW)
+    { stats->fps = 0U; }
+  taskEXIT_CRITICAL();
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Feed the readouts from the current state, only values that
+  *         changed are redrawn.
+  * @retval None
+  */
+static void _update(void)
+{
+  measure_snapshot_t m;
+  USBPD_HandleTypeDef *port = &DPM_Ports[USBPD_PORT_0];
+  uint8_t attached = (0U != port->DPM_IsConnected);
+
+  measure_snapshot(&m);
+
+  widget_set_value(UI_VBUS, (int32_t)m.voltage);
+  widget_set_value(UI_IBUS, m.current);
+  widget_set_value(UI_PBUS, m.power);
+  widget_set_value(UI_POWER, (m.power < 0) ? -m.power : m.power);
+
+  widget_show(UI_PD_DETACHED, !attached);
+  widget_show(UI_PD_VOLTAGE, attached);
+  widget_show(UI_PD_CURRENT, attached);
+
+  if (0U != attached)
+  {
+    widget_set_value(UI_PD_VOLTAGE, (int32_t)port->DPM_RequestedVoltage);
+    widget_set_value(UI_PD_CURRENT, (int32_t)port->DPM_RequestedCurrent);
+    widget_set_range(UI_POWER, (int32_t)(((uint64_t)port->DPM_RequestedVoltage *
+        port->DPM_RequestedCurrent) / 1000U));
+  }
+  else
+    { widget_set_range(UI_POWER, SCREEN_POWER_DEFAULT_MW); }
+}
+
+/**
+  * @brief  List the source capabilities, highlight the object of the
+  *         contract and show how the last request went.
+  * @retval None
+  */
+static void _update_pdo(void)
+{
+  USBPD_HandleTypeDef *port = &DPM_Ports[USBPD_PORT_0];
+  uint32_t count = 0U;
+  char row[SCREEN_LINE_LEN];
+  pdo_info_t info;
+  pdo_stats_t stats;
+
+  if (0U != port->DPM_IsConnected)
+  {
+    count = (port->DPM_NumberOfRcvSRCPDO < UI_PDO_ROWS) ?
+        port->DPM_NumberOfRcvSRCPDO : UI_PDO_ROWS;
+  }
+
+  for (uint32_t i = 0U; i < UI_PDO_ROWS; ++i)
+  {
+    row[0] = '\0';
+    if (i < count)
+    {
+      pdo_decode(port->DPM_ListOfRcvSRCPDO[i], &info);
+      pdo_format(&info, row, sizeof(row));
+    }
+    widget_list_set(UI_PDO, (uint8_t)i, row);
+  }
+
+  widget_set_value(UI_PDO, ((port->DPM_RDOPosition >= 1U) &&
+      (port->DPM_RDOPosition <= count)) ? (int32_t)port->DPM_RDOPosition - 1 : -1);
+
+  pdo_stats(&stats);
+  switch (stats.state)
+  {
+    case PDO_REQUEST_PENDING:
+      snprintf(row, sizeof(row), "REQUESTING");
+      break;
+    case PDO_REQUEST_READY:
+      // tap to explicit contract
+      snprintf(row, sizeof(row), "READY %lu ms",
+          (stats.latency_last > 9999999U) ? 9999U : (stats.latency_last / 1000U));
+      break;
+    case PDO_REQUEST_REJECTED:
+      snprintf(row, sizeof(row), "REJECTED");
+      break;
+    case PDO_REQUEST_FAILED:
+      snprintf(row, sizeof(row), "NOT SENT");
+      break;
+    default:
+      snprintf(row, sizeof(row), (0U != count) ? "TAP A RAIL" : "NO SOURCE PD");
+      break;
+  }
+  widget_set_text(UI_PDO_STATUS, row);
+}
+
+/**
+  * @brief  Fill the overlay with one row per latency stage: average and 95th
+  *         percentile, in ms.
+  * @retval None
+  */
+static void _update_latency(void)
+{
+  ui_latency_stats_t stats;
+  char row[SCREEN_LINE_LEN];
+
+  ui_latency_stats(&stats);
+
+  for (uint32_t i = 0U; i < UI_LATENCY_STAGES; ++i)
+  {
+    const ui_latency_hist_t *h = &stats.stage[i];
+    uint32_t avg = (h->avg > 999999U) ? 999999U : h->avg;
+    uint32_t p95 = ui_latency_percentile(h, 95U) / 1000U;
+
+    snprintf(row, sizeof(row), "%-3s%3lu.%lu%4lu",
+        ui_latency_name((ui_latency_stage_t)i),
+        avg / 1000U, (avg % 1000U) / 100U, (p95 > 9999U) ? 9999U : p95);
+    widget_list_set(UI_LATENCY, (uint8_t)i, row);
+  }
+}
+
+/**
+  * @brief  React to a touch event.
+  * @param  event: oldest unhandled event
+  * @retval None
+  */
+static void _touch(const touch_event_t *event)
+{
+  widget_id_t id = widget_touch(event);
+
+  if (TOUCH_PRESS == event->type)
+  {
+    switch (id)
+    {
+      case UI_CHART:
+        _timebase = (_timebase + 1U) % (sizeof(_timebases) / sizeof(*_timebases));
+        chart_timebase(_timebases[_timebase]);
+        break;
+      case UI_PD:
+        _show(UI_PDOS);
+        break;
+      case UI_PDO:
+      {
+        uint8_t row = widget_list_row(UI_PDO, event->y);
+        // measured from the pen edge to the explicit contract
+        if (WIDGET_NONE != row)
+          { (void)pdo_request(USBPD_PORT_0, row + 1U, event->edge); }
+        break;
+      }
+      default:
+        break;
+    }
+  }
+  // buttons act when the pen is lifted over them
+  else if ((TOUCH_RELEASE == event->type) && (UI_PDO_BACK == id))
+    { _show(UI_LIVE); }
+  else if ((0 != SCREEN_OVERLAY) &&
+      (TOUCH_LONG_PRESS == event->type) && (UI_READOUTS == id))
+    { _show((UI_OVERLAY == _page) ? UI_LIVE : UI_OVERLAY); }
+}
+
+/**
+  * @brief  Replace the page shown left of the chart.
+  * @param  page: UI_LIVE, UI_PDOS or UI_OVERLAY
+  * @retval None
+  */
+static void _show(widget_id_t page)
+{
+  if (page == _page)
+    { return; }
+
+  widget_show(_page, 0U);
+  widget_show(page, 1U);
+  _page = page;
+}
@@ -0,0 +1,1262 @@
+/**
+  ******************************************************************************
+  * @file           : shell.c
+  * @brief          : SCPI-like command shell on USART2, run by ShellTask.
+  ******************************************************************************
+  * @attention
+  *
+  * The parser works on (pointer, length) text and never writes to it, which
+  * is what lets a message be parsed inside the DMA buffer. The DMA may still
+  * overwrite a message while it is parsed if the host sends more than a
+  * buffer's worth behind it; the next poll sees the overrun and drops the
+  * pending input.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "main.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "usbpd.h"
+
+#include "baud.h"
+#include "cycles.h"
+#include "deadline.h"
+#include "isr_profile.h"
+#include "link.h"
+#include "measure.h"
+#include "pd_timer.h"
+#include "pd_trace.h"
+#include "pdo.h"
+#include "render.h"
+#include "screen.h"
+#include "shell.h"
+#include "sniff.h"
+#include "spi_bus.h"
+#include "telemetry.h"
+#include "uart_rx.h"
+#include "uart_tx.h"
+
+/* Private define ------------------------------------------------------------*/
+
+#define SHELL_PORT            USBPD_PORT_0
+#define SHELL_RX_MASK         (UART_RX_BUFFER_SIZE - 1U)
+
+// how long a response waits for room in the transmit ring
+#define SHELL_SEND_WAIT_MS    100U
+
+// longest wait for input, so that baud_poll() keeps time
+#define SHELL_POLL_MS         50U
+
+// SCPI error codes
+#define SHELL_E_NONE          0
+#define SHELL_E_DATA_TYPE     (-104)
+#define SHELL_E_NOT_ALLOWED   (-108)
+#define SHELL_E_MISSING       (-109)
+#define SHELL_E_HEADER        (-113)
+#define SHELL_E_SUFFIX        (-131)
+#define SHELL_E_EXECUTION     (-200)
+#define SHELL_E_CONFLICT      (-221)
+#define SHELL_E_RANGE         (-222)
+#define SHELL_E_TOO_MUCH      (-223)
+#define SHELL_E_NO_SOURCE     (-241)
+#define SHELL_E_OVERFLOW      (-350)
+#define SHELL_E_OVERRUN       (-363)
+
+/* Private typedef -----------------------------------------------------------*/
+
+typedef struct
+{
+  const char *text;
+  size_t len;
+}
+shell_text_t;
+
+typedef struct
+{
+  const char *header;     // keywords, short form in upper case
+  void (*handler)(const shell_text_t *arg);
+}
+shell_command_t;
+
+/* Private function prototypes -----------------------------------------------*/
+
+static void _idn(const shell_text_t *arg);
+static void _cls(const shell_text_t *arg);
+static void _error_query(const shell_text_t *arg);
+static void _statistics(const shell_text_t *arg);
+static void _counters_reset(const shell_text_t *arg);
+static void _capabilities(const shell_text_t *arg);
+static void _pdo(const shell_text_t *arg);
+static void _pdo_query(const shell_text_t *arg);
+static void _voltage(const shell_text_t *arg);
+static void _voltage_query(const shell_text_t *arg);
+static void _measure_voltage(const shell_text_t *arg);
+static void _measure_current(const shell_text_t *arg);
+static void _measure_power(const shell_text_t *arg);
+static void _measure(const shell_text_t *arg);
+static void _negotiate(const shell_text_t *arg);
+static void _confirm(const shell_text_t *arg);
+static void _baud_query(const shell_text_t *arg);
+static void _serial_errors(const shell_text_t *arg);
+static void _trace_query(const shell_text_t *arg);
+static void _trace_dropped(const shell_text_t *arg);
+static void _trace_sample(const shell_text_t *arg);
+static void _capture(const shell_text_t *arg);
+static void _capture_query(const shell_text_t *arg);
+static void _task_count(const shell_text_t *arg);
+static void _task_query(const shell_text_t *arg);
+static void _memory(const shell_text_t *arg);
+static void _deadline_count(const shell_text_t *arg);
+static void _deadline_query(const shell_text_t *arg);
+static void _isr_count(const shell_text_t *arg);
+static void _isr_query(const shell_text_t *arg);
+static void _display_stats(const shell_text_t *arg);
+static void _display_render(const shell_text_t *arg);
+static void _spi_query(const shell_text_t *arg);
+static void _pd_timer(const shell_text_t *arg);
+
+static void _overrun(uint32_t received);
+static void _message(uint32_t first, uint32_t last);
+static void _command(const char *text, size_t len);
+static uint8_t _match(const char *pattern, const char *header, size_t len);
+static uint8_t _equal(const char *a, const char *b, size_t len);
+static uint8_t _none(const shell_text_t *arg);
+static uint8_t _number(const shell_text_t *arg, int32_t *milli, shell_text_t *suffix);
+static uint8_t _integer(const shell_text_t *arg, uint32_t *value);
+static uint8_t _index(const shell_text_t *arg, uint32_t count, uint32_t *index);
+static uint8_t _connected(void);
+static void _reply(const char *format, ...) __attribute__((format(printf, 1, 2)));
+static void _reply_milli(const char *separator, int32_t milli);
+static void _send(void);
+static void _error(int16_t code);
+static const char *_error_message(int16_t code);
+static void _baseline(void);
+
+/* Private variables ---------------------------------------------------------*/
+
+static const shell_command_t _commands[] =
+{
+  { "*IDN?",                                _idn             },
+  { "*CLS",                                 _cls             },
+  { "SYSTem:ERRor?",                        _error_query     },
+  { "SYSTem:STATistics?",                   _statistics      },
+  { "SYSTem:COUNters:RESet",                _counters_reset  },
+  { "SOURce:CAPabilities?",                 _capabilities    },
+  { "SOURce:PDO",                           _pdo             },
+  { "SOURce:PDO?",                          _pdo_query       },
+  { "SOURce:VOLTage",                       _voltage         },
+  { "SOURce:VOLTage?",                      _voltage_query   },
+  { "MEASure:VOLTage?",                     _measure_voltage },
+  { "MEASure:CURRent?",                     _measure_current },
+  { "MEASure:POWer?",                       _measure_power   },
+  { "MEASure?",                             _measure         },
+  { "SYSTem:COMMunicate:SERial:NEGotiate?", _negotiate       },
+  { "SYSTem:COMMunicate:SERial:CONFirm?",   _confirm         },
+  { "SYSTem:COMMunicate:SERial:BAUD?",      _baud_query      },
+  { "SYSTem:COMMunicate:SERial:ERRors?",    _serial_errors   },
+  { "SYSTem:TRACe?",                        _trace_query     },
+  { "SYSTem:TRACe:DROPped?",                _trace_dropped   },
+  { "SYSTem:TRACe:SAMPle",                  _trace_sample    },
+  { "SYSTem:CAPTure",                       _capture         },
+  { "SYSTem:CAPTure?",                      _capture_query   },
+  { "SYSTem:TASK:COUNt?",                   _task_count      },
+  { "SYSTem:TASK?",                         _task_query      },
+  { "SYSTem:MEMory?",                       _memory          },
+  { "SYSTem:DEADline:COUNt?",               _deadline_count  },
+  { "SYSTem:DEADline?",                     _deadline_query  },
+  { "SYSTem:ISR:COUNt?",                    _isr_count       },
+  { "SYSTem:ISR?",                          _isr_query       },
+  { "DISPlay:STATistics?",                  _display_stats   },
+  { "DISPlay:RENDer?",                      _display_render  },
+  { "SYSTem:SPI?",                          _spi_query       },
+  { "SYSTem:PD:TIMer?",                     _pd_timer        },
+};
+
+static const char *const _type_name[] =
+{
+  [PDO_FIXED]    = "FIX",
+  [PDO_BATTERY]  = "BATT",
+  [PDO_VARIABLE] = "VAR",
+  [PDO_PPS]      = "PPS",
+  [PDO_UNKNOWN]  = "APDO",
+};
+
+static const char *const _spi_name[] =
+{
+  [SPI_BUS_TOUCH] = "TOUCH",
+  [SPI_BUS_TFT]   = "TFT",
+};
+
+static const char *const _baud_name[] =
+{
+  [BAUD_STEADY] = "STEADY",
+  [BAUD_SWITCH] = "SWITCH",
+  [BAUD_TRIAL]  = "TRIAL",
+};
+
+static const char *const _state_name[] =
+{
+  [PDO_REQUEST_IDLE]     = "IDLE",
+  [PDO_REQUEST_PENDING]  = "PEND",
+  [PDO_REQUEST_READY]    = "READY",
+  [PDO_REQUEST_REJECTED] = "REJ",
+  [PDO_REQUEST_FAILED]   = "FAIL",
+};
+
+static uint32_t _start;          // first byte of the pending message
+static uint32_t _scan;           // next byte to look at
+
+// a message wrapping around the end of the receive buffer
+static char _line[SHELL_LINE_MAX];
+
+static char _response[SHELL_REPLY_MAX];
+static size_t _response_len;
+static uint8_t _replied;         // the current command has answered
+
+static int16_t _queue[SHELL_ERROR_QUEUE];
+static uint8_t _queued;
+
+static shell_stats_t _stats;
+
+// counters at the last SYSTem:COUNters:RESet
+static struct
+{
+  uart_tx_stats_t tx;
+  uart_rx_stats_t rx;
+  uint32_t received;
+  link_stats_t link;
+  pd_trace_stats_t trace;
+  sniff_stats_t capture;
+}
+_base;
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Start listening for commands. Call after uart_rx_init(), from
+  *         MX_FREERTOS_Init().
+  * @param  task: ShellTask
+  * @retval None
+  */
+void shell_init(osThreadId task)
+{
+  _start = uart_rx_received(NULL);
+  _scan  = _start;
+  _baseline();
+
+  uart_rx_listen(task);
+}
+
+/**
+  * @brief  Block ShellTask until input arrives, the line goes idle or
+  *         SHELL_POLL_MS pass.
+  * @retval None
+  */
+void shell_wait(void)
+{
+  (void)osSignalWait(UART_RX_SIGNAL, SHELL_POLL_MS);
+}
+
+/**
+  * @brief  Execute every complete message received so far. Call from
+  *         ShellTask after shell_wait().
+  * @retval None
+  */
+void shell_poll(void)
+{
+  const uint8_t *buf = uart_rx_buffer();
+  uint32_t idle;
+  uint32_t received = uart_rx_received(&idle);
+
+  if ((received - _start) > UART_RX_BUFFER_SIZE)
+  {
+    _overrun(received);
+    baud_poll();
+    return;
+  }
+
+  while (_scan != received)
+  {
+    uint8_t c = buf[_scan & SHELL_RX_MASK];
+    ++_scan;
+
+    if (('\n' == c) || ('\r' == c))
+    {
+      _message(_start, _scan - 1U);
+      _start = _scan;
+    }
+  }
+
+  // nothing came after the last byte: the host is done with this message
+  if ((_start != received) && (idle == received))
+  {
+    _message(_start, received);
+    _start = received;
+  }
+
+  // after the responses: a rate switch waits for them to drain
+  baud_poll();
+}
+
+/**
+  * @brief  Copy the shell statistics.
+  * @param  stats: destination
+  * @retval None
+  */
+void shell_stats(shell_stats_t *stats)
+{
+  if (NULL == stats)
+    { return; }
+
+  taskENTER_CRITICAL();
+  *stats = _stats;
+  taskEXIT_CRITICAL();
+}
+
+/* Command handlers ----------------------------------------------------------*/
+
+static void _idn(const shell_text_t *arg)
+{
+  if (0U == _none(arg))
+    { return; }
+
+  _reply("ardnew,upd-data,%08lX%08lX%08lX,%u",
+      HAL_GetUIDw2(), HAL_GetUIDw1(), HAL_GetUIDw0(), LINK_SCHEMA_VERSION);
+}
+
+static void _cls(const shell_text_t *arg)
+{
+  if (0U == _none(arg))
+    { return; }
+
+  _queued = 0U;
+}
+
+static void _error_query(const shell_text_t *arg)
+{
+  int16_t code = SHELL_E_NONE;
+
+  if (0U == _none(arg))
+    { return; }
+
+  if (0U != _queued)
+  {
+    code = _queue[0];
+    memmove(&_queue[0], &_queue[1], (size_t)(--_queued) * sizeof(_queue[0]));
+  }
+
+  _reply("%d,\"%s\"", code, _error_message(code));
+}
+
+static void _statistics(const shell_text_t *arg)
+{
+  uart_tx_stats_t tx;
+  uart_rx_stats_t rx;
+  link_stats_t link;
+  uint32_t received = uart_rx_received(NULL);
+  uint32_t frames = 0U;
+  uint32_t dropped = 0U;
+
+  if (0U == _none(arg))
+    { return; }
+
+  uart_tx_stats(&tx);
+  uart_rx_stats(&rx);
+  link_stats(&link);
+
+  for (uint32_t i = 0U; i < LINK_CH_COUNT; ++i)
+  {
+    frames  += link.frames[i] - _base.link.frames[i];
+    dropped += link.dropped[i] - _base.link.dropped[i];
+  }
+
+  _reply("%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu",
+      tx.bytes - _base.tx.bytes,
+      (tx.dropped_new - _base.tx.dropped_new) +
+          (tx.dropped_old - _base.tx.dropped_old),
+      received - _base.received,
+      uart_rx_errors(&rx) - uart_rx_errors(&_base.rx),
+      frames, dropped,
+      _stats.commands, _stats.errors, _stats.overruns);
+}
+
+static void _counters_reset(const shell_text_t *arg)
+{
+  if (0U == _none(arg))
+    { return; }
+
+  isr_profile_reset();
+  for (deadline_id_t id = 0U; id < deadline_count(); ++id)
+    { deadline_reset(id); }
+
+  _baseline();
+
+  taskENTER_CRITICAL();
+  _stats.commands = 0U;
+  _stats.errors   = 0U;
+  _stats.overruns = 0U;
+  taskEXIT_CRITICAL();
+}
+
+static void _capabilities(const shell_text_t *arg)
+{
+  USBPD_HandleTypeDef *port = &DPM_Ports[SHELL_PORT];
+  pdo_info_t info;
+
+  if ((0U == _none(arg)) || (0U == _connected()))
+    { return; }
+
+  for (uint32_t i = 0U; i < port->DPM_NumberOfRcvSRCPDO; ++i)
+  {
+    pdo_decode(port->DPM_ListOfRcvSRCPDO[i], &info);
+    _reply("%s%s", (0U == i) ? "" : ",", _type_name[info.type]);
+    _reply_milli(",", (int32_t)info.mv_min);
+    _reply_milli(",", (int32_t)info.mv_max);
+    _reply_milli(",", (int32_t)info.ma);
+    _reply_milli(",", (int32_t)info.mw);
+  }
+}
+
+static void _pdo(const shell_text_t *arg)
+{
+  USBPD_HandleTypeDef *port = &DPM_Ports[SHELL_PORT];
+  shell_text_t suffix;
+  int32_t milli;
+  uint32_t position;
+  pdo_info_t info;
+
+  if ((0U == _number(arg, &milli, &suffix)) || (0U == _connected()))
+    { return; }
+
+  if ((0U != suffix.len) || (0 != (milli % 1000)))
+  {
+    _error(SHELL_E_DATA_TYPE);
+    return;
+  }
+
+  position = (uint32_t)(milli / 1000);
+  if ((milli < 1000) || (position > port->DPM_NumberOfRcvSRCPDO))
+  {
+    _error(SHELL_E_RANGE);
+    return;
+  }
+
+  pdo_decode(port->DPM_ListOfRcvSRCPDO[position - 1U], &info);
+  if (0U == pdo_requestable(&info))
+    { _error(SHELL_E_CONFLICT); }
+  else if (USBPD_OK != pdo_request(SHELL_PORT, (uint8_t)position, cycles_now()))
+    { _error(SHELL_E_EXECUTION); }
+}
+
+static void _pdo_query(const shell_text_t *arg)
+{
+  pdo_stats_t stats;
+
+  if (0U == _none(arg))
+    { return; }
+
+  pdo_stats(&stats);
+  _reply("%u,%s", stats.position, _state_name[stats.state]);
+}
+
+static void _voltage(const shell_text_t *arg)
+{
+  USBPD_HandleTypeDef *port = &DPM_Ports[SHELL_PORT];
+  shell_text_t suffix;
+  int32_t mv;
+  uint8_t pps = 0U;
+  pdo_info_t info;
+
+  if ((0U == _number(arg, &mv, &suffix)) || (0U == _connected()))
+    { return; }
+
+  if ((2U == suffix.len) && (0U != _equal(suffix.text, "MV", 2U)))
+    { mv /= 1000; }
+  else if ((0U != suffix.len) &&
+      ((1U != suffix.len) || (0U == _equal(suffix.text, "V", 1U))))
+  {
+    _error(SHELL_E_SUFFIX);
+    return;
+  }
+
+  for (uint32_t i = 0U; i < port->DPM_NumberOfRcvSRCPDO; ++i)
+  {
+    pdo_decode(port->DPM_ListOfRcvSRCPDO[i], &info);
+    if ((PDO_FIXED == info.type) && ((int32_t)info.mv_min == mv))
+    {
+      if (USBPD_OK != pdo_request(SHELL_PORT, (uint8_t)(i + 1U), cycles_now()))
+        { _error(SHELL_E_EXECUTION); }
+      return;
+    }
+    if ((PDO_PPS == info.type) &&
+        (mv >= (int32_t)info.mv_min) && (mv <= (int32_t)info.mv_max))
+      { pps = 1U; }
+  }
+
+  _error((0U != pps) ? SHELL_E_CONFLICT : SHELL_E_RANGE);
+}
+
+static void _voltage_query(const shell_text_t *arg)
+{
+  USBPD_HandleTypeDef *port = &DPM_Ports[SHELL_PORT];
+
+  if (0U == _none(arg))
+    { return; }
+
+  _reply_milli("", (0U != port->DPM_IsConnected) ?
+      (int32_t)port->DPM_RequestedVoltage : 0);
+}
+
+static void _measure_voltage(const shell_text_t *arg)
+{
+  measure_snapshot_t m;
+
+  if (0U == _none(arg))
+    { return; }
+
+  measure_snapshot(&m);
+  _reply_milli("", (int32_t)m.voltage);
+}
+
+static void _measure_current(const shell_text_t *arg)
+{
+  measure_snapshot_t m;
+
+  if (0U == _none(arg))
+    { return; }
+
+  measure_snapshot(&m);
+  _reply_milli("", m.current);
+}
+
+static void _measure_power(const shell_text_t *arg)
+{
+  measure_snapshot_t m;
+
+  if (0U == _none(arg))
+    { return; }
+
+  measure_snapshot(&m);
+  _reply_milli("", m.power);
+}
+
+static void _measure(const shell_text_t *arg)
+{
+  measure_snapshot_t m;
+
+  if (0U == _none(arg))
+    { return; }
+
+  measure_snapshot(&m);
+  _reply_milli("", (int32_t)m.voltage);
+  _reply_milli(",", m.current);
+  _reply_milli(",", m.power);
+}
+
+static void _negotiate(const shell_text_t *arg)
+{
+  uint32_t rate = UINT32_MAX;
+
+  if ((3U != arg->len) || (0U == _equal(arg->text, "MAX", 3U)))
+  {
+    if (0U == _integer(arg, &rate))
+      { return; }
+  }
+
+  _reply("%lu", baud_negotiate(rate));
+}
+
+static void _confirm(const shell_text_t *arg)
+{
+  baud_stats_t stats;
+
+  if (0U == _none(arg))
+    { return; }
+
+  (void)baud_confirm();
+  baud_stats(&stats);
+  _reply("%lu", stats.rate);
+}
+
+static void _baud_query(const shell_text_t *arg)
+{
+  baud_stats_t stats;
+
+  if (0U == _none(arg))
+    { return; }
+
+  baud_stats(&stats);
+  _reply("%lu,%u,%s,%lu,%lu,%lu", stats.rate, stats.oversampling,
+      _baud_name[stats.state], stats.switches, stats.confirmed, stats.fallbacks);
+}
+
+static void _serial_errors(const shell_text_t *arg)
+{
+  uart_rx_stats_t rx;
+
+  if (0U == _none(arg))
+    { return; }
+
+  uart_rx_stats(&rx);
+  _reply("%lu,%lu,%lu", rx.framing - _base.rx.framing,
+      rx.noise - _base.rx.noise, rx.overruns - _base.rx.overruns);
+}
+
+static void _trace_query(const shell_text_t *arg)
+{
+  pd_trace_stats_t trace;
+  uint32_t seen = 0U;
+  uint32_t dropped = 0U;
+  uint32_t records;
+
+  if (0U == _none(arg))
+    { return; }
+
+  pd_trace_stats(&trace);
+  for (uint32_t i = 0U; i < PD_TRACE_SOURCES; ++i)
+  {
+    seen    += trace.seen[i] - _base.trace.seen[i];
+    dropped += trace.dropped[i] - _base.trace.dropped[i];
+  }
+  records = trace.records - _base.trace.records;
+
+  _reply("%lu,%lu,%lu,%lu", records, seen - records - dropped, dropped,
+      trace.frames - _base.trace.frames);
+}
+
+static void _trace_dropped(const shell_text_t *arg)
+{
+  pd_trace_stats_t trace;
+
+  if (0U == _none(arg))
+    { return; }
+
+  pd_trace_stats(&trace);
+  for (uint32_t i = 0U; i < PD_TRACE_SOURCES; ++i)
+    { _reply("%s%lu", (0U != i) ? "," : "", trace.dropped[i] - _base.trace.dropped[i]); }
+}
+
+static void _trace_sample(const shell_text_t *arg)
+{
+  const char *comma = memchr(arg->text, ',', arg->len);
+  shell_text_t source = { arg->text, arg->len };
+  shell_text_t every = { "", 0U };
+  uint32_t s;
+  uint32_t n;
+
+  if (NULL != comma)
+  {
+    source.len = (size_t)(comma - arg->text);
+    every.text = comma + 1;
+    every.len  = arg->len - source.len - 1U;
+  }
+
+  if ((0U == _integer(&source, &s)) || (0U == _integer(&every, &n)))
+    { return; }
+
+  if ((s >= PD_TRACE_SOURCES) || (0U == n) || (n > UINT16_MAX))
+  {
+    _error(SHELL_E_RANGE);
+    return;
+  }
+
+  pd_trace_sample((uint8_t)s, (uint16_t)n);
+}
+
+static void _capture(const shell_text_t *arg)
+{
+  if (((2U == arg->len) && (0U != _equal(arg->text, "ON", 2U))) ||
+      ((1U == arg->len) && ('1' == arg->text[0])))
+    { sniff_enable(1U); }
+  else if (((3U == arg->len) && (0U != _equal(arg->text, "OFF", 3U))) ||
+      ((1U == arg->len) && ('0' == arg->text[0])))
+    { sniff_enable(0U); }
+  else
+    { _error((0U == arg->len) ? SHELL_E_MISSING : SHELL_E_DATA_TYPE); }
+}
+
+static void _capture_query(const shell_text_t *arg)
+{
+  sniff_stats_t capture;
+
+  if (0U == _none(arg))
+    { return; }
+
+  sniff_stats(&capture);
+  _reply("%u,%lu,%lu,%lu", capture.enabled,
+      capture.records - _base.capture.records,
+      capture.dropped - _base.capture.dropped,
+      capture.frames - _base.capture.frames);
+}
+
+static void _task_count(const shell_text_t *arg)
+{
+  telemetry_snapshot_t snapshot;
+
+  if (0U == _none(arg))
+    { return; }
+
+  telemetry_snapshot(&snapshot);
+  _reply("%u,%lu", snapshot.count, snapshot.switches);
+}
+
+static void _task_query(const shell_text_t *arg)
+{
+  telemetry_snapshot_t snapshot;
+  const telemetry_task_t *task;
+  uint32_t i;
+
+  telemetry_snapshot(&snapshot);
+  if (0U == _index(arg, snapshot.count, &i))
+    { return; }
+
+  task = &snapshot.task[i];
+  _reply("\"%s\",%u,%u.%u,%u,%lu", task->name, task->priority,
+      task->load / 10U, task->load % 10U, task->stack_free, task->switches);
+}
+
+static void _memory(const shell_text_t *arg)
+{
+  if (0U == _none(arg))
+    { return; }
+
+  _reply("%lu,%lu,%lu", (uint32_t)configTOTAL_HEAP_SIZE,
+      (uint32_t)xPortGetFreeHeapSize(), (uint32_t)xPortGetMinimumEverFreeHeapSize());
+}
+
+static void _deadline_count(const shell_text_t *arg)
+{
+  if (0U == _none(arg))
+    { return; }
+
+  _reply("%lu", deadline_count());
+}
+
+static void _deadline_query(const shell_text_t *arg)
+{
+  deadline_stats_t stats;
+  uint32_t i;
+
+  if (0U == _index(arg, deadline_count(), &i))
+    { return; }
+
+  deadline_stats((deadline_id_t)i, &stats);
+  _reply("\"%s\",%lu,%lu,%lu,%lu,%lu", stats.name, stats.budget_us,
+      stats.count, stats.missed, stats.worst_us, stats.lateness_us);
+  for (uint32_t bin = 0U; bin < DEADLINE_HISTOGRAM_BINS; ++bin)
+    { _reply(",%lu", stats.histogram[bin]); }
+}
+
+static void _isr_count(const shell_text_t *arg)
+{
+  if (0U == _none(arg))
+    { return; }
+
+  _reply("%u,%lu", ISR_PROFILE_COUNT, isr_profile_depth_max());
+}
+
+static void _isr_query(const shell_text_t *arg)
+{
+  isr_profile_stats_t stats;
+  uint32_t i;
+
+  if (0U == _index(arg, ISR_PROFILE_COUNT, &i))
+    { return; }
+
+  isr_profile_stats((isr_profile_id_t)i, &stats);
+  _reply("\"%s\",%lu,%lu,%lu,%lu,%lu,%lu,%u.%u",
+      isr_profile_name((isr_profile_id_t)i), stats.count, stats.nested,
+      stats.min, stats.max, stats.avg, stats.rate,
+      stats.load / 10U, stats.load % 10U);
+}
+
+static void _display_stats(const shell_text_t *arg)
+{
+  screen_stats_t stats;
+
+  if (0U == _none(arg))
+    { return; }
+
+  screen_stats(&stats);
+  _reply("%lu,%lu,%u.%u,%lu,%lu,%lu", stats.frames, stats.events,
+      stats.fps / 10U, stats.fps % 10U,
+      stats.render_last, stats.render_avg, stats.render_max);
+}
+
+static void _display_render(const shell_text_t *arg)
+{
+  render_stats_t stats;
+
+  if (0U == _none(arg))
+    { return; }
+
+  render_stats(&stats);
+  _reply("%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%u.%u,%u.%u",
+      stats.frames, stats.windows, stats.pixels,
+      stats.bytes, stats.bytes_avg, stats.bytes_max,
+      stats.time, stats.time_max, stats.dma, stats.stall,
+      stats.utilisation / 10U, stats.utilisation % 10U,
+      stats.utilisation_avg / 10U, stats.utilisation_avg % 10U);
+}
+
+static void _spi_query(const shell_text_t *arg)
+{
+  spi_bus_stats_t stats;
+  uint32_t i;
+
+  if (0U == _index(arg, SPI_BUS_CLIENT_COUNT, &i))
+    { return; }
+
+  spi_bus_stats((spi_bus_client_t)i, &stats);
+  _reply("%s,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu", _spi_name[i],
+      stats.grants, stats.contended, stats.yields, stats.switches,
+      stats.timeouts, stats.wait_last, stats.wait_max, stats.wait_avg,
+      stats.bytes);
+}
+
+static void _pd_timer(const shell_text_t *arg)
+{
+  pd_timer_stats_t stats;
+
+  if (0U == _none(arg))
+    { return; }
+
+  pd_timer_stats(&stats);
+  _reply("%lu,%lu,%lu,%lu,%lu,%ld", stats.ticks, stats.missed, stats.dropped,
+      stats.overruns, stats.latency_max, stats.drift);
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  The DMA lapped the pending input: drop it and start over at the
+  *         newest byte.
+  */
+static void _overrun(uint32_t received)
+{
+  _start = received;
+  _scan  = received;
+
+  taskENTER_CRITICAL();
+  ++_stats.overruns;
+  taskEXIT_CRITICAL();
+
+  _error(SHELL_E_OVERRUN);
+}
+
+/**
+  * @brief  Execute the message between two receive counts and send its
+  *         response, if any.
+  */
+static void _message(uint32_t first, uint32_t last)
+{
+  const uint8_t *buf = uart_rx_buffer();
+  uint32_t offset = first & SHELL_RX_MASK;
+  size_t len = last - first;
+  const char *text;
+
+  if (0U == len)
+    { return; }
+
+  if ((offset + len) <= UART_RX_BUFFER_SIZE)
+    { text = (const char *)&buf[offset]; }
+  else
+  {
+    size_t head = UART_RX_BUFFER_SIZE - offset;
+
+    if (len > SHELL_LINE_MAX)
+    {
+      _error(SHELL_E_TOO_MUCH);
+      return;
+    }
+    memcpy(_line, &buf[offset], head);
+    memcpy(&_line[head], buf, len - head);
+    text = _line;
+  }
+
+  _response_len = 0U;
+
+  for (;;)
+  {
+    const char *end = memchr(text, ';', len);
+    size_t n = (NULL != end) ? (size_t)(end - text) : len;
+
+    _command(text, n);
+    if (NULL == end)
+      { break; }
+    text += n + 1U;
+    len  -= n + 1U;
+  }
+
+  if (0U != _response_len)
+    { _send(); }
+}
+
+/**
+  * @brief  Execute one command: header, optional whitespace, parameter.
+  */
+static void _command(const char *text, size_t len)
+{
+  size_t header = 0U;
+  shell_text_t arg;
+
+  while ((0U != len) && ((' ' == *text) || ('\t' == *text)))
+    { ++text; --len; }
+  while ((0U != len) && ((' ' == text[len - 1U]) || ('\t' == text[len - 1U])))
+    { --len; }
+  if (0U == len)
+    { return; }
+
+  while ((header < len) && (' ' != text[header]) && ('\t' != text[header]))
+    { ++header; }
+
+  arg.text = &text[header];
+  arg.len  = len - header;
+  while ((0U != arg.len) && ((' ' == *arg.text) || ('\t' == *arg.text)))
+    { ++arg.text; --arg.len; }
+
+  _replied = 0U;
+
+  for (size_t i = 0U; i < (sizeof(_commands) / sizeof(_commands[0])); ++i)
+  {
+    if (0U != _match(_commands[i].header, text, header))
+    {
+      taskENTER_CRITICAL();
+      ++_stats.commands;
+      taskEXIT_CRITICAL();
+
+      _commands[i].handler(&arg);
+      return;
+    }
+  }
+
+  _error(SHELL_E_HEADER);
+}
+
+/**
+  * @brief  Whether a header matches a command pattern: each keyword in its
+  *         short or long form, the same number of keywords and the same
+  *         query mark. A leading ':' is ignored.
+  */
+static uint8_t _match(const char *pattern, const char *header, size_t len)
+{
+  if ((0U != len) && (':' == *header))
+    { ++header; --len; }
+
+  for (;;)
+  {
+    size_t full = 0U;
+    size_t brief = 0U;
+    size_t n = 0U;
+
+    // the short form is the leading run of non-lower case characters
+    while (('\0' != pattern[full]) && (':' != pattern[full]) && ('?' != pattern[full]))
+    {
+      if ((brief == full) && ((pattern[full] < 'a') || (pattern[full] > 'z')))
+        { ++brief; }
+      ++full;
+    }
+    while ((n < len) && (':' != header[n]) && ('?' != header[n]))
+      { ++n; }
+
+    if (((n != full) && (n != brief)) || (0U == _equal(pattern, header, n)))
+      { return 0U; }
+
+    pattern += full;
+    header  += n;
+    len     -= n;
+
+    if (':' != *pattern)
+      { break; }
+    if ((0U == len) || (':' != *header))
+      { return 0U; }
+    ++pattern;
+    ++header;
+    --len;
+  }
+
+  // what is left is the query mark or nothing, on both sides
+  return (strlen(pattern) == len) && (0 == strncmp(pattern, header, len));
+}
+
+/**
+  * @brief  Case-insensitive comparison of ASCII text.
+  */
+static uint8_t _equal(const char *a, const char *b, size_t len)
+{
+  for (size_t i = 0U; i < len; ++i)
+  {
+    char x = (('a' <= a[i]) && (a[i] <= 'z')) ? (char)(a[i] - 'a' + 'A') : a[i];
+    char y = (('a' <= b[i]) && (b[i] <= 'z')) ? (char)(b[i] - 'a' + 'A') : b[i];
+    if (x != y)
+      { return 0U; }
+  }
+  return 1U;
+}
+
+/**
+  * @brief  Check that a command came without a parameter.
+  */
+static uint8_t _none(const shell_text_t *arg)
+{
+  if (0U == arg->len)
+    { return 1U; }
+
+  _error(SHELL_E_NOT_ALLOWED);
+  return 0U;
+}
+
+/**
+  * @brief  Parse a decimal parameter into thousandths, [+-]digits[.digits],
+  *         followed by an optional unit suffix. Digits past the third
+  *         decimal are ignored.
+  */
+static uint8_t _number(const shell_text_t *arg, int32_t *milli, shell_text_t *suffix)
+{
+  const char *p = arg->text;
+  const char *end = arg->text + arg->len;
+  uint8_t negative = 0U;
+  uint8_t digits = 0U;
+  int32_t value = 0;
+  int32_t scale = 1000;
+
+  if (0U == arg->len)
+  {
+    _error(SHELL_E_MISSING);
+    return 0U;
+  }
+
+  if (('+' == *p) || ('-' == *p))
+    { negative = ('-' == *p++); }
+
+  for (; (p < end) && ('0' <= *p) && (*p <= '9'); ++p, ++digits)
+  {
+    if (value > (INT32_MAX / 10) / 1000)
+    {
+      _error(SHELL_E_RANGE);
+      return 0U;
+    }
+    value = (value * 10) + (*p - '0');
+  }
+  value *= 1000;
+
+  if ((p < end) && ('.' == *p))
+  {
+    for (++p; (p < end) && ('0' <= *p) && (*p <= '9'); ++p, ++digits)
+    {
+      if (scale > 1)
+      {
+        scale /= 10;
+        value += (*p - '0') * scale;
+      }
+    }
+  }
+
+  if (0U == digits)
+  {
+    _error(SHELL_E_DATA_TYPE);
+    return 0U;
+  }
+
+  while ((p < end) && ((' ' == *p) || ('\t' == *p)))
+    { ++p; }
+
+  suffix->text = p;
+  suffix->len  = (size_t)(end - p);
+  *milli = (0U != negative) ? -value : value;
+  return 1U;
+}
+
+/**
+  * @brief  Parse an unsigned decimal integer parameter.
+  */
+static uint8_t _integer(const shell_text_t *arg, uint32_t *value)
+{
+  *value = 0U;
+
+  if (0U == arg->len)
+  {
+    _error(SHELL_E_MISSING);
+    return 0U;
+  }
+
+  for (size_t i = 0U; i < arg->len; ++i)
+  {
+    char c = arg->text[i];
+
+    if ((c < '0') || (c > '9'))
+    {
+      _error(SHELL_E_DATA_TYPE);
+      return 0U;
+    }
+    if (*value > (UINT32_MAX - 9U) / 10U)
+    {
+      _error(SHELL_E_RANGE);
+      return 0U;
+    }
+    *value = (*value * 10U) + (uint32_t)(c - '0');
+  }
+
+  return 1U;
+}
+
+/**
+  * @brief  Parse the number of an item, from 1 to count, into its index.
+  */
+static uint8_t _index(const shell_text_t *arg, uint32_t count, uint32_t *index)
+{
+  uint32_t n;
+
+  if (0U == _integer(arg, &n))
+    { return 0U; }
+
+  if ((0U == n) || (n > count))
+  {
+    _error(SHELL_E_RANGE);
+    return 0U;
+  }
+
+  *index = n - 1U;
+  return 1U;
+}
+
+/**
+  * @brief  Check that a source is attached.
+  */
+static uint8_t _connected(void)
+{
+  if (0U != DPM_Ports[SHELL_PORT].DPM_IsConnected)
+    { return 1U; }
+
+  _error(SHELL_E_NO_SOURCE);
+  return 0U;
+}
+
+/**
+  * @brief  Append to the response. The first text of each command is
+  *         separated from the previous command's response by ';'.
+  */
+static void _reply(const char *format, ...)
+{
+  // one byte is kept for the newline
+  size_t room = SHELL_REPLY_MAX - 1U - _response_len;
+  va_list args;
+  int len;
+
+  // already truncated, the error is queued
+  if (0U == room)
+    { return; }
+
+  if ((0U == _replied) && (0U != _response_len) && (room > 0U))
+  {
+    _response[_response_len++] = ';';
+    --room;
+  }
+  _replied = 1U;
+
+  va_start(args, format);
+  len = vsnprintf(&_response[_response_len], room + 1U, format, args);
+  va_end(args);
+
+  if (len < 0)
+    { return; }
+  if ((size_t)len > room)
+  {
+    _response_len = SHELL_REPLY_MAX - 1U;
+    _error(SHELL_E_TOO_MUCH);
+    return;
+  }
+  _response_len += (size_t)len;
+}
+
+/**
+  * @brief  Append a value in thousandths as a decimal number.
+  */
+static void _reply_milli(const char *separator, int32_t milli)
+{
+  uint32_t magnitude = (milli < 0) ? (0U - (uint32_t)milli) : (uint32_t)milli;
+
+  _reply("%s%s%lu.%03lu", separator, (milli < 0) ? "-" : "",
+      magnitude / 1000U, magnitude % 1000U);
+}
+
+/**
+  * @brief  Terminate the response and send it in as many frames as needed,
+  *         waiting for room so that a burst of output does not drop it.
+  */
+static void _send(void)
+{
+  _response[_response_len++] = '\n';
+
+  for (size_t offset = 0U; offset < _response_len; )
+  {
+    size_t n = _response_len - offset;
+    if (n > LINK_BODY_MAX)
+      { n = LINK_BODY_MAX; }
+
+    for (uint32_t ms = 0U; (ms < SHELL_SEND_WAIT_MS) &&
+        ((UART_TX_BUFFER_SIZE - uart_tx_pending()) < LINK_FRAME_MAX); ++ms)
+      { osDelay(1U); }
+
+    (void)link_send(LINK_CH_RESPONSE, LINK_TYPE_RESPONSE, &_response[offset], n);
+    offset += n;
+  }
+
+  _response_len = 0U;
+}
+
+/**
+  * @brief  Queue an error for SYSTem:ERRor?. A full queue keeps its oldest
+  *         errors and replaces the newest with a queue overflow.
+  */
+static void _error(int16_t code)
+{
+  if (_queued < SHELL_ERROR_QUEUE)
+    { _queue[_queued++] = code; }
+  else
+    { _queue[SHELL_ERROR_QUEUE - 1U] = SHELL_E_OVERFLOW; }
+
+  taskENTER_CRITICAL();
+  ++_stats.errors;
+  taskEXIT_CRITICAL();
+}
+
+static const char *_error_message(int16_t code)
+{
+  switch (code)
+  {
+    case SHELL_E_NONE:        return "No error";
+    case SHELL_E_DATA_TYPE:   return "Data type error";
+    case SHELL_E_NOT_ALLOWED: return "Parameter not allowed";
+    case SHELL_E_MISSING:     return "Missing parameter";
+    case SHELL_E_HEADER:      return "Undefined header";
+    case SHELL_E_SUFFIX:      return "Invalid suffix";
+    case SHELL_E_EXECUTION:   return "Execution error";
+    case SHELL_E_CONFLICT:    return "Settings conflict";
+    case SHELL_E_RANGE:       return "Data out of range";
+    case SHELL_E_TOO_MUCH:    return "Too much data";
+    case SHELL_E_NO_SOURCE:   return "Hardware missing";
+    case SHELL_E_OVERFLOW:    return "Queue overflow";
+    case SHELL_E_OVERRUN:     return "Input buffer overrun";
+    default:                  return "?";
+  }
+}
+
+/**
+  * @brief  Remember the counters SYSTem:STATistics? reports relative to.
+  */
+static void _baseline(void)
+{
+  uart_tx_stats(&_base.tx);
+  uart_rx_stats(&_base.rx);
+  link_stats(&_base.link);
+  pd_trace_stats(&_base.trace);
+  sniff_stats(&_base.capture);
+  _base.received = uart_rx_received(NULL);
+}
@@ -0,0 +1,268 @@
+/**
+  ******************************************************************************
+  * @file           : sniff.c
+  * @brief          : USB-PD message capture on the UCPD port.
+  ******************************************************************************
+  * @attention
+  *
+  * Single producer, single consumer: only the UCPD handler moves _head and
+  * only sniff_flush() moves _tail, so the ring needs no compare-and-swap.
+  *
+  * Both DMA channels are reloaded from the start of their buffer for each
+  * message (CMAR never moves), so the message is found at CMAR with the
+  * size in the payload size registers until the stack handles the event.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+
+#include "main.h"
+#include "stm32g4xx_ll_dma.h"
+#include "stm32g4xx_ll_ucpd.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "cycles.h"
+#include "link.h"
+#include "sniff.h"
+
+/* Private define ------------------------------------------------------------*/
+
+#if (SNIFF_RING_SIZE & (SNIFF_RING_SIZE - 1U))
+#error "SNIFF_RING_SIZE must be a power of two"
+#endif
+
+#define SNIFF_MASK            (SNIFF_RING_SIZE - 1U)
+
+// frame: tick u32, cycles u32, MHz u8, dropped u16
+#define SNIFF_FRAME_HEADER    11U
+// record: cycles u32, info u8, size u16, data
+#define SNIFF_RECORD_HEADER   7U
+
+#if (SNIFF_FRAME_HEADER + SNIFF_RECORD_HEADER + SNIFF_DATA_MAX) > LINK_BODY_MAX
+#error "a record does not fit in LINK_BODY_MAX"
+#endif
+
+#define SNIFF_TX_EVENTS       (UCPD_SR_TXMSGSENT | UCPD_SR_TXMSGDISC | UCPD_SR_TXMSGABT)
+#define SNIFF_HRST_EVENTS     (UCPD_SR_HRSTSENT | UCPD_SR_HRSTDISC)
+
+/* Private typedef -----------------------------------------------------------*/
+
+typedef struct
+{
+  uint32_t cycles;
+  uint8_t info;
+  uint16_t size;          // message size on the wire, CRC excluded
+  uint8_t data[SNIFF_DATA_MAX];
+}
+sniff_slot_t;
+
+/* Private variables ---------------------------------------------------------*/
+
+static sniff_slot_t _ring[SNIFF_RING_SIZE];
+
+static uint32_t _head;           // next slot to fill, UCPD handler only
+static uint32_t _tail;           // next slot to send, sniff_flush() only
+static uint32_t _dropped;
+static uint32_t _reported;       // of the drops, sent in a frame header
+static uint32_t _frames;
+
+static uint8_t _enabled = SNIFF_DEFAULT;
+
+/* Private function prototypes -----------------------------------------------*/
+
+static void _record(uint32_t cycles, uint8_t info, uint32_t channel, uint32_t size);
+static uint8_t _tx_sop(uint32_t ordset);
+static size_t _begin(uint8_t *body);
+static void _send(uint8_t *body, size_t len);
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Start or stop capturing. Records already captured are still sent.
+  * @param  enable: 0 to stop
+  * @retval None
+  */
+void sniff_enable(uint8_t enable)
+{
+  __atomic_store_n(&_enabled, (uint8_t)(0U != enable), __ATOMIC_RELAXED);
+}
+
+/**
+  * @brief  Capture the messages the pending UCPD events are about. Call
+  *         from UCPD1_IRQHandler() before the stack's handler clears them.
+  * @retval None
+  */
+void sniff_ucpd_isr(void)
+{
+  uint32_t sr = UCPD1->SR & UCPD1->IMR;
+  uint32_t now;
+
+  if ((0U == __atomic_load_n(&_enabled, __ATOMIC_RELAXED)) ||
+      (0U == (sr & (SNIFF_TX_EVENTS | SNIFF_HRST_EVENTS | UCPD_SR_RXMSGEND | UCPD_SR_RXHRSTDET))))
+    { return; }
+
+  now = cycles_now();
+
+  // a reply is only received once the transmission ended, so sent first
+  if (0U != (sr & SNIFF_TX_EVENTS))
+  {
+    uint8_t result = (0U != (sr & UCPD_SR_TXMSGSENT)) ? SNIFF_OK :
+        (0U != (sr & UCPD_SR_TXMSGDISC)) ? SNIFF_DISCARDED : SNIFF_ABORTED;
+
+    _record(now, SNIFF_TX | (uint8_t)(result << SNIFF_RESULT_Pos) |
+        _tx_sop(UCPD1->TX_ORDSET & UCPD_TX_ORDSET_TXORDSET),
+        LL_DMA_CHANNEL_2, UCPD1->TX_PAYSZ & UCPD_TX_PAYSZ_TXPAYSZ);
+  }
+  if (0U != (sr & SNIFF_HRST_EVENTS))
+  {
+    uint8_t result = (0U != (sr & UCPD_SR_HRSTSENT)) ? SNIFF_OK : SNIFF_DISCARDED;
+
+    _record(now, SNIFF_TX | (uint8_t)(result << SNIFF_RESULT_Pos) | SNIFF_HARD_RESET, 0U, 0U);
+  }
+
+  if (0U != (sr & UCPD_SR_RXMSGEND))
+  {
+    uint8_t result = (0U != (sr & UCPD_SR_RXERR)) ? SNIFF_CRC : SNIFF_OK;
+
+    _record(now, (uint8_t)(result << SNIFF_RESULT_Pos) |
+        (uint8_t)(UCPD1->RX_ORDSET & UCPD_RX_ORDSET_RXORDSET),
+        LL_DMA_CHANNEL_1, UCPD1->RX_PAYSZ & UCPD_RX_PAYSZ_RXPAYSZ);
+  }
+  if (0U != (sr & UCPD_SR_RXHRSTDET))
+    { _record(now, SNIFF_HARD_RESET, 0U, 0U); }
+}
+
+/**
+  * @brief  Send every captured message, packed into as few frames as they
+  *         fit in. Call periodically from one task only.
+  * @retval None
+  */
+void sniff_flush(void)
+{
+  uint8_t body[LINK_BODY_MAX];
+  size_t len = 0U;
+  uint32_t head = __atomic_load_n(&_head, __ATOMIC_ACQUIRE);
+
+  while (_tail != head)
+  {
+    sniff_slot_t *slot = &_ring[_tail & SNIFF_MASK];
+    size_t kept = (slot->size > SNIFF_DATA_MAX) ? SNIFF_DATA_MAX : slot->size;
+    size_t size = SNIFF_RECORD_HEADER + kept;
+
+    if ((0U != len) && ((len + size) > sizeof(body)))
+    {
+      _send(body, len);
+      len = 0U;
+    }
+    if (0U == len)
+      { len = _begin(body); }
+
+    link_put32(&body[len], slot->cycles);
+    body[len + 4U] = slot->info;
+    link_put16(&body[len + 5U], slot->size);
+    memcpy(&body[len + SNIFF_RECORD_HEADER], slot->data, kept);
+    len += size;
+
+    __atomic_store_n(&_tail, _tail + 1U, __ATOMIC_RELEASE);
+  }
+
+  // a frame with only the drop count if nothing else told the host
+  if ((0U == len) && (_reported != __atomic_load_n(&_dropped, __ATOMIC_RELAXED)))
+    { len = _begin(body); }
+
+  if (0U != len)
+    { _send(body, len); }
+}
+
+/**
+  * @brief  Copy the capture state and counters.
+  * @param  stats: destination
+  * @retval None
+  */
+void sniff_stats(sniff_stats_t *stats)
+{
+  if (NULL == stats)
+    { return; }
+
+  stats->enabled = __atomic_load_n(&_enabled, __ATOMIC_RELAXED);
+  stats->records = __atomic_load_n(&_head, __ATOMIC_RELAXED);
+  stats->dropped = __atomic_load_n(&_dropped, __ATOMIC_RELAXED);
+  stats->frames  = _frames;
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Copy a message out of a DMA buffer into the ring, or count it as
+  *         dropped if the ring is full.
+  * @param  channel: DMA channel of the buffer, unused if size is 0
+  */
+static void _record(uint32_t cycles, uint8_t info, uint32_t channel, uint32_t size)
+{
+  uint32_t head = _head;
+  sniff_slot_t *slot;
+
+  if ((head - __atomic_load_n(&_tail, __ATOMIC_ACQUIRE)) >= SNIFF_RING_SIZE)
+  {
+    __atomic_fetch_add(&_dropped, 1U, __ATOMIC_RELAXED);
+    return;
+  }
+
+  slot = &_ring[head & SNIFF_MASK];
+  slot->cycles = cycles;
+  slot->info   = info;
+  slot->size   = (uint16_t)size;
+  if (0U != size)
+  {
+    const uint8_t *buf = (const uint8_t *)(uintptr_t)LL_DMA_GetMemoryAddress(DMA1, channel);
+
+    memcpy(slot->data, buf, (size > SNIFF_DATA_MAX) ? SNIFF_DATA_MAX : size);
+  }
+
+  __atomic_store_n(&_head, head + 1U, __ATOMIC_RELEASE);
+}
+
+/**
+  * @brief  SOP type of a transmit ordered set; the receive side reports
+  *         the type itself.
+  */
+static uint8_t _tx_sop(uint32_t ordset)
+{
+  switch (ordset)
+  {
+    case LL_UCPD_ORDERED_SET_SOP:         return SNIFF_SOP;
+    case LL_UCPD_ORDERED_SET_SOP1:        return SNIFF_SOP1;
+    case LL_UCPD_ORDERED_SET_SOP2:        return SNIFF_SOP2;
+    case LL_UCPD_ORDERED_SET_SOP1_DEBUG:  return SNIFF_SOP1_DEBUG;
+    case LL_UCPD_ORDERED_SET_SOP2_DEBUG:  return SNIFF_SOP2_DEBUG;
+    case LL_UCPD_ORDERED_SET_CABLE_RESET: return SNIFF_CABLE_RESET;
+    default:                              return SNIFF_SOP_UNKNOWN;
+  }
+}
+
+/**
+  * @brief  Write a frame header: the time base for the records' cycle
+  *         counts and the messages dropped since the last frame.
+  */
+static size_t _begin(uint8_t *body)
+{
+  uint32_t dropped = __atomic_load_n(&_dropped, __ATOMIC_RELAXED);
+  uint32_t lost = dropped - _reported;
+
+  link_put32(&body[0], xTaskGetTickCount());
+  link_put32(&body[4], cycles_now());
+  body[8] = (uint8_t)(SystemCoreClock / 1000000U);
+  link_put16(&body[9], (uint16_t)((lost > 0xFFFFU) ? 0xFFFFU : lost));
+  _reported += (lost > 0xFFFFU) ? 0xFFFFU : lost;
+
+  return SNIFF_FRAME_HEADER;
+}
+
+static void _send(uint8_t *body, size_t len)
+{
+  (void)link_send(LINK_CH_EVENT, LINK_TYPE_CAPTURE, body, len);
+  ++_frames;
+}
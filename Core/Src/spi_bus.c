@@ -0,0 +1,358 @@
+/**
+  ******************************************************************************
+  * @file           : spi_bus.c
+  * @brief          : Arbiter for the SPI1 bus shared by the TFT and the touch
+  *                   controller.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "spi.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "cmsis_os.h"
+
+#include "cycles.h"
+#include "spi_bus.h"
+
+/* Private define ------------------------------------------------------------*/
+
+#define SPI_BUS_MODE_MASK   (SPI_CR1_BR | SPI_CR1_CPOL | SPI_CR1_CPHA)
+
+#define SPI_BUS_BIT(c)      (1U << (uint32_t)(c))
+
+/* Private typedef -----------------------------------------------------------*/
+
+typedef struct
+{
+  GPIO_TypeDef *cs_port;
+  uint16_t cs_pin;
+  uint32_t prescaler;     // SPI_BAUDRATEPRESCALER_*
+  uint32_t polarity;      // SPI_POLARITY_*
+  uint32_t phase;         // SPI_PHASE_*
+}
+spi_bus_device_t;
+
+/* Private variables ---------------------------------------------------------*/
+
+// SPI1 runs from PCLK2 = 170 MHz
+static const spi_bus_device_t _device[SPI_BUS_CLIENT_COUNT] =
+{
+  // XPT2046: 2.5 MHz at most, 1.33 MHz
+  [SPI_BUS_TOUCH] = { TOUCH_CS_GPIO_Port, TOUCH_CS_Pin,
+      SPI_BAUDRATEPRESCALER_128, SPI_POLARITY_LOW, SPI_PHASE_1EDGE },
+  // ILI9341 writes: 21.25 MHz
+  [SPI_BUS_TFT]   = { TFT_CS_GPIO_Port, TFT_CS_Pin,
+      SPI_BAUDRATEPRESCALER_8, SPI_POLARITY_LOW, SPI_PHASE_1EDGE },
+};
+
+static osSemaphoreId _grant[SPI_BUS_CLIENT_COUNT];
+static volatile spi_bus_client_t _owner = SPI_BUS_NONE;
+static volatile uint32_t _waiting;    // SPI_BUS_BIT of each queued client
+
+static osSemaphoreId _done;
+static volatile uint8_t _busy;
+static volatile HAL_StatusTypeDef _status;
+
+static spi_bus_stats_t _stats[SPI_BUS_CLIENT_COUNT];
+static uint64_t _wait_total[SPI_BUS_CLIENT_COUNT];
+
+/* Private function prototypes -----------------------------------------------*/
+
+static void _select(spi_bus_client_t client);
+static uint8_t _rtos(void);
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Create the grant and DMA completion semaphores and deselect every
+  *         device. Call from MX_FREERTOS_Init().
+  * @retval None
+  */
+void spi_bus_init(void)
+{
+  osSemaphoreDef(spiBusGrant);
+  osSemaphoreDef(spiBusDone);
+
+  // binary semaphores are created available
+  for (uint32_t i = 0U; i < SPI_BUS_CLIENT_COUNT; ++i)
+  {
+    _grant[i] = osSemaphoreCreate(osSemaphore(spiBusGrant), 1);
+    if (NULL != _grant[i])
+      { (void)osSemaphoreWait(_grant[i], 0U); }
+    HAL_GPIO_WritePin(_device[i].cs_port, _device[i].cs_pin, GPIO_PIN_SET);
+  }
+
+  _done = osSemaphoreCreate(osSemaphore(spiBusDone), 1);
+  if (NULL != _done)
+    { (void)osSemaphoreWait(_done, 0U); }
+}
+
+/**
+  * @brief  Wait for the bus, then switch it to the client's clock settings
+  *         and select the device. Not for ISRs.
+  * @param  client: requesting device, must not own the bus already
+  * @param  timeout: in ms, osWaitForever to block
+  * @retval HAL_OK once owned, HAL_TIMEOUT if not granted in time
+  */
+HAL_StatusTypeDef spi_bus_acquire(spi_bus_client_t client, uint32_t timeout)
+{
+  uint8_t queued = 0U;
+  uint32_t start;
+
+  if (client >= SPI_BUS_CLIENT_COUNT)
+    { return HAL_ERROR; }
+
+  if (!_rtos())
+  {
+    // single context, nobody to wait for
+    _owner = client;
+    _select(client);
+    ++_stats[client].grants;
+    return HAL_OK;
+  }
+
+  start = cycles_now();
+
+  taskENTER_CRITICAL();
+  if (SPI_BUS_NONE == _owner)
+    { _owner = client; }
+  else
+  {
+    _waiting |= SPI_BUS_BIT(client);
+    queued = 1U;
+  }
+  taskEXIT_CRITICAL();
+
+  if (0U != queued)
+  {
+    if (osOK != osSemaphoreWait(_grant[client], timeout))
+    {
+      uint8_t granted;
+
+      // the grant may have raced with the timeout
+      taskENTER_CRITICAL();
+      granted = (client == _owner);
+      if (0U == granted)
+      {
+        _waiting &= ~SPI_BUS_BIT(client);
+        ++_stats[client].timeouts;
+      }
+      taskEXIT_CRITICAL();
+
+      if (0U == granted)
+        { return HAL_TIMEOUT; }
+
+      // consume the release that comes with the grant
+      (void)osSemaphoreWait(_grant[client], osWaitForever);
+    }
+  }
+
+  _select(client);
+
+  uint32_t wait = cycles_to_us(cycles_since(start));
+
+  taskENTER_CRITICAL();
+  spi_bus_stats_t *s = &_stats[client];
+  ++s->grants;
+  if (0U != queued)
+  {
+    ++s->contended;
+    _wait_total[client] += wait;
+    s->wait_last = wait;
+    s->wait_avg  = (uint32_t)(_wait_total[client] / s->contended);
+    if (wait > s->wait_max)
+      { s->wait_max = wait; }
+  }
+  taskEXIT_CRITICAL();
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Deselect the device and hand the bus to the highest-priority
+  *         client waiting for it, if any.
+  * @param  client: current owner
+  * @retval None
+  */
+void spi_bus_release(spi_bus_client_t client)
+{
+  spi_bus_client_t next = SPI_BUS_NONE;
+
+  if ((client >= SPI_BUS_CLIENT_COUNT) || (client != _owner))
+    { return; }
+
+  HAL_GPIO_WritePin(_device[client].cs_port, _device[client].cs_pin, GPIO_PIN_SET);
+
+  if (!_rtos())
+  {
+    _owner = SPI_BUS_NONE;
+    return;
+  }
+
+  taskENTER_CRITICAL();
+  for (uint32_t i = 0U; i < SPI_BUS_CLIENT_COUNT; ++i)
+  {
+    if (0U != (_waiting & SPI_BUS_BIT(i)))
+    {
+      next = (spi_bus_client_t)i;
+      _waiting &= ~SPI_BUS_BIT(i);
+      break;
+    }
+  }
+  _owner = next;
+  taskEXIT_CRITICAL();
+
+  if (SPI_BUS_NONE != next)
+    { (void)osSemaphoreRelease(_grant[next]); }
+}
+
+/**
+  * @brief  Whether a client of higher priority is waiting for the bus.
+  * @param  client: current owner
+  * @retval 1 if the owner should yield
+  */
+uint8_t spi_bus_contended(spi_bus_client_t client)
+{
+  return (0U != (_waiting & (SPI_BUS_BIT(client) - 1U)));
+}
+
+/**
+  * @brief  Hand the bus over to a waiting higher-priority client and take it
+  *         back afterwards. Call with no transfer in flight; the device is
+  *         deselected in between, so any open device state (like a memory
+  *         write window) must be assumed lost when 1 is returned.
+  * @param  client: current owner
+  * @retval 1 if the bus was handed over
+  */
+uint8_t spi_bus_yield(spi_bus_client_t client)
+{
+  if ((client != _owner) || (0U == spi_bus_contended(client)))
+    { return 0U; }
+
+  taskENTER_CRITICAL();
+  ++_stats[client].yields;
+  taskEXIT_CRITICAL();
+
+  spi_bus_release(client);
+  (void)spi_bus_acquire(client, osWaitForever);
+
+  return 1U;
+}
+
+/**
+  * @brief  Exchange bytes with the selected device. Write-only transfers of
+  *         SPI_BUS_DMA_MIN bytes or more go by DMA, the calling task blocks
+  *         until completion; everything else is polled.
+  * @param  client: current owner
+  * @param  tx: bytes to send, NULL for a read (the HAL clocks out rx)
+  * @param  rx: destination of the bytes received, NULL to discard them
+  * @param  size: bytes
+  * @retval HAL status
+  */
+HAL_StatusTypeDef spi_bus_transfer(spi_bus_client_t client,
+    const uint8_t *tx, uint8_t *rx, uint16_t size)
+{
+  HAL_StatusTypeDef status;
+
+  if ((client != _owner) || ((NULL == tx) && (NULL == rx)))
+    { return HAL_ERROR; }
+
+  if (0U == size)
+    { return HAL_OK; }
+
+  if (NULL == rx)
+  {
+    if ((size >= SPI_BUS_DMA_MIN) && _rtos())
+    {
+      _status = HAL_OK;
+      _busy = 1U;
+      status = HAL_SPI_Transmit_DMA(&hspi1, (uint8_t *)tx, size);
+      if (HAL_OK == status)
+      {
+        if (osOK != osSemaphoreWait(_done, SPI_BUS_TIMEOUT_MS))
+          { status = HAL_TIMEOUT; }
+        else
+          { status = _status; }
+      }
+      _busy = 0U;
+    }
+    else
+      { status = HAL_SPI_Transmit(&hspi1, (uint8_t *)tx, size, SPI_BUS_TIMEOUT_MS); }
+  }
+  else if (NULL == tx)
+    { status = HAL_SPI_Receive(&hspi1, rx, size, SPI_BUS_TIMEOUT_MS); }
+  else
+    { status = HAL_SPI_TransmitReceive(&hspi1, (uint8_t *)tx, rx, size, SPI_BUS_TIMEOUT_MS); }
+
+  taskENTER_CRITICAL();
+  _stats[client].bytes += size;
+  taskEXIT_CRITICAL();
+
+  return status;
+}
+
+/**
+  * @brief  DMA completion (or error) hook, called from the SPI1 HAL callbacks.
+  * @param  status: HAL_OK on completion
+  * @retval None
+  */
+void spi_bus_transfer_complete(HAL_StatusTypeDef status)
+{
+  // not ours, the display streams pixels through its own path
+  if (0U == _busy)
+    { return; }
+
+  _status = status;
+  _busy = 0U;
+  (void)osSemaphoreRelease(_done);
+}
+
+/**
+  * @brief  Copy the counters of one client.
+  * @param  client: device
+  * @param  stats: destination
+  * @retval None
+  */
+void spi_bus_stats(spi_bus_client_t client, spi_bus_stats_t *stats)
+{
+  if ((client >= SPI_BUS_CLIENT_COUNT) || (NULL == stats))
+    { return; }
+
+  taskENTER_CRITICAL();
+  *stats = _stats[client];
+  taskEXIT_CRITICAL();
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Switch SPI1 to the client's clock and select its device. The
+  *         registers are compared rather than a cached value, since the
+  *         ili9341 library also reconfigures hspi1.
+  */
+static void _select(spi_bus_client_t client)
+{
+  const spi_bus_device_t *d = &_device[client];
+  uint32_t mode = d->prescaler | d->polarity | d->phase;
+
+  if ((hspi1.Instance->CR1 & SPI_BUS_MODE_MASK) != mode)
+  {
+    // the HAL enables the peripheral again on the next transfer
+    __HAL_SPI_DISABLE(&hspi1);
+    MODIFY_REG(hspi1.Instance->CR1, SPI_BUS_MODE_MASK, mode);
+    hspi1.Init.BaudRatePrescaler = d->prescaler;
+    hspi1.Init.CLKPolarity = d->polarity;
+    hspi1.Init.CLKPhase = d->phase;
+
+    ++_stats[client].switches;
+  }
+
+  HAL_GPIO_WritePin(d->cs_port, d->cs_pin, GPIO_PIN_RESET);
+}
+
+static uint8_t _rtos(void)
+{
+  return (NULL != _done) && (taskSCHEDULER_RUNNING == xTaskGetSchedulerState());
+}
@@ -27,9 +27,11 @@
 /* USER CODE BEGIN Includes */
 //#include "usbpd_dpm_core.h"
 #include "usbpd_hw_if.h"
-#if defined(_TRACE)
-#include "tracer_emb.h"
-#endif
+#include "isr_profile.h"
+#include "pd_timer.h"
+#include "sniff.h"
+#include "uart_rx.h"
+#include "uart_tx.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -174,11 +176,11 @@ void DebugMon_Handler(void)
 void DMA1_Channel1_IRQHandler(void)
 {
   /* USER CODE BEGIN DMA1_Channel1_IRQn 0 */
-
+  ISR_PROFILE_ENTER(ISR_PROFILE_DMA1_CH1);
   /* USER CODE END DMA1_Channel1_IRQn 0 */
 
   /* USER CODE BEGIN DMA1_Channel1_IRQn 1 */
-
+  ISR_PROFILE_EXIT(ISR_PROFILE_DMA1_CH1);
   /* USER CODE END DMA1_Channel1_IRQn 1 */
 }
 
@@ -188,53 +190,97 @@ void DMA1_Channel1_IRQHandler(void)
 void DMA1_Channel2_IRQHandler(void)
 {
   /* USER CODE BEGIN DMA1_Channel2_IRQn 0 */
-
+  ISR_PROFILE_ENTER(ISR_PROFILE_DMA1_CH2);
   /* USER CODE END DMA1_Channel2_IRQn 0 */
 
   /* USER CODE BEGIN DMA1_Channel2_IRQn 1 */
-
+  ISR_PROFILE_EXIT(ISR_PROFILE_DMA1_CH2);
   /* USER CODE END DMA1_Channel2_IRQn 1 */
 }
 
+/**
+  * @brief This function handles DMA1 channel3 global interrupt.
+  */
+void DMA1_Channel3_IRQHandler(void)
+{
+  /* USER CODE BEGIN DMA1_Channel3_IRQn 0 */
+  ISR_PROFILE_ENTER(ISR_PROFILE_DMA1_CH3);
+  uart_tx_isr();
+  /* USER CODE END DMA1_Channel3_IRQn 0 */
+
+  /* USER CODE BEGIN DMA1_Channel3_IRQn 1 */
+  ISR_PROFILE_EXIT(ISR_PROFILE_DMA1_CH3);
+  /* USER CODE END DMA1_Channel3_IRQn 1 */
+}
+
 /**
   * @brief This function handles DMA1 channel4 global interrupt.
   */
 void DMA1_Channel4_IRQHandler(void)
 {
   /* USER CODE BEGIN DMA1_Channel4_IRQn 0 */
-
+  ISR_PROFILE_ENTER(ISR_PROFILE_DMA1_CH4);
   /* USER CODE END DMA1_Channel4_IRQn 0 */
   HAL_DMA_IRQHandler(&hdma_spi1_tx);
   /* USER CODE BEGIN DMA1_Channel4_IRQn 1 */
-
+  ISR_PROFILE_EXIT(ISR_PROFILE_DMA1_CH4);
   /* USER CODE END DMA1_Channel4_IRQn 1 */
 }
 
+/**
+  * @brief This function handles DMA1 channel5 global interrupt.
+  */
+void DMA1_Channel5_IRQHandler(void)
+{
+  /* USER CODE BEGIN DMA1_Channel5_IRQn 0 */
+  ISR_PROFILE_ENTER(ISR_PROFILE_DMA1_CH5);
+  uart_rx_dma_isr();
+  /* USER CODE END DMA1_Channel5_IRQn 0 */
+
+  /* USER CODE BEGIN DMA1_Channel5_IRQn 1 */
+  ISR_PROFILE_EXIT(ISR_PROFILE_DMA1_CH5);
+  /* USER CODE END DMA1_Channel5_IRQn 1 */
+}
+
 /**
   * @brief This function handles SPI1 global interrupt.
   */
 void SPI1_IRQHandler(void)
 {
   /* USER CODE BEGIN SPI1_IRQn 0 */
-
+  ISR_PROFILE_ENTER(ISR_PROFILE_SPI1);
   /* USER CODE END SPI1_IRQn 0 */
   HAL_SPI_IRQHandler(&hspi1);
   /* USER CODE BEGIN SPI1_IRQn 1 */
-
+  ISR_PROFILE_EXIT(ISR_PROFILE_SPI1);
   /* USER CODE END SPI1_IRQn 1 */
 }
 
+/**
+  * @brief This function handles USART2 global interrupt / USART2 wake-up interrupt through EXTI line 26.
+  */
+void USART2_IRQHandler(void)
+{
+  /* USER CODE BEGIN USART2_IRQn 0 */
+  ISR_PROFILE_ENTER(ISR_PROFILE_USART2);
+  uart_rx_isr();
+  /* USER CODE END USART2_IRQn 0 */
+  /* USER CODE BEGIN USART2_IRQn 1 */
+  ISR_PROFILE_EXIT(ISR_PROFILE_USART2);
+  /* USER CODE END USART2_IRQn 1 */
+}
+
 /**
   * @brief This function handles EXTI line[15:10] interrupts.
   */
 void EXTI15_10_IRQHandler(void)
 {
   /* USER CODE BEGIN EXTI15_10_IRQn 0 */
-
+  ISR_PROFILE_ENTER(ISR_PROFILE_EXTI15_10);
   /* USER CODE END EXTI15_10_IRQn 0 */
   HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_10);
   /* USER CODE BEGIN EXTI15_10_IRQn 1 */
-
+  ISR_PROFILE_EXIT(ISR_PROFILE_EXTI15_10);
   /* USER CODE END EXTI15_10_IRQn 1 */
 }
 
@@ -244,24 +290,41 @@ void EXTI15_10_IRQHandler(void)
 void TIM6_DAC_IRQHandler(void)
 {
   /* USER CODE BEGIN TIM6_DAC_IRQn 0 */
-
+  ISR_PROFILE_ENTER(ISR_PROFILE_TIM6);
   /* USER CODE END TIM6_DAC_IRQn 0 */
   HAL_TIM_IRQHandler(&htim6);
   /* USER CODE BEGIN TIM6_DAC_IRQn 1 */
-
+  ISR_PROFILE_EXIT(ISR_PROFILE_TIM6);
   /* USER CODE END TIM6_DAC_IRQn 1 */
 }
 
+/**
+  * @brief This function handles TIM7 global interrupt, DAC2 and DAC4 channel underrun error interrupts.
+  */
+void TIM7_DAC_IRQHandler(void)
+{
+  /* USER CODE BEGIN TIM7_DAC_IRQn 0 */
+  ISR_PROFILE_ENTER(ISR_PROFILE_TIM7);
+  pd_timer_isr();
+  /* USER CODE END TIM7_DAC_IRQn 0 */
+  /* USER CODE BEGIN TIM7_DAC_IRQn 1 */
+  ISR_PROFILE_EXIT(ISR_PROFILE_TIM7);
+  /* USER CODE END TIM7_DAC_IRQn 1 */
+}
+
 /**
   * @brief This function handles UCPD1 interrupt / UCPD1 wake-up interrupt through EXTI line 43.
   */
 void UCPD1_IRQHandler(void)
 {
   /* USER CODE BEGIN UCPD1_IRQn 0 */
+  ISR_PROFILE_ENTER(ISR_PROFILE_UCPD1);
+  // before the stack clears the events and reloads the DMA buffers
+  sniff_ucpd_isr();
   USBPD_PORT0_IRQHandler();
   /* USER CODE END UCPD1_IRQn 0 */
   /* USER CODE BEGIN UCPD1_IRQn 1 */
-
+  ISR_PROFILE_EXIT(ISR_PROFILE_UCPD1);
   /* USER CODE END UCPD1_IRQn 1 */
 }
 
@@ -271,11 +334,11 @@ void UCPD1_IRQHandler(void)
 void I2C3_EV_IRQHandler(void)
 {
   /* USER CODE BEGIN I2C3_EV_IRQn 0 */
-
+  ISR_PROFILE_ENTER(ISR_PROFILE_I2C3_EV);
   /* USER CODE END I2C3_EV_IRQn 0 */
   HAL_I2C_EV_IRQHandler(&hi2c3);
   /* USER CODE BEGIN I2C3_EV_IRQn 1 */
-
+  ISR_PROFILE_EXIT(ISR_PROFILE_I2C3_EV);
   /* USER CODE END I2C3_EV_IRQn 1 */
 }
 
@@ -285,11 +348,11 @@ void I2C3_EV_IRQHandler(void)
 void I2C3_ER_IRQHandler(void)
 {
   /* USER CODE BEGIN I2C3_ER_IRQn 0 */
-
+  ISR_PROFILE_ENTER(ISR_PROFILE_I2C3_ER);
   /* USER CODE END I2C3_ER_IRQn 0 */
   HAL_I2C_ER_IRQHandler(&hi2c3);
   /* USER CODE BEGIN I2C3_ER_IRQn 1 */
-
+  ISR_PROFILE_EXIT(ISR_PROFILE_I2C3_ER);
   /* USER CODE END I2C3_ER_IRQn 1 */
 }
 
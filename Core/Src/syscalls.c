@@ -56,6 +56,8 @@
 #include <sys/time.h>
 #include <sys/times.h>
 
+#include "uart_tx.h"
+
 
 /* Variables */
 //#undef errno
@@ -105,11 +107,12 @@ return len;
 
 __attribute__((weak)) int _write(int file, char *ptr, int len)
 {
-	int DataIdx;
-
-	for (DataIdx = 0; DataIdx < len; DataIdx++)
+	/* Queued on the USART2 DMA ring, never blocks. A write that does not
+	   fit is dropped and counted there, stdio is told it went out. */
+	(void)file;
+	if (len > 0)
 	{
-		__io_putchar(*ptr++);
+		uart_tx_write(ptr, (size_t)len);
 	}
 	return len;
 }
@@ -0,0 +1,251 @@
+/**
+  ******************************************************************************
+  * @file           : telemetry.c
+  * @brief          : Per-task CPU load, stack high-water and context switch
+  *                   snapshots.
+  ******************************************************************************
+  * @attention
+  *
+  * Tasks are picked up automatically the first time they are switched in, so
+  * the PE task (created on attach, terminated on detach) is tracked without
+  * any registration. Each tracked task stores its slot index + 1 in the
+  * kernel's application task number, which keeps the switch hook O(1). The
+  * kernel never initialises that number when it creates a task, so a new TCB
+  * carries whatever heap_4 left there; the hook only trusts a number whose
+  * slot points back at the task.
+  *
+  * Sampling never suspends the scheduler: the kernel fields are copied inside
+  * a short critical section and the stack scan runs outside of it, with a
+  * generation counter to discard tasks deleted in the meantime.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "cycles.h"
+#include "telemetry.h"
+
+/* Private define ------------------------------------------------------------*/
+
+// kernel fills new stacks with this byte (tskSTACK_FILL_BYTE in tasks.c)
+#define TELEMETRY_STACK_FILL  0xA5U
+
+// task number given to tasks that did not fit into the slot table, so the
+// switch hook does not search for a free slot on every switch
+#define TELEMETRY_UNTRACKED   (TELEMETRY_MAX_TASKS + 1U)
+
+/* Private typedef -----------------------------------------------------------*/
+
+typedef struct
+{
+  TaskHandle_t handle;
+  uint32_t     generation;
+  uint32_t     switches;
+  uint32_t     switches_prev;
+  uint32_t     run_time_prev;
+}
+telemetry_slot_t;
+
+/* Private variables ---------------------------------------------------------*/
+
+static telemetry_slot_t _slot[TELEMETRY_MAX_TASKS];
+static uint32_t _tracked;
+static uint32_t _sample_cycles;
+
+static telemetry_snapshot_t _snapshot;
+static telemetry_snapshot_t _scratch;
+
+/* Private function prototypes -----------------------------------------------*/
+
+static uint16_t _stack_free(const StackType_t *base);
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Refresh the published snapshot. Load figures cover the time since
+  *         the previous call. Must only be called from a single task.
+  * @retval None
+  */
+void telemetry_sample(void)
+{
+  uint32_t now = portGET_RUN_TIME_COUNTER_VALUE();
+  uint32_t window = now - _sample_cycles;
+  _sample_cycles = now;
+
+  _scratch.tick     = xTaskGetTickCount();
+  _scratch.window   = window;
+  _scratch.switches = 0U;
+  _scratch.count    = 0U;
+
+  for (uint32_t i = 0U; i < TELEMETRY_MAX_TASKS; ++i)
+  {
+    telemetry_task_t *entry = &_scratch.task[_scratch.count];
+    TaskStatus_t status;
+    TaskHandle_t handle;
+    uint32_t generation = 0U;
+    uint32_t switches = 0U;
+    uint16_t stack_free;
+
+    taskENTER_CRITICAL();
+    handle = _slot[i].handle;
+    if (NULL != handle)
+    {
+      generation = _slot[i].generation;
+      switches   = _slot[i].switches;
+      // eReady avoids the state lookup, which we do not report anyway
+      vTaskGetInfo(handle, &status, pdFALSE, eReady);
+      strncpy(entry->name, status.pcTaskName, configMAX_TASK_NAME_LEN);
+    }
+    taskEXIT_CRITICAL();
+
+    if (NULL == handle)
+      { continue; }
+
+    // the stack memory stays mapped RAM even if the task is deleted while we
+    // scan it, in which case the result is discarded below
+    stack_free = _stack_free(status.pxStackBase);
+
+    taskENTER_CRITICAL();
+    if ((_slot[i].handle == handle) && (_slot[i].generation == generation))
+    {
+      uint32_t run_time = status.ulRunTimeCounter - _slot[i].run_time_prev;
+      uint64_t load = (0U == window) ? 0U : ((uint64_t)run_time * 1000U) / window;
+
+      entry->name[configMAX_TASK_NAME_LEN - 1U] = '\0';
+      entry->priority   = (uint8_t)status.uxCurrentPriority;
+      entry->load       = (uint16_t)((load > 1000U) ? 1000U : load);
+      entry->stack_free = stack_free;
+      entry->switches   = switches;
+      entry->run_time   = status.ulRunTimeCounter;
+
+      _scratch.switches += switches - _slot[i].switches_prev;
+      _slot[i].switches_prev = switches;
+      _slot[i].run_time_prev = status.ulRunTimeCounter;
+
+      ++_scratch.count;
+    }
+    taskEXIT_CRITICAL();
+  }
+
+  taskENTER_CRITICAL();
+  _scratch.sequence = _snapshot.sequence + 1U;
+  _snapshot = _scratch;
+  taskEXIT_CRITICAL();
+}
+
+/**
+  * @brief  Copy the most recent snapshot. Callable from any task.
+  * @param  snapshot: destination
+  * @retval None
+  */
+void telemetry_snapshot(telemetry_snapshot_t *snapshot)
+{
+  if (NULL == snapshot)
+    { return; }
+
+  taskENTER_CRITICAL();
+  *snapshot = _snapshot;
+  taskEXIT_CRITICAL();
+}
+
+/**
+  * @brief  portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() implementation, called by
+  *         the kernel when the scheduler starts.
+  * @retval None
+  */
+void telemetry_configure_timer(void)
+{
+  cycles_init();
+  _sample_cycles = cycles_now();
+}
+
+/**
+  * @brief  traceTASK_SWITCHED_IN() implementation. Runs inside the context
+  *         switch with interrupts masked, keep it short.
+  * @param  task: TCB of the task being switched in
+  * @retval None
+  */
+void telemetry_task_switched_in(void *task)
+{
+  UBaseType_t number = uxTaskGetTaskNumber((TaskHandle_t)task);
+
+  // a slot number is only ours if the slot still holds this task, and an
+  // untracked task gets another chance once a slot has been released
+  if (number <= TELEMETRY_MAX_TASKS)
+  {
+    if ((0U != number) && (_slot[number - 1U].handle != (TaskHandle_t)task))
+      { number = 0U; }
+  }
+  else if ((number > TELEMETRY_UNTRACKED) || (_tracked < TELEMETRY_MAX_TASKS))
+    { number = 0U; }
+
+  if (0U == number)
+  {
+    number = TELEMETRY_UNTRACKED;
+    for (uint32_t i = 0U; i < TELEMETRY_MAX_TASKS; ++i)
+    {
+      if (NULL == _slot[i].handle)
+      {
+        _slot[i].handle        = (TaskHandle_t)task;
+        _slot[i].switches      = 0U;
+        _slot[i].switches_prev = 0U;
+        _slot[i].run_time_prev = 0U;
+        ++_tracked;
+        number = i + 1U;
+        break;
+      }
+    }
+    vTaskSetTaskNumber((TaskHandle_t)task, number);
+  }
+
+  if (number <= TELEMETRY_MAX_TASKS)
+    { ++_slot[number - 1U].switches; }
+}
+
+/**
+  * @brief  traceTASK_DELETE() implementation, releases the task's slot and
+  *         clears its task number, so a TCB reallocated at the same address
+  *         does not inherit it.
+  * @param  task: TCB of the task being deleted
+  * @retval None
+  */
+void telemetry_task_deleted(void *task)
+{
+  UBaseType_t number = uxTaskGetTaskNumber((TaskHandle_t)task);
+
+  if ((number > 0U) && (number <= TELEMETRY_MAX_TASKS) &&
+      (_slot[number - 1U].handle == (TaskHandle_t)task))
+  {
+    _slot[number - 1U].handle = NULL;
+    ++_slot[number - 1U].generation;
+    --_tracked;
+  }
+
+  vTaskSetTaskNumber((TaskHandle_t)task, 0U);
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Count the untouched words at the bottom of a task stack.
+  * @param  base: lowest address of the stack (stacks grow down)
+  * @retval Words never used
+  */
+static uint16_t _stack_free(const StackType_t *base)
+{
+  const uint8_t *byte = (const uint8_t *)base;
+  uint32_t count = 0U;
+
+  while (TELEMETRY_STACK_FILL == *byte)
+  {
+    ++byte;
+    ++count;
+  }
+
+  return (uint16_t)(count / sizeof(StackType_t));
+}
@@ -0,0 +1,391 @@
+/**
+  ******************************************************************************
+  * @file           : tft.c
+  * @brief          : Raw ILI9341 address-window writes over SPI1 with DMA.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "spi.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "cmsis_os.h"
+
+#include "cycles.h"
+#include "spi_bus.h"
+#include "tft.h"
+
+/* Private define ------------------------------------------------------------*/
+
+#define TFT_CMD_CASET     0x2AU   // column address set
+#define TFT_CMD_PASET     0x2BU   // page address set
+#define TFT_CMD_RAMWR     0x2CU   // memory write
+#define TFT_CMD_VSCRDEF   0x33U   // vertical scrolling definition
+#define TFT_CMD_VSCRSADD  0x37U   // vertical scrolling start address
+
+#define TFT_CMD_TIMEOUT_MS  10U
+
+// largest DMA transfer, in frames
+#define TFT_DMA_COUNT_MAX   0xFFFFU
+
+/* External variables --------------------------------------------------------*/
+
+extern DMA_HandleTypeDef hdma_spi1_tx;
+
+/* Private variables ---------------------------------------------------------*/
+
+static osSemaphoreId _done;
+static volatile uint8_t _busy;
+static volatile HAL_StatusTypeDef _status;
+static uint8_t _pending;
+
+static uint32_t _dma_start;
+static volatile uint32_t _dma_cycles;
+
+static uint8_t _wide;
+static tft_color_t _fill_color;
+
+/* Private function prototypes -----------------------------------------------*/
+
+static HAL_StatusTypeDef _command(uint8_t cmd, const uint8_t *arg, uint16_t size);
+static void _frame(uint8_t wide, uint8_t increment);
+static HAL_StatusTypeDef _start(const tft_color_t *src, uint16_t count);
+static HAL_StatusTypeDef _timeout(void);
+static uint8_t _rtos(void);
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Create the DMA completion semaphore. Call from MX_FREERTOS_Init(),
+  *         transfers made before (or without) it are waited for by polling.
+  * @retval None
+  */
+void tft_init(void)
+{
+  osSemaphoreDef(tftDone);
+  _done = osSemaphoreCreate(osSemaphore(tftDone), 1);
+  // binary semaphores are created available
+  if (NULL != _done)
+    { (void)osSemaphoreWait(_done, 0U); }
+}
+
+/**
+  * @brief  Wait for SPI1 and select the panel.
+  * @retval None
+  */
+void tft_begin(void)
+{
+  (void)spi_bus_acquire(SPI_BUS_TFT, osWaitForever);
+}
+
+/**
+  * @brief  Deselect the panel and release SPI1.
+  * @retval None
+  */
+void tft_end(void)
+{
+  // the other clients and the ili9341 library expect 8-bit frames
+  _frame(0U, 1U);
+  spi_bus_release(SPI_BUS_TFT);
+}
+
+/**
+  * @brief  Let a higher-priority SPI1 client (touch) use the bus if one is
+  *         waiting. Call between bands, with no transfer in flight.
+  * @retval 1 if the bus was handed over: the open window is gone and must be
+  *         reopened for the remaining pixels
+  */
+uint8_t tft_yield(void)
+{
+  if ((0U != _pending) || (0U == spi_bus_contended(SPI_BUS_TFT)))
+    { return 0U; }
+
+  _frame(0U, 1U);
+  return spi_bus_yield(SPI_BUS_TFT);
+}
+
+/**
+  * @brief  Open an address window (inclusive corners) and start a memory
+  *         write into it. Pixel data follows with tft_write() or tft_fill().
+  * @retval HAL status
+  */
+HAL_StatusTypeDef tft_window(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1)
+{
+  uint8_t col[4] = { x0 >> 8U, x0 & 0xFFU, x1 >> 8U, x1 & 0xFFU };
+  uint8_t row[4] = { y0 >> 8U, y0 & 0xFFU, y1 >> 8U, y1 & 0xFFU };
+  HAL_StatusTypeDef status;
+
+  _frame(0U, 1U);
+
+  status = _command(TFT_CMD_CASET, col, sizeof(col));
+  if (HAL_OK == status)
+    { status = _command(TFT_CMD_PASET, row, sizeof(row)); }
+  if (HAL_OK == status)
+    { status = _command(TFT_CMD_RAMWR, NULL, 0U); }
+
+  // everything up to the next command is pixel data
+  PIN_SET(TFT_DC);
+
+  return status;
+}
+
+/**
+  * @brief  Stream pixels into the open window by DMA and wait for the
+  *         transfer to complete.
+  * @param  pixels: RGB565, must stay valid until return
+  * @param  count: pixels, at most 65535
+  * @retval HAL status
+  */
+HAL_StatusTypeDef tft_write(const tft_color_t *pixels, uint32_t count)
+{
+  HAL_StatusTypeDef status = tft_write_async(pixels, count);
+
+  if (HAL_OK == status)
+    { status = tft_wait(); }
+
+  return status;
+}
+
+/**
+  * @brief  Start streaming pixels into the open window by DMA, one 16-bit
+  *         SPI frame and one half-word DMA beat per pixel.
+  * @param  pixels: RGB565, must stay untouched until tft_wait() returns
+  * @param  count: pixels, at most 65535
+  * @retval HAL status of the DMA start
+  */
+HAL_StatusTypeDef tft_write_async(const tft_color_t *pixels, uint32_t count)
+{
+  if (count > TFT_DMA_COUNT_MAX)
+    { return HAL_ERROR; }
+
+  _frame(1U, 1U);
+  return _start(pixels, (uint16_t)count);
+}
+
+/**
+  * @brief  Fill the open window with a single colour. DMA reads the colour
+  *         from a fixed address, nothing is expanded in RAM. Returns with the
+  *         last chunk in flight, like tft_write_async().
+  * @param  color: RGB565
+  * @param  count: pixels, any amount
+  * @retval HAL status
+  */
+HAL_StatusTypeDef tft_fill(tft_color_t color, uint32_t count)
+{
+  HAL_StatusTypeDef status = tft_wait();
+
+  _fill_color = color;
+  _frame(1U, 0U);
+
+  while ((HAL_OK == status) && (count > 0U))
+  {
+    uint16_t chunk = (count > TFT_DMA_COUNT_MAX) ? TFT_DMA_COUNT_MAX : (uint16_t)count;
+    count -= chunk;
+
+    status = _start(&_fill_color, chunk);
+    if ((HAL_OK == status) && (count > 0U))
+      { status = tft_wait(); }
+  }
+
+  return status;
+}
+
+/**
+  * @brief  Define the scroll area as the band of screen columns x..x+width-1,
+  *         everything else stays fixed.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef tft_scroll_area(uint16_t x, uint16_t width)
+{
+  uint16_t bottom = TFT_WIDTH - x - width;
+  uint8_t arg[6] =
+  {
+    x >> 8U, x & 0xFFU,
+    width >> 8U, width & 0xFFU,
+    bottom >> 8U, bottom & 0xFFU,
+  };
+  HAL_StatusTypeDef status = tft_wait();
+
+  _frame(0U, 1U);
+  if (HAL_OK == status)
+    { status = _command(TFT_CMD_VSCRDEF, arg, sizeof(arg)); }
+
+  return status;
+}
+
+/**
+  * @brief  Show GRAM column x at the left edge of the scroll area.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef tft_scroll(uint16_t x)
+{
+  uint8_t arg[2] = { x >> 8U, x & 0xFFU };
+  HAL_StatusTypeDef status = tft_wait();
+
+  _frame(0U, 1U);
+  if (HAL_OK == status)
+    { status = _command(TFT_CMD_VSCRSADD, arg, sizeof(arg)); }
+
+  return status;
+}
+
+/**
+  * @brief  Wait for the transfer started by tft_write_async(), if any. The
+  *         calling task blocks, it does not spin.
+  * @retval HAL status of the transfer
+  */
+HAL_StatusTypeDef tft_wait(void)
+{
+  if (0U == _pending)
+    { return HAL_OK; }
+
+  _pending = 0U;
+
+  // the semaphore is taken even when the transfer already completed, so
+  // its release cannot satisfy the next wait
+  if (_rtos())
+  {
+    if (osOK != osSemaphoreWait(_done, TFT_DMA_TIMEOUT_MS))
+      { return _timeout(); }
+  }
+  else
+  {
+    uint32_t start = HAL_GetTick();
+    while (0U != _busy)
+    {
+      if ((HAL_GetTick() - start) > TFT_DMA_TIMEOUT_MS)
+        { return _timeout(); }
+    }
+  }
+
+  return _status;
+}
+
+/**
+  * @brief  Free-running count of CPU cycles during which a pixel DMA transfer
+  *         was in flight. Differences between two reads give bus time.
+  * @retval Cycles, wraps
+  */
+uint32_t tft_busy_cycles(void)
+{
+  return _dma_cycles;
+}
+
+/**
+  * @brief  DMA completion (or error) hook, called from the SPI1 HAL callbacks.
+  * @param  status: HAL_OK on completion
+  * @retval None
+  */
+void tft_transfer_complete(HAL_StatusTypeDef status)
+{
+  if (0U == _busy)
+    { return; }
+
+  _dma_cycles += cycles_since(_dma_start);
+  _status = status;
+  _busy = 0U;
+
+  if (_rtos())
+    { (void)osSemaphoreRelease(_done); }
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Switch SPI1 between 8-bit (commands) and 16-bit (pixels) frames
+  *         and the TX DMA channel to the matching width and source mode.
+  *         Only called with no transfer in flight. A normal-mode transfer
+  *         completes with EN still set, and CCR is read-only while it is,
+  *         so the channel is disabled first; HAL_DMA_Start_IT() enables it
+  *         again.
+  * @param  wide: 16-bit frames and half-word DMA beats
+  * @param  increment: DMA source address increments (0 for fills)
+  */
+static void _frame(uint8_t wide, uint8_t increment)
+{
+  uint32_t mem_inc = (0U != increment) ? DMA_MINC_ENABLE : DMA_MINC_DISABLE;
+
+  __HAL_DMA_DISABLE(&hdma_spi1_tx);
+
+  if (wide != _wide)
+  {
+    uint32_t size = (0U != wide) ? SPI_DATASIZE_16BIT : SPI_DATASIZE_8BIT;
+    uint32_t align = (0U != wide) ?
+        (DMA_PDATAALIGN_HALFWORD | DMA_MDATAALIGN_HALFWORD) :
+        (DMA_PDATAALIGN_BYTE | DMA_MDATAALIGN_BYTE);
+
+    __HAL_SPI_DISABLE(&hspi1);
+    MODIFY_REG(hspi1.Instance->CR2, SPI_CR2_DS | SPI_CR2_FRXTH,
+        size | ((0U != wide) ? 0U : SPI_CR2_FRXTH));
+    hspi1.Init.DataSize = size;
+
+    MODIFY_REG(hdma_spi1_tx.Instance->CCR, DMA_CCR_PSIZE | DMA_CCR_MSIZE, align);
+    hdma_spi1_tx.Init.PeriphDataAlignment = align & DMA_CCR_PSIZE;
+    hdma_spi1_tx.Init.MemDataAlignment    = align & DMA_CCR_MSIZE;
+
+    _wide = wide;
+  }
+
+  if (mem_inc != hdma_spi1_tx.Init.MemInc)
+  {
+    MODIFY_REG(hdma_spi1_tx.Instance->CCR, DMA_CCR_MINC, mem_inc);
+    hdma_spi1_tx.Init.MemInc = mem_inc;
+  }
+}
+
+static HAL_StatusTypeDef _start(const tft_color_t *src, uint16_t count)
+{
+  HAL_StatusTypeDef status;
+
+  if (0U == count)
+    { return HAL_OK; }
+
+  _status = HAL_OK;
+  _busy = 1U;
+  _dma_start = cycles_now();
+  // in 16-bit mode the HAL counts frames, not bytes
+  status = HAL_SPI_Transmit_DMA(&hspi1, (uint8_t *)src, count);
+  if (HAL_OK != status)
+  {
+    _busy = 0U;
+    return status;
+  }
+
+  _pending = 1U;
+  return HAL_OK;
+}
+
+static HAL_StatusTypeDef _command(uint8_t cmd, const uint8_t *arg, uint16_t size)
+{
+  HAL_StatusTypeDef status;
+
+  PIN_CLR(TFT_DC);
+  status = HAL_SPI_Transmit(&hspi1, &cmd, 1U, TFT_CMD_TIMEOUT_MS);
+  if ((HAL_OK == status) && (size > 0U))
+  {
+    PIN_SET(TFT_DC);
+    status = HAL_SPI_Transmit(&hspi1, (uint8_t *)arg, size, TFT_CMD_TIMEOUT_MS);
+  }
+
+  return status;
+}
+
+/**
+  * @brief  Give up on a transfer that did not complete. SPI1 and its DMA
+  *         channel are stopped, otherwise the handle stays busy and every
+  *         later transfer is refused.
+  * @retval HAL_TIMEOUT
+  */
+static HAL_StatusTypeDef _timeout(void)
+{
+  (void)HAL_SPI_Abort(&hspi1);
+  _busy = 0U;
+
+  return HAL_TIMEOUT;
+}
+
+static uint8_t _rtos(void)
+{
+  return (NULL != _done) && (taskSCHEDULER_RUNNING == xTaskGetSchedulerState());
+}
@@ -0,0 +1,417 @@
+/**
+  ******************************************************************************
+  * @file           : touch.c
+  * @brief          : Deferred, filtered XPT2046 touch input run by TouchTask.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "cycles.h"
+#include "spi_bus.h"
+#include "tft.h"
+#include "touch.h"
+
+/* Private define ------------------------------------------------------------*/
+
+#define TOUCH_SIGNAL_IRQ      (1U << 0U)
+
+// 12-bit differential conversions, the low bits select the power-down mode
+#define TOUCH_CMD_X           0xD0U
+#define TOUCH_CMD_Y           0x90U
+#define TOUCH_CMD_Z1          0xB0U
+#define TOUCH_CMD_Z2          0xC0U
+#define TOUCH_PD_ADC_ON       0x01U   // no pen interrupt between conversions
+
+#define TOUCH_RAW_MAX         4095U
+#define TOUCH_IIR_FRAC        4U      // fraction bits of the filter state
+#define TOUCH_RATE_WINDOW     1000U
+
+/* Private variables ---------------------------------------------------------*/
+
+static osThreadId _task;
+static touch_listener_t _listener;
+
+// shared with the pen interrupt
+static volatile uint8_t _armed;
+static volatile uint32_t _irq_cycles;
+
+// owned by the touch task
+static uint8_t _awake;
+static uint32_t _edge;
+static uint32_t _sample_start;
+static uint32_t _sample_tick;
+static uint8_t _pressed;
+static uint8_t _long;
+static uint8_t _held;
+static uint8_t _lifted;
+static uint32_t _down_tick;
+static int32_t _filter_x;
+static int32_t _filter_y;
+static uint16_t _x;
+static uint16_t _y;
+static uint16_t _reported_x;
+static uint16_t _reported_y;
+
+static touch_event_t _queue[TOUCH_QUEUE_SIZE];
+static uint8_t _queue_head;
+static uint8_t _queue_count;
+
+static touch_stats_t _stats;
+static uint64_t _latency_total;
+static uint32_t _presses;
+static uint32_t _rate_tick;
+static uint32_t _rate_samples;
+
+/* Private function prototypes -----------------------------------------------*/
+
+static uint16_t _read(uint8_t cmd, uint8_t *ok);
+static uint16_t _median(uint16_t *v);
+static uint16_t _map(uint16_t raw, int32_t min, int32_t max, uint16_t size);
+static void _update(uint16_t x, uint16_t y);
+static void _push(touch_type_t type);
+static uint8_t _pen_down(void);
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Bind the pipeline to the task that samples the controller.
+  * @param  task: TouchTask handle
+  * @param  listener: called from TouchTask after each queued event, may be NULL
+  * @retval None
+  */
+void touch_init(osThreadId task, touch_listener_t listener)
+{
+  _listener = listener;
+  _task = task;
+}
+
+/**
+  * @brief  Pen interrupt (EXTI) hook. Timestamps the edge and wakes the task,
+  *         edges while the task is already sampling are ignored.
+  * @retval None
+  */
+void touch_irq(void)
+{
+  if ((NULL == _task) || (0U != _armed))
+    { return; }
+
+  _irq_cycles = cycles_now();
+  _armed = 1U;
+  (void)osSignalSet(_task, TOUCH_SIGNAL_IRQ);
+}
+
+/**
+  * @brief  Block until the next sample is due: the next sample period while
+  *         the pen is down, the next pen-down edge otherwise. Call from the
+  *         touch task only.
+  * @retval None
+  */
+void touch_wait(void)
+{
+  if (0U != _awake)
+  {
+    uint32_t elapsed = osKernelSysTick() - _sample_tick;
+    if (elapsed < TOUCH_SAMPLE_MS)
+      { osDelay(TOUCH_SAMPLE_MS - elapsed); }
+    return;
+  }
+
+  for (;;)
+  {
+    // re-arm the interrupt; a pen that went down while the task was still
+    // sampling gave no edge of its own
+    _armed = 0U;
+    if (_pen_down())
+    {
+      _edge = cycles_now();
+      break;
+    }
+
+    osEvent event = osSignalWait(TOUCH_SIGNAL_IRQ, osWaitForever);
+    // the release edge wakes the task too
+    if ((osEventSignal == event.status) && _pen_down())
+    {
+      _edge = _irq_cycles;
+      break;
+    }
+  }
+
+  _awake = 1U;
+  _held = 0U;
+  _lifted = 0U;
+
+  taskENTER_CRITICAL();
+  ++_stats.irqs;
+  taskEXIT_CRITICAL();
+}
+
+/**
+  * @brief  Read the controller once, filter the position and generate the
+  *         events it leads to. Call from the touch task only.
+  * @retval None
+  */
+void touch_sample(void)
+{
+  uint16_t a[TOUCH_MEDIAN];
+  uint16_t b[TOUCH_MEDIAN];
+  uint16_t z1;
+  uint16_t z2;
+  uint8_t ok = 1U;
+  uint32_t start = cycles_now();
+  uint32_t now = osKernelSysTick();
+
+  _sample_tick = now;
+  _sample_start = start;
+
+  // slots in between two display bands at most one band late
+  if (HAL_OK != spi_bus_acquire(SPI_BUS_TOUCH, TOUCH_SAMPLE_MS))
+  {
+    taskENTER_CRITICAL();
+    ++_stats.bus_timeouts;
+    taskEXIT_CRITICAL();
+    return;
+  }
+
+  z1 = _read(TOUCH_CMD_Z1 | TOUCH_PD_ADC_ON, &ok);
+  z2 = _read(TOUCH_CMD_Z2 | TOUCH_PD_ADC_ON, &ok);
+  for (uint32_t i = 0U; i < TOUCH_MEDIAN; ++i)
+    { a[i] = _read(TOUCH_CMD_X | TOUCH_PD_ADC_ON, &ok); }
+  // the last conversion powers down and enables the pen interrupt again
+  for (uint32_t i = 0U; i < TOUCH_MEDIAN; ++i)
+    { b[i] = _read(TOUCH_CMD_Y | ((i + 1U < TOUCH_MEDIAN) ? TOUCH_PD_ADC_ON : 0U), &ok); }
+
+  spi_bus_release(SPI_BUS_TOUCH);
+
+  uint32_t pressure = (0U == z1) ? 0U : (uint32_t)z1 + TOUCH_RAW_MAX - z2;
+  uint8_t valid = (0U != ok) && (pressure >= TOUCH_PRESSURE_MIN);
+
+  taskENTER_CRITICAL();
+  ++_stats.samples;
+  if (0U == valid)
+    { ++_stats.rejected; }
+  _stats.sample_time = cycles_to_us(cycles_since(start));
+  ++_rate_samples;
+  if ((now - _rate_tick) >= TOUCH_RATE_WINDOW)
+  {
+    _stats.rate = (uint16_t)((_rate_samples * 1000U) / (now - _rate_tick));
+    _rate_tick = now;
+    _rate_samples = 0U;
+  }
+  taskEXIT_CRITICAL();
+
+  if (0U != valid)
+  {
+    _lifted = 0U;
+    _update(_map(_median(b), TOUCH_RAW_X_MIN, TOUCH_RAW_X_MAX, TFT_WIDTH),
+        _map(_median(a), TOUCH_RAW_Y_MIN, TOUCH_RAW_Y_MAX, TFT_HEIGHT));
+
+    if (0U == _pressed)
+    {
+      if (++_held >= TOUCH_PRESS_SAMPLES)
+      {
+        _pressed = 1U;
+        _long = 0U;
+        _down_tick = now;
+        _push(TOUCH_PRESS);
+      }
+    }
+    else
+    {
+      int32_t dx = (int32_t)_x - _reported_x;
+      int32_t dy = (int32_t)_y - _reported_y;
+
+      if ((dx >= (int32_t)TOUCH_DRAG_MIN) || (-dx >= (int32_t)TOUCH_DRAG_MIN) ||
+          (dy >= (int32_t)TOUCH_DRAG_MIN) || (-dy >= (int32_t)TOUCH_DRAG_MIN))
+        { _push(TOUCH_DRAG); }
+
+      if ((0U == _long) && ((now - _down_tick) >= TOUCH_LONG_PRESS_MS))
+      {
+        _long = 1U;
+        _push(TOUCH_LONG_PRESS);
+      }
+    }
+  }
+  else
+  {
+    // a press needs consecutive samples
+    _held = 0U;
+
+    if (++_lifted >= TOUCH_RELEASE_SAMPLES)
+    {
+      if (0U != _pressed)
+        { _push(TOUCH_RELEASE); }
+      _pressed = 0U;
+      _awake = 0U;
+    }
+  }
+}
+
+/**
+  * @brief  Take the oldest queued event.
+  * @param  event: destination
+  * @retval 1 if an event was taken, 0 if the queue is empty
+  */
+uint8_t touch_event(touch_event_t *event)
+{
+  uint8_t any;
+
+  if (NULL == event)
+    { return 0U; }
+
+  taskENTER_CRITICAL();
+  any = (_queue_count > 0U);
+  if (any)
+  {
+    *event = _queue[_queue_head];
+    _queue_head = (_queue_head + 1U) % TOUCH_QUEUE_SIZE;
+    --_queue_count;
+  }
+  taskEXIT_CRITICAL();
+
+  return any;
+}
+
+/**
+  * @brief  Copy the touch counters.
+  * @param  stats: destination
+  * @retval None
+  */
+void touch_stats(touch_stats_t *stats)
+{
+  if (NULL == stats)
+    { return; }
+
+  taskENTER_CRITICAL();
+  *stats = _stats;
+  // not sampled for a whole window: the pen is up
+  if ((osKernelSysTick() - _sample_tick) >= TOUCH_RATE_WINDOW)
+    { stats->rate = 0U; }
+  taskEXIT_CRITICAL();
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  One 12-bit conversion: command byte, then the result MSB first in
+  *         the next 16 clocks.
+  * @param  ok: cleared on a bus error
+  */
+static uint16_t _read(uint8_t cmd, uint8_t *ok)
+{
+  uint8_t tx[3] = { cmd, 0U, 0U };
+  uint8_t rx[3] = { 0U };
+
+  if (HAL_OK != spi_bus_transfer(SPI_BUS_TOUCH, tx, rx, sizeof(tx)))
+  {
+    *ok = 0U;
+    return 0U;
+  }
+
+  return (uint16_t)((((uint16_t)rx[1] << 8U) | rx[2]) >> 3U) & TOUCH_RAW_MAX;
+}
+
+static uint16_t _median(uint16_t *v)
+{
+  // insertion sort, TOUCH_MEDIAN is tiny
+  for (uint32_t i = 1U; i < TOUCH_MEDIAN; ++i)
+  {
+    uint16_t key = v[i];
+    uint32_t j = i;
+    for (; (j > 0U) && (v[j - 1U] > key); --j)
+      { v[j] = v[j - 1U]; }
+    v[j] = key;
+  }
+
+  return v[TOUCH_MEDIAN / 2U];
+}
+
+/**
+  * @brief  Scale a raw reading to a screen coordinate. min above max
+  *         inverts the axis.
+  */
+static uint16_t _map(uint16_t raw, int32_t min, int32_t max, uint16_t size)
+{
+  int32_t v = (((int32_t)raw - min) * (int32_t)(size - 1U)) / (max - min);
+
+  if (v < 0)
+    { return 0U; }
+  if (v >= (int32_t)size)
+    { return size - 1U; }
+
+  return (uint16_t)v;
+}
+
+/**
+  * @brief  Feed a new position through the IIR filter, the first sample of
+  *         a touch seeds it.
+  */
+static void _update(uint16_t x, uint16_t y)
+{
+  int32_t fx = (int32_t)x << TOUCH_IIR_FRAC;
+  int32_t fy = (int32_t)y << TOUCH_IIR_FRAC;
+
+  if ((0U == _pressed) && (0U == _held))
+  {
+    _filter_x = fx;
+    _filter_y = fy;
+  }
+  else
+  {
+    _filter_x += (fx - _filter_x) / (1 << TOUCH_IIR_SHIFT);
+    _filter_y += (fy - _filter_y) / (1 << TOUCH_IIR_SHIFT);
+  }
+
+  _x = (uint16_t)((_filter_x + (1 << (TOUCH_IIR_FRAC - 1U))) >> TOUCH_IIR_FRAC);
+  _y = (uint16_t)((_filter_y + (1 << (TOUCH_IIR_FRAC - 1U))) >> TOUCH_IIR_FRAC);
+}
+
+static void _push(touch_type_t type)
+{
+  touch_event_t e =
+  {
+    .type   = type,
+    .x      = _x,
+    .y      = _y,
+    .tick   = osKernelSysTick(),
+    .edge   = (TOUCH_PRESS == type) ? _edge : _sample_start,
+    .cycles = cycles_now(),
+  };
+  uint32_t latency = cycles_to_us(e.cycles - _edge);
+
+  _reported_x = _x;
+  _reported_y = _y;
+
+  taskENTER_CRITICAL();
+  if (_queue_count < TOUCH_QUEUE_SIZE)
+  {
+    _queue[(_queue_head + _queue_count) % TOUCH_QUEUE_SIZE] = e;
+    ++_queue_count;
+    ++_stats.events;
+  }
+  else
+    { ++_stats.dropped; }
+
+  if (TOUCH_PRESS == type)
+  {
+    ++_presses;
+    _latency_total += latency;
+    _stats.latency_last = latency;
+    _stats.latency_avg  = (uint32_t)(_latency_total / _presses);
+    if (latency > _stats.latency_max)
+      { _stats.latency_max = latency; }
+  }
+  taskEXIT_CRITICAL();
+
+  if (NULL != _listener)
+    { _listener(); }
+}
+
+static uint8_t _pen_down(void)
+{
+  // PENIRQ is open-drain, pulled low while the panel is pressed
+  return (GPIO_PIN_RESET == HAL_GPIO_ReadPin(TOUCH_IRQ_GPIO_Port, TOUCH_IRQ_Pin));
+}
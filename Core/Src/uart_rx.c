@@ -0,0 +1,208 @@
+/**
+  ******************************************************************************
+  * @file           : uart_rx.c
+  * @brief          : Circular DMA receive on USART2 with idle-line detection.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "stm32g4xx_ll_dma.h"
+#include "stm32g4xx_ll_usart.h"
+
+#include "uart_rx.h"
+
+/* Private define ------------------------------------------------------------*/
+
+#if (UART_RX_BUFFER_SIZE & (UART_RX_BUFFER_SIZE - 1U))
+#error "UART_RX_BUFFER_SIZE must be a power of two"
+#endif
+
+#define UART_RX_DMA           DMA1
+#define UART_RX_DMA_CHANNEL   LL_DMA_CHANNEL_5
+
+/* Private variables ---------------------------------------------------------*/
+
+static uint8_t _buffer[UART_RX_BUFFER_SIZE];
+
+static osThreadId _task;
+static uint32_t _laps;           // completed passes over the buffer
+static uint32_t _idle;           // bytes received at the last idle line
+
+static uart_rx_stats_t _stats;
+
+/* Private function prototypes -----------------------------------------------*/
+
+static uint32_t _received(void);
+static void _signal(void);
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Start receiving into the circular buffer. Call after
+  *         MX_DMA_Init() and MX_USART2_UART_Init(), which configure the
+  *         channel and the interrupts.
+  * @retval None
+  */
+void uart_rx_init(void)
+{
+  LL_DMA_SetPeriphAddress(UART_RX_DMA, UART_RX_DMA_CHANNEL,
+      LL_USART_DMA_GetRegAddr(USART2, LL_USART_DMA_REG_DATA_RECEIVE));
+  LL_DMA_SetMemoryAddress(UART_RX_DMA, UART_RX_DMA_CHANNEL,
+      (uint32_t)_buffer);
+  LL_DMA_SetDataLength(UART_RX_DMA, UART_RX_DMA_CHANNEL, UART_RX_BUFFER_SIZE);
+  LL_DMA_EnableIT_HT(UART_RX_DMA, UART_RX_DMA_CHANNEL);
+  LL_DMA_EnableIT_TC(UART_RX_DMA, UART_RX_DMA_CHANNEL);
+
+  LL_USART_ClearFlag_IDLE(USART2);
+  LL_USART_EnableIT_IDLE(USART2);
+  LL_USART_EnableIT_ERROR(USART2);
+  LL_USART_EnableDMAReq_RX(USART2);
+  LL_DMA_EnableChannel(UART_RX_DMA, UART_RX_DMA_CHANNEL);
+}
+
+/**
+  * @brief  Signal a task with UART_RX_SIGNAL whenever data arrives.
+  * @param  task: listener, NULL for none
+  * @retval None
+  */
+void uart_rx_listen(osThreadId task)
+{
+  _task = task;
+}
+
+/**
+  * @brief  Free-running count of bytes received. Byte n is at
+  *         uart_rx_buffer()[n % UART_RX_BUFFER_SIZE] until the DMA comes
+  *         around again.
+  * @param  idle: if not NULL, receives the count at the last idle line
+  * @retval Bytes received since uart_rx_init()
+  */
+uint32_t uart_rx_received(uint32_t *idle)
+{
+  uint32_t primask = __get_PRIMASK();
+  uint32_t received;
+
+  __disable_irq();
+  received = _received();
+  if (NULL != idle)
+    { *idle = _idle; }
+  __set_PRIMASK(primask);
+
+  return received;
+}
+
+/**
+  * @brief  The circular buffer.
+  * @retval UART_RX_BUFFER_SIZE bytes
+  */
+const uint8_t *uart_rx_buffer(void)
+{
+  return _buffer;
+}
+
+/**
+  * @brief  USART2 interrupt, called from USART2_IRQHandler(): idle line and
+  *         receive errors.
+  * @retval None
+  */
+void uart_rx_isr(void)
+{
+  if (0U != LL_USART_IsActiveFlag_FE(USART2))
+  {
+    LL_USART_ClearFlag_FE(USART2);
+    ++_stats.framing;
+  }
+  if (0U != LL_USART_IsActiveFlag_NE(USART2))
+  {
+    LL_USART_ClearFlag_NE(USART2);
+    ++_stats.noise;
+  }
+  if (0U != LL_USART_IsActiveFlag_ORE(USART2))
+  {
+    LL_USART_ClearFlag_ORE(USART2);
+    ++_stats.overruns;
+  }
+
+  if (0U != LL_USART_IsActiveFlag_IDLE(USART2))
+  {
+    LL_USART_ClearFlag_IDLE(USART2);
+    _idle = _received();
+    ++_stats.idles;
+    _signal();
+  }
+}
+
+/**
+  * @brief  DMA1 channel 5 interrupt, called from DMA1_Channel5_IRQHandler():
+  *         half and full buffer.
+  * @retval None
+  */
+void uart_rx_dma_isr(void)
+{
+  if (0U != LL_DMA_IsActiveFlag_TC5(UART_RX_DMA))
+  {
+    LL_DMA_ClearFlag_TC5(UART_RX_DMA);
+    ++_laps;
+  }
+  if (0U != LL_DMA_IsActiveFlag_HT5(UART_RX_DMA))
+    { LL_DMA_ClearFlag_HT5(UART_RX_DMA); }
+
+  _signal();
+}
+
+/**
+  * @brief  Copy the receive statistics.
+  * @param  stats: destination
+  * @retval None
+  */
+void uart_rx_stats(uart_rx_stats_t *stats)
+{
+  if (NULL == stats)
+    { return; }
+
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  *stats = _stats;
+  __set_PRIMASK(primask);
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Bytes received. Called with interrupts masked or from the
+  *         handlers; a lap completed but not yet counted by its interrupt is
+  *         recognised from the pending transfer complete flag.
+  */
+static uint32_t _received(void)
+{
+  uint32_t laps = _laps;
+  uint32_t remaining;
+
+  if (0U != LL_DMA_IsActiveFlag_TC5(UART_RX_DMA))
+  {
+    remaining = LL_DMA_GetDataLength(UART_RX_DMA, UART_RX_DMA_CHANNEL);
+    ++laps;
+  }
+  else
+  {
+    remaining = LL_DMA_GetDataLength(UART_RX_DMA, UART_RX_DMA_CHANNEL);
+    // the lap may have ended between the flag and the length
+    if (0U != LL_DMA_IsActiveFlag_TC5(UART_RX_DMA))
+    {
+      remaining = LL_DMA_GetDataLength(UART_RX_DMA, UART_RX_DMA_CHANNEL);
+      ++laps;
+    }
+  }
+
+  return (laps * UART_RX_BUFFER_SIZE) + (UART_RX_BUFFER_SIZE - remaining);
+}
+
+/**
+  * @brief  Wake the listener, if any.
+  */
+static void _signal(void)
+{
+  if (NULL != _task)
+    { (void)osSignalSet(_task, UART_RX_SIGNAL); }
+}
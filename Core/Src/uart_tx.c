@@ -0,0 +1,395 @@
+/**
+  ******************************************************************************
+  * @file           : uart_tx.c
+  * @brief          : Non-blocking, DMA-driven USART2 transmit ring.
+  ******************************************************************************
+  * @attention
+  *
+  * Ring positions are free-running 16-bit counters, masked into the buffer
+  * on access: _tail <= _commit <= head, where bytes in [_tail, _commit) are
+  * ready to send and [_commit, head) are still being copied by writers.
+  * Positions are compared as forward distances, which is why the ring is
+  * limited to half the counter range.
+  *
+  * The channel is owned by whoever sets _busy, a task or interrupt starting
+  * the first transfer or the transfer complete interrupt chaining the next
+  * one. The owner gives it up only when nothing is left to send, then looks
+  * once more so that a write published meanwhile is not left behind.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+
+#include "main.h"
+#include "stm32g4xx_ll_dma.h"
+#include "stm32g4xx_ll_usart.h"
+
+#include "uart_tx.h"
+
+/* Private define ------------------------------------------------------------*/
+
+#if (UART_TX_BUFFER_SIZE & (UART_TX_BUFFER_SIZE - 1U)) || (UART_TX_BUFFER_SIZE > 16384U)
+#error "UART_TX_BUFFER_SIZE must be a power of two no larger than 16384"
+#endif
+
+#define UART_TX_MASK          (UART_TX_BUFFER_SIZE - 1U)
+#define UART_TX_POS_MASK      0xFFFFU
+
+#define UART_TX_DMA           DMA1
+#define UART_TX_DMA_CHANNEL   LL_DMA_CHANNEL_3
+
+// packed reservation word: head position and writers still copying
+#define STATE_HEAD(s)         ((s) & UART_TX_POS_MASK)
+#define STATE_WRITERS(s)      ((s) >> 16U)
+#define STATE(head, writers)  (((head) & UART_TX_POS_MASK) | ((writers) << 16U))
+
+/* Private variables ---------------------------------------------------------*/
+
+static uint8_t _ring[UART_TX_BUFFER_SIZE];
+static uint8_t _chunk[UART_TX_DMA_CHUNK];  // transfer in flight
+
+static uint32_t _state;          // STATE(head, writers)
+static uint32_t _commit;         // end of the published bytes
+static uint32_t _tail;           // first byte not yet handed to the DMA
+static uint32_t _busy;           // channel owned, transfer in flight
+static uint8_t _ready;           // DMA configured
+static uart_tx_policy_t _policy = UART_TX_POLICY;
+
+static uart_tx_stats_t _stats;
+
+/* Private function prototypes -----------------------------------------------*/
+
+static size_t _write(const void *data, size_t len, size_t limit, uint8_t policy);
+static uint8_t _discard(uint32_t tail, uint32_t count);
+static void _publish(void);
+static void _kick(void);
+static uint8_t _start(void);
+static void _count(uint32_t *counter, uint32_t value);
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Enable the USART2 TX DMA request on DMA1 channel 3 and send
+  *         whatever was written before. Call after MX_DMA_Init() and
+  *         MX_USART2_UART_Init(), which configure the channel.
+  * @retval None
+  */
+void uart_tx_init(void)
+{
+  LL_DMA_SetPeriphAddress(UART_TX_DMA, UART_TX_DMA_CHANNEL,
+      LL_USART_DMA_GetRegAddr(USART2, LL_USART_DMA_REG_DATA_TRANSMIT));
+  LL_DMA_SetMemoryAddress(UART_TX_DMA, UART_TX_DMA_CHANNEL,
+      (uint32_t)_chunk);
+  LL_DMA_EnableIT_TC(UART_TX_DMA, UART_TX_DMA_CHANNEL);
+  LL_DMA_EnableIT_TE(UART_TX_DMA, UART_TX_DMA_CHANNEL);
+
+  LL_USART_EnableDMAReq_TX(USART2);
+
+  __atomic_store_n(&_ready, 1U, __ATOMIC_RELEASE);
+  _kick();
+}
+
+/**
+  * @brief  Queue bytes for transmission, never blocks. Callable from any
+  *         task or interrupt handler.
+  * @param  data: bytes to send
+  * @param  len: number of bytes
+  * @retval len if stored, 0 if dropped
+  */
+size_t uart_tx_write(const void *data, size_t len)
+{
+  return _write(data, len, UART_TX_BUFFER_SIZE, 1U);
+}
+
+/**
+  * @brief  Queue bytes only if no more than limit bytes are then queued.
+  *         Nothing is discarded to make room whatever the policy, and a
+  *         refused write is left to the caller to count. Keeping bulk
+  *         traffic under a lower limit leaves room for urgent writes.
+  * @param  data: bytes to send
+  * @param  len: number of bytes
+  * @param  limit: queued bytes allowed, at most UART_TX_BUFFER_SIZE
+  * @retval len if stored, 0 if refused
+  */
+size_t uart_tx_write_limit(const void *data, size_t len, size_t limit)
+{
+  if (limit > UART_TX_BUFFER_SIZE)
+    { limit = UART_TX_BUFFER_SIZE; }
+
+  return _write(data, len, limit, 0U);
+}
+
+/**
+  * @brief  Number of bytes queued and not yet handed to the DMA.
+  * @retval Bytes
+  */
+size_t uart_tx_pending(void)
+{
+  uint32_t tail = __atomic_load_n(&_tail, __ATOMIC_ACQUIRE);
+  uint32_t state = __atomic_load_n(&_state, __ATOMIC_ACQUIRE);
+
+  return (STATE_HEAD(state) - tail) & UART_TX_POS_MASK;
+}
+
+/**
+  * @brief  Whether everything queued has left the USART, which is when its
+  *         configuration may change without cutting a byte.
+  * @retval 1 if idle
+  */
+uint8_t uart_tx_idle(void)
+{
+  return (0U == uart_tx_pending()) &&
+      (0U == __atomic_load_n(&_busy, __ATOMIC_ACQUIRE)) &&
+      (0U != LL_USART_IsActiveFlag_TC(USART2));
+}
+
+/**
+  * @brief  Select what happens to a write that does not fit.
+  * @param  policy: UART_TX_DROP_NEWEST or UART_TX_DROP_OLDEST
+  * @retval None
+  */
+void uart_tx_set_policy(uart_tx_policy_t policy)
+{
+  _policy = policy;
+}
+
+/**
+  * @brief  DMA1 channel 3 interrupt, called from DMA1_Channel3_IRQHandler().
+  *         Chains the next chunk or releases the channel.
+  * @retval None
+  */
+void uart_tx_isr(void)
+{
+  uint8_t error = (0U != LL_DMA_IsActiveFlag_TE3(UART_TX_DMA));
+
+  if ((0U == LL_DMA_IsActiveFlag_TC3(UART_TX_DMA)) && (0U == error))
+    { return; }
+  LL_DMA_ClearFlag_GI3(UART_TX_DMA);
+  LL_DMA_DisableChannel(UART_TX_DMA, UART_TX_DMA_CHANNEL);
+
+  // the chunk is lost, the channel moves on
+  if (0U != error)
+    { _count(&_stats.errors, 1U); }
+
+  if (0U != _start())
+    { return; }
+
+  __atomic_store_n(&_busy, 0U, __ATOMIC_RELEASE);
+  _kick();
+}
+
+/**
+  * @brief  Copy the transmit statistics.
+  * @param  stats: destination
+  * @retval None
+  */
+void uart_tx_stats(uart_tx_stats_t *stats)
+{
+  if (NULL == stats)
+    { return; }
+
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  *stats = _stats;
+  __set_PRIMASK(primask);
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Reserve, copy and publish one write.
+  * @param  data: bytes to send
+  * @param  len: number of bytes
+  * @param  limit: queued bytes allowed
+  * @param  policy: apply the overflow policy and count what is lost
+  * @retval len if stored, 0 if dropped
+  */
+static size_t _write(const void *data, size_t len, size_t limit, uint8_t policy)
+{
+  const uint8_t *src = data;
+  uint32_t state, head, tail, used, index, first;
+
+  if ((NULL == data) || (0U == len))
+    { return 0U; }
+
+  // reserve [head, head + len)
+  for (;;)
+  {
+    // tail first: it never passes a head read after it
+    tail  = __atomic_load_n(&_tail, __ATOMIC_ACQUIRE);
+    state = __atomic_load_n(&_state, __ATOMIC_ACQUIRE);
+    head  = STATE_HEAD(state);
+    used  = (head - tail) & UART_TX_POS_MASK;
+
+    if ((len > limit) || (used + len > limit))
+    {
+      if (0U == policy)
+        { return 0U; }
+      if ((len <= limit) && (UART_TX_DROP_OLDEST == _policy) &&
+          (0U != _discard(tail, used + len - limit)))
+        { continue; }
+
+      _count(&_stats.overflows, 1U);
+      _count(&_stats.dropped_new, len);
+      return 0U;
+    }
+
+    if (__atomic_compare_exchange_n(&_state, &state,
+        STATE(head + len, STATE_WRITERS(state) + 1U), 1,
+        __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+      { break; }
+  }
+
+  index = head & UART_TX_MASK;
+  first = UART_TX_BUFFER_SIZE - index;
+  if (first > len)
+    { first = len; }
+  memcpy(&_ring[index], src, first);
+  memcpy(_ring, &src[first], len - first);
+
+  _publish();
+
+  _count(&_stats.writes, 1U);
+  _count(&_stats.bytes, len);
+
+  used += len;
+  uint32_t high = __atomic_load_n(&_stats.high_water, __ATOMIC_RELAXED);
+  while ((used > high) &&
+      !__atomic_compare_exchange_n(&_stats.high_water, &high, used, 1,
+          __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    { }
+
+  _kick();
+
+  return len;
+}
+
+/**
+  * @brief  Drop published bytes from the front to make room. Bytes still
+  *         being copied by other writers are never dropped.
+  * @param  tail: front the caller saw
+  * @param  count: bytes needed
+  * @retval 1 if the caller should try again, 0 if there is not enough to drop
+  */
+static uint8_t _discard(uint32_t tail, uint32_t count)
+{
+  uint32_t commit = __atomic_load_n(&_commit, __ATOMIC_ACQUIRE);
+
+  if (((commit - tail) & UART_TX_POS_MASK) < count)
+    { return 0U; }
+
+  // losing the race means someone else moved the front, look again
+  if (__atomic_compare_exchange_n(&_tail, &tail,
+      (tail + count) & UART_TX_POS_MASK, 0,
+      __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+    { _count(&_stats.dropped_old, count); }
+
+  return 1U;
+}
+
+/**
+  * @brief  Retire a writer. The last one out publishes every reservation
+  *         made so far; the commit point only ever moves forward, so a late
+  *         publisher cannot take back what a later one has published.
+  * @retval None
+  */
+static void _publish(void)
+{
+  uint32_t state = __atomic_load_n(&_state, __ATOMIC_RELAXED);
+  uint32_t next;
+
+  do
+    { next = state - (1UL << 16U); }
+  while (!__atomic_compare_exchange_n(&_state, &state, next, 1,
+      __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+
+  if (0U != STATE_WRITERS(next))
+    { return; }
+
+  uint32_t head = STATE_HEAD(next);
+  uint32_t commit = __atomic_load_n(&_commit, __ATOMIC_RELAXED);
+  uint32_t ahead;
+
+  do
+  {
+    ahead = (head - commit) & UART_TX_POS_MASK;
+    if ((0U == ahead) || (ahead > (UART_TX_POS_MASK >> 1U)))
+      { return; }
+  }
+  while (!__atomic_compare_exchange_n(&_commit, &commit, head, 1,
+      __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
+
+/**
+  * @brief  Take the channel and start a transfer if it is idle and there is
+  *         something to send.
+  * @retval None
+  */
+static void _kick(void)
+{
+  if (0U == __atomic_load_n(&_ready, __ATOMIC_ACQUIRE))
+    { return; }
+
+  while (0U == __atomic_exchange_n(&_busy, 1U, __ATOMIC_ACQUIRE))
+  {
+    if (0U != _start())
+      { return; }
+
+    __atomic_store_n(&_busy, 0U, __ATOMIC_RELEASE);
+
+    // published between the look and the release, go again
+    if (__atomic_load_n(&_commit, __ATOMIC_ACQUIRE) ==
+        __atomic_load_n(&_tail, __ATOMIC_ACQUIRE))
+      { return; }
+  }
+}
+
+/**
+  * @brief  Move the next chunk out of the ring and start its transfer.
+  *         Called by the owner of the channel.
+  * @retval 1 if a transfer was started, 0 if there was nothing to send
+  */
+static uint8_t _start(void)
+{
+  uint32_t tail = __atomic_load_n(&_tail, __ATOMIC_ACQUIRE);
+  uint32_t count, index, first;
+
+  // a drop-oldest writer may move the front while the chunk is copied, the
+  // copy then holds overwritten bytes and is taken again
+  do
+  {
+    count = (__atomic_load_n(&_commit, __ATOMIC_ACQUIRE) - tail) & UART_TX_POS_MASK;
+    if (0U == count)
+      { return 0U; }
+    if (count > UART_TX_DMA_CHUNK)
+      { count = UART_TX_DMA_CHUNK; }
+
+    index = tail & UART_TX_MASK;
+    first = UART_TX_BUFFER_SIZE - index;
+    if (first > count)
+      { first = count; }
+    memcpy(_chunk, &_ring[index], first);
+    memcpy(&_chunk[first], _ring, count - first);
+  }
+  while (!__atomic_compare_exchange_n(&_tail, &tail,
+      (tail + count) & UART_TX_POS_MASK, 0,
+      __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+
+  _count(&_stats.sent, count);
+  _count(&_stats.transfers, 1U);
+
+  LL_DMA_SetDataLength(UART_TX_DMA, UART_TX_DMA_CHANNEL, count);
+  LL_DMA_EnableChannel(UART_TX_DMA, UART_TX_DMA_CHANNEL);
+
+  return 1U;
+}
+
+/**
+  * @brief  Add to a statistics counter shared by all producers.
+  */
+static void _count(uint32_t *counter, uint32_t value)
+{
+  __atomic_fetch_add(counter, value, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,196 @@
+/**
+  ******************************************************************************
+  * @file           : ui_latency.c
+  * @brief          : Touch-to-pixel latency tracing of the UI pipeline.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "cycles.h"
+#include "ui_latency.h"
+
+/* Private variables ---------------------------------------------------------*/
+
+static const char *const _name[UI_LATENCY_STAGES] =
+{
+  [UI_LATENCY_INPUT]  = "IN",
+  [UI_LATENCY_HANDLE] = "EVT",
+  [UI_LATENCY_RENDER] = "REN",
+  [UI_LATENCY_DMA]    = "DMA",
+  [UI_LATENCY_TOTAL]  = "TOT",
+};
+
+// the open trace, only touched by the screen task
+static uint8_t _open;
+static uint8_t _rendered;
+static uint32_t _edge;
+static uint32_t _event;
+static uint32_t _handled;
+static uint32_t _last_band;
+
+static ui_latency_stats_t _stats;
+static uint64_t _total[UI_LATENCY_STAGES];
+
+/* Private function prototypes -----------------------------------------------*/
+
+static void _record(ui_latency_stage_t stage, uint32_t cycles);
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Open a trace for a touch event about to be handled.
+  * @param  edge: cycle counter at the pen edge or sample behind the event
+  * @param  event: cycle counter when the event was queued
+  * @retval None
+  */
+void ui_latency_begin(uint32_t edge, uint32_t event)
+{
+  if (0U != _open)
+  {
+    taskENTER_CRITICAL();
+    ++_stats.skipped;
+    taskEXIT_CRITICAL();
+    return;
+  }
+
+  _open = 1U;
+  _rendered = 0U;
+  _edge = edge;
+  _event = event;
+  _handled = cycles_now();
+}
+
+/**
+  * @brief  Mark the end of event handling.
+  * @retval None
+  */
+void ui_latency_handled(void)
+{
+  if (0U != _open)
+    { _handled = cycles_now(); }
+}
+
+/**
+  * @brief  Mark the last band of the frame as handed to the DMA.
+  * @retval None
+  */
+void ui_latency_rendered(void)
+{
+  if (0U != _open)
+  {
+    _last_band = cycles_now();
+    _rendered = 1U;
+  }
+}
+
+/**
+  * @brief  Close the trace once the last transfer completed and add its
+  *         stages to the histograms.
+  * @retval None
+  */
+void ui_latency_end(void)
+{
+  uint32_t now;
+
+  if (0U == _open)
+    { return; }
+
+  now = cycles_now();
+  // nothing was damaged: no render or DMA time
+  if (0U == _rendered)
+    { _last_band = now; }
+
+  taskENTER_CRITICAL();
+  ++_stats.traces;
+  _record(UI_LATENCY_INPUT,  _event - _edge);
+  _record(UI_LATENCY_HANDLE, _handled - _event);
+  _record(UI_LATENCY_RENDER, _last_band - _handled);
+  _record(UI_LATENCY_DMA,    now - _last_band);
+  _record(UI_LATENCY_TOTAL,  now - _edge);
+  taskEXIT_CRITICAL();
+
+  _open = 0U;
+}
+
+/**
+  * @brief  Copy the histograms.
+  * @param  stats: destination
+  * @retval None
+  */
+void ui_latency_stats(ui_latency_stats_t *stats)
+{
+  if (NULL == stats)
+    { return; }
+
+  taskENTER_CRITICAL();
+  *stats = _stats;
+  taskEXIT_CRITICAL();
+}
+
+/**
+  * @brief  Estimate a percentile from a histogram.
+  * @param  hist: stage histogram
+  * @param  percent: 1..100
+  * @retval Upper bound of the bucket holding the percentile (the maximum for
+  *         the last bucket), in us; 0 without samples
+  */
+uint32_t ui_latency_percentile(const ui_latency_hist_t *hist, uint8_t percent)
+{
+  uint32_t rank;
+  uint32_t seen = 0U;
+
+  if ((NULL == hist) || (0U == hist->count))
+    { return 0U; }
+
+  rank = (hist->count * percent + 99U) / 100U;
+
+  for (uint32_t i = 0U; i < (UI_LATENCY_BUCKETS - 1U); ++i)
+  {
+    seen += hist->bucket[i];
+    if (seen >= rank)
+    {
+      uint32_t bound = UI_LATENCY_BUCKET_US << i;
+      return (bound < hist->max) ? bound : hist->max;
+    }
+  }
+
+  return hist->max;
+}
+
+/**
+  * @brief  Short label of a stage.
+  * @param  stage: stage
+  * @retval At most 3 characters
+  */
+const char *ui_latency_name(ui_latency_stage_t stage)
+{
+  return (stage < UI_LATENCY_STAGES) ? _name[stage] : "?";
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Add one duration to a stage. Called in a critical section.
+  */
+static void _record(ui_latency_stage_t stage, uint32_t cycles)
+{
+  ui_latency_hist_t *h = &_stats.stage[stage];
+  uint32_t us = cycles_to_us(cycles);
+  uint32_t i = 0U;
+
+  while ((i < (UI_LATENCY_BUCKETS - 1U)) && (us >= (UI_LATENCY_BUCKET_US << i)))
+    { ++i; }
+
+  ++h->bucket[i];
+  ++h->count;
+  _total[stage] += us;
+  h->last = us;
+  h->avg  = (uint32_t)(_total[stage] / h->count);
+  if (us > h->max)
+    { h->max = us; }
+}
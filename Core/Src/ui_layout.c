@@ -0,0 +1,634 @@
+/**
+  ******************************************************************************
+  * @file           : ui_layout.c
+  * @brief          : Static widget tree and hit-test grid, generated by
+  *                   Tools/ui_layout.py. Do not edit.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+
+#include "glyph_atlas.h"
+#include "ui_layout.h"
+
+/* Exported variables --------------------------------------------------------*/
+
+const widget_def_t ui_layout[UI_WIDGETS] =
+{
+  [UI_ROOT] =
+  {
+    .type     = WIDGET_PANEL,
+    .parent   = WIDGET_NONE,
+    .end      = 34U,
+    .flags    = 0U,
+    .bounds   = { 0U, 0U, 320U, 240U },
+    .fg       = TFT_RGB(0xFFU, 0xFFU, 0xFFU),
+    .bg       = TFT_RGB(0x00U, 0x00U, 0x00U),
+    .text     = NULL,
+    .cells    = 0U,
+    .decimals = 0U,
+    .slot     = WIDGET_SLOT_NONE,
+    .range    = 0,
+  },
+  [UI_READOUTS] =
+  {
+    .type     = WIDGET_PANEL,
+    .parent   = UI_ROOT,
+    .end      = 33U,
+    .flags    = WIDGET_FLAG_TOUCH,
+    .bounds   = { 0U, 0U, 160U, 240U },
+    .fg       = TFT_RGB(0xFFU, 0xFFU, 0xFFU),
+    .bg       = TFT_RGB(0x00U, 0x00U, 0x00U),
+    .text     = NULL,
+    .cells    = 0U,
+    .decimals = 0U,
+    .slot     = WIDGET_SLOT_NONE,
+    .range    = 0,
+  },
+  [UI_LIVE] =
+  {
+    .type     = WIDGET_PANEL,
+    .parent   = UI_READOUTS,
+    .end      = 15U,
+    .flags    = 0U,
+    .bounds   = { 0U, 0U, 160U, 240U },
+    .fg       = TFT_RGB(0xFFU, 0xFFU, 0xFFU),
+    .bg       = TFT_RGB(0x00U, 0x00U, 0x00U),
+    .text     = NULL,
+    .cells    = 0U,
+    .decimals = 0U,
+    .slot     = WIDGET_SLOT_NONE,
+    .range    = 0,
+  },
+  [UI_VBUS_LABEL] =
+  {
+    .type     = WIDGET_LABEL,
+    .parent   = UI_LIVE,
+    .end      = 4U,
+    .flags    = 0U,
+    .bounds   = { 6U, 16U, 48U, 14U },
+    .text_x   = 6U,
+    .text_y   = 16U,
+    .atlas    = &glyph_atlas_small,
+    .fg       = TFT_RGB(0xFFU, 0xFFU, 0xFFU),
+    .bg       = TFT_RGB(0x00U, 0x00U, 0x00U),
+    .text     = "VBUS",
+    .cells    = 4U,
+    .decimals = 0U,
+    .slot     = 0U,
+    .range    = 0,
+  },
+  [UI_VBUS] =
+  {
+    .type     = WIDGET_NUMBER,
+    .parent   = UI_LIVE,
+    .end      = 5U,
+    .flags    = 0U,
+    .bounds   = { 54U, 16U, 96U, 14U },
+    .text_x   = 54U,
+    .text_y   = 16U,
+    .atlas    = &glyph_atlas_small,
+    .fg       = TFT_RGB(0xFFU, 0xFFU, 0xFFU),
+    .bg       = TFT_RGB(0x00U, 0x00U, 0x00U),
+    .text     = "V",
+    .cells    = 8U,
+    .decimals = 3U,
+    .slot     = WIDGET_SLOT_NONE,
+    .range    = 0,
+  },
+  [UI_IBUS_LABEL] =
+  {
+    .type     = WIDGET_LABEL,
+    .parent   = UI_LIVE,
+    .end      = 6U,
+    .flags    = 0U,
+    .bounds   = { 6U, 60U, 48U, 14U },
+    .text_x   = 6U,
+    .text_y   = 60U,
+    .atlas    = &glyph_atlas_small,
+    .fg       = TFT_RGB(0xFFU, 0xFFU, 0xFFU),
+    .bg       = TFT_RGB(0x00U, 0x00U, 0x00U),
+    .text     = "IBUS",
+    .cells    = 4U,
+    .decimals = 0U,
+    .slot     = 1U,
+    .range    = 0,
+  },
+  [UI_IBUS] =
+  {
+    .type     = WIDGET_NUMBER,
+    .parent   = UI_LIVE,
+    .end      = 7U,
+    .flags    = 0U,
+    .bounds   = { 54U, 60U, 96U, 14U },
+    .text_x   = 54U,
+    .text_y   = 60U,
+    .atlas    = &glyph_atlas_small,
+    .fg       = TFT_RGB(0xFFU, 0xFFU, 0xFFU),
+    .bg       = TFT_RGB(0x00U, 0x00U, 0x00U),
+    .text     = "A",
+    .cells    = 8U,
+    .decimals = 3U,
+    .slot     = WIDGET_SLOT_NONE,
+    .range    = 0,
+  },
+  [UI_PBUS_LABEL] =
+  {
+    .type     = WIDGET_LABEL,
+    .parent   = UI_LIVE,
+    .end      = 8U,
+    .flags    = 0U,
+    .bounds   = { 6U, 104U, 48U, 14U },
+    .text_x   = 6U,
+    .text_y   = 104U,
+    .atlas    = &glyph_atlas_small,
+    .fg       = TFT_RGB(0xFFU, 0xFFU, 0xFFU),
+    .bg       = TFT_RGB(0x00U, 0x00U, 0x00U),
+    .text     = "PBUS",
+    .cells    = 4U,
+    .decimals = 0U,
+    .slot     = 2U,
+    .range    = 0,
+  },
+  [UI_PBUS] =
+  {
+    .type     = WIDGET_NUMBER,
+    .parent   = UI_LIVE,
+    .end      = 9U,
+    .flags    = 0U,
+    .bounds   = { 54U, 104U, 96U, 14U },
+    .text_x   = 54U,
+    .text_y   = 104U,
+    .atlas    = &glyph_atlas_small,
+    .fg       = TFT_RGB(0xFFU, 0xFFU, 0xFFU),
+    .bg       = TFT_RGB(0x00U, 0x00U, 0x00U),
+    .text     = "W",
+    .cells    = 8U,
+    .decimals = 2U,
+    .slot     = WIDGET_SLOT_NONE,
+    .range    = 0,
+  },
+  [UI_POWER] =
+  {
+    .type     = WIDGET_BAR,
+    .parent   = UI_LIVE,
+    .end      = 10U,
+    .flags    = 0U,
+    .bounds   = { 6U, 128U, 144U, 6U },
+    .fg       = TFT_RGB(0xFFU, 0xB0U, 0x00U),
+    .bg       = TFT_RGB(0x30U, 0x30U, 0x30U),
+    .text     = NULL,
+    .cells    = 0U,
+    .decimals = 0U,
+    .slot     = WIDGET_SLOT_NONE,
+    .range    = 15000,
+  },
+  [UI_PD] =
+  {
+    .type     = WIDGET_PANEL,
+    .parent   = UI_LIVE,
+    .end      = 15U,
+    .flags    = WIDGET_FLAG_TOUCH,
+    .bounds   = { 0U, 144U, 160U, 66U },
+    .fg       = TFT_RGB(0xFFU, 0xFFU, 0xFFU),
+    .bg       = TFT_RGB(0x00U, 0x00U, 0x00U),
+    .text     = NULL,
+    .cells    = 0U,
+    .decimals = 0U,
+    .slot     = WIDGET_SLOT_NONE,
+    .range    = 0,
+  },
+  [UI_PD_LABEL] =
+  {
+    .type     = WIDGET_LABEL,
+    .parent   = UI_PD,
+    .end      = 12U,
+    .flags    = 0U,
+    .bounds   = { 6U, 148U, 24U, 14U },
+    .text_x   = 6U,
+    .text_y   = 148U,
+    .atlas    = &glyph_atlas_small,
+    .fg       = TFT_RGB(0xFFU, 0xFFU, 0xFFU),
+    .bg       = TFT_RGB(0x00U, 0x00U, 0x00U),
+    .text     = "PD",
+    .cells    = 2U,
+    .decimals = 0U,
+    .slot     = 3U,
+    .range    = 0,
+  },
+  [UI_PD_DETACHED] =
+  {
+    .type     = WIDGET_LABEL,
+    .parent   = UI_PD,
+    .end      = 13U,
+    .flags    = 0U,
+    .bounds   = { 54U, 148U, 96U, 14U },
+    .text_x   = 54U,
+    .text_y   = 148U,
+    .atlas    = &glyph_atlas_small,
+    .fg       = TFT_RGB(0xFFU, 0xFFU, 0xFFU),
+    .bg       = TFT_RGB(0x00U, 0x00U, 0x00U),
+    .text     = "detached",
+    .cells    = 8U,
+    .decimals = 0U,
+    .slot     = 4U,
+    .range    = 0,
+  },
+  [UI_PD_VOLTAGE] =
+  {
+    .type     = WIDGET_NUMBER,
+    .parent   = UI_PD,
+    .end      = 14U,
+    .flags    = WIDGET_FLAG_HIDDEN,
+    .bounds   = { 54U, 148U, 96U, 14U },
+    .text_x   = 54U,
+    .text_y   = 148U,
+    .atlas    = &glyph_atlas_small,
+    .fg       = TFT_RGB(0xFFU, 0xFFU, 0xFFU),
+    .bg       = TFT_RGB(0x00U, 0x00U, 0x00U),
+    .text     = "V",
+    .cells    = 8U,
+    .decimals = 2U,
+    .slot     = WIDGET_SLOT_NONE,
+    .range    = 0,
+  },
+  [UI_PD_CURRENT] =
+  {
+    .type     = WIDGET_NUMBER,
+    .parent   = UI_PD,
+    .end      = 15U,
+    .flags    = WIDGET_FLAG_HIDDEN,
+    .bounds   = { 54U, 192U, 96U, 14U },
+    .text_x   = 54U,
+    .text_y   = 192U,
+    .atlas    = &glyph_atlas_small,
+    .fg       = TFT_RGB(0xFFU, 0xFFU, 0xFFU),
+    .bg       = TFT_RGB(0x00U, 0x00U, 0x00U),
+    .text     = "A",
+    .cells    = 8U,
+    .decimals = 2U,
+    .slot     = WIDGET_SLOT_NONE,
+    .range    = 0,
+  },
+  [UI_PDOS] =
+  {
+    .type     = WIDGET_PANEL,
+    .parent   = UI_READOUTS,
+    .end      = 26U,
+    .flags    = WIDGET_FLAG_HIDDEN,
+    .bounds   = { 0U, 0U, 160U, 240U },
+    .fg       = TFT_RGB(0xFFU, 0xFFU, 0xFFU),
+    .bg       = TFT_RGB(0x00U, 0x00U, 0x00U),
+    .text     = NULL,
+    .cells    = 0U,
+    .decimals = 0U,
+    .slot     = WIDGET_SLOT_NONE,
+    .range    = 0,
+  },
+  [UI_PDO] =
+  {
+    .type     = WIDGET_LIST,
+    .parent   = UI_PDOS,
+    .end      = 24U,
+    .flags    = WIDGET_FLAG_TOUCH,
+    .bounds   = { 2U, 6U, 156U, 146U },
+    .text_x   = 0U,
+    .text_y   = 0U,
+    .atlas    = &glyph_atlas_small,
+    .fg       = TFT_RGB(0xFFU, 0xFFU, 0xFFU),
+    .bg       = TFT_RGB(0x00U, 0x00U, 0x00U),
+    .text     = NULL,
+    .cells    = 13U,
+    .decimals = 0U,
+    .slot     = WIDGET_SLOT_NONE,
+    .range    = 0,
+  },
+  [UI_PDO_0] =
+  {
+    .type     = WIDGET_LABEL,
+    .parent   = UI_PDO,
+    .end      = 18U,
+    .flags    = 0U,
+    .bounds   = { 2U, 6U, 156U, 14U },
+    .text_x   = 2U,
+    .text_y   = 6U,
+    .atlas    = &glyph_atlas_small,
+    .fg       = TFT_RGB(0xFFU, 0xFFU, 0xFFU),
+    .bg       = TFT_RGB(0x00U, 0x00U, 0x00U),
+    .text     = NULL,
+    .cells    = 13U,
+    .decimals = 0U,
+    .slot     = 5U,
+    .range    = 0,
+  },
+  [UI_PDO_1] =
+  {
+    .type     = WIDGET_LABEL,
+    .parent   = UI_PDO,
+    .end      = 19U,
+    .flags    = 0U,
+    .bounds   = { 2U, 28U, 156U, 14U },
+    .text_x   = 2U,
+    .text_y   = 28U,
+    .atlas    = &glyph_atlas_small,
+    .fg       = TFT_RGB(0xFFU, 0xFFU, 0xFFU),
+    .bg       = TFT_RGB(0x00U, 0x00U, 0x00U),
+    .text     = NULL,
+    .cells    = 13U,
+    .decimals = 0U,
+    .slot     = 6U,
+    .range    = 0,
+  },
+  [UI_PDO_2] =
+  {
+    .type     = WIDGET_LABEL,
+    .parent   = UI_PDO,
+    .end      = 20U,
+    .flags    = 0U,
+    .bounds   = { 2U, 50U, 156U, 14U },
+    .text_x   = 2U,
+    .text_y   = 50U,
+    .atlas    = &glyph_atlas_small,
+    .fg       = TFT_RGB(0xFFU, 0xFFU, 0xFFU),
+    .bg       = TFT_RGB(0x00U, 0x00U, 0x00U),
+    .text     = NULL,
+    .cells    = 13U,
+    .decimals = 0U,
+    .slot     = 7U,
+    .range    = 0,
+  },
+  [UI_PDO_3] =
+  {
+    .type     = WIDGET_LABEL,
+    .parent   = UI_PDO,
+    .end      = 21U,
+    .flags    = 0U,
+    .bounds   = { 2U, 72U, 156U, 14U },
+    .text_x   = 2U,
+    .text_y   = 72U,
+    .atlas    = &glyph_atlas_small,
+    .fg       = TFT_RGB(0xFFU, 0xFFU, 0xFFU),
+    .bg       = TFT_RGB(0x00U, 0x00U, 0x00U),
+    .text     = NULL,
+    .cells    = 13U,
+    .decimals = 0U,
+    .slot     = 8U,
+    .range    = 0,
+  },
+  [UI_PDO_4] =
+  {
+    .type     = WIDGET_LABEL,
+    .parent   = UI_PDO,
+    .end      = 22U,
+    .flags    = 0U,
+    .bounds   = { 2U, 94U, 156U, 14U },
+    .text_x   = 2U,
+    .text_y   = 94U,
+    .atlas    = &glyph_atlas_small,
+    .fg       = TFT_RGB(0xFFU, 0xFFU, 0xFFU),
+    .bg       = TFT_RGB(0x00U, 0x00U, 0x00U),
+    .text     = NULL,
+    .cells    = 13U,
+    .decimals = 0U,
+    .slot     = 9U,
+    .range    = 0,
+  },
+  [UI_PDO_5] =
+  {
+    .type     = WIDGET_LABEL,
+    .parent   = UI_PDO,
+    .end      = 23U,
+    .flags    = 0U,
+    .bounds   = { 2U, 116U, 156U, 14U },
+    .text_x   = 2U,
+    .text_y   = 116U,
+    .atlas    = &glyph_atlas_small,
+    .fg       = TFT_RGB(0xFFU, 0xFFU, 0xFFU),
+    .bg       = TFT_RGB(0x00U, 0x00U, 0x00U),
+    .text     = NULL,
+    .cells    = 13U,
+    .decimals = 0U,
+    .slot     = 10U,
+    .range    = 0,
+  },
+  [UI_PDO_6] =
+  {
+    .type     = WIDGET_LABEL,
+    .parent   = UI_PDO,
+    .end      = 24U,
+    .flags    = 0U,
+    .bounds   = { 2U, 138U, 156U, 14U },
+    .text_x   = 2U,
+    .text_y   = 138U,
+    .atlas    = &glyph_atlas_small,
+    .fg       = TFT_RGB(0xFFU, 0xFFU, 0xFFU),
+    .bg       = TFT_RGB(0x00U, 0x00U, 0x00U),
+    .text     = NULL,
+    .cells    = 13U,
+    .decimals = 0U,
+    .slot     = 11U,
+    .range    = 0,
+  },
+  [UI_PDO_STATUS] =
+  {
+    .type     = WIDGET_LABEL,
+    .parent   = UI_PDOS,
+    .end      = 25U,
+    .flags    = 0U,
+    .bounds   = { 2U, 164U, 156U, 14U },
+    .text_x   = 2U,
+    .text_y   = 164U,
+    .atlas    = &glyph_atlas_small,
+    .fg       = TFT_RGB(0xFFU, 0xFFU, 0xFFU),
+    .bg       = TFT_RGB(0x00U, 0x00U, 0x00U),
+    .text     = NULL,
+    .cells    = 13U,
+    .decimals = 0U,
+    .slot     = 12U,
+    .range    = 0,
+  },
+  [UI_PDO_BACK] =
+  {
+    .type     = WIDGET_BUTTON,
+    .parent   = UI_PDOS,
+    .end      = 26U,
+    .flags    = WIDGET_FLAG_TOUCH,
+    .bounds   = { 84U, 196U, 72U, 36U },
+    .text_x   = 96U,
+    .text_y   = 207U,
+    .atlas    = &glyph_atlas_small,
+    .fg       = TFT_RGB(0xFFU, 0xFFU, 0xFFU),
+    .bg       = TFT_RGB(0x30U, 0x30U, 0x30U),
+    .text     = "BACK",
+    .cells    = 4U,
+    .decimals = 0U,
+    .slot     = 13U,
+    .range    = 0,
+  },
+  [UI_OVERLAY] =
+  {
+    .type     = WIDGET_PANEL,
+    .parent   = UI_READOUTS,
+    .end      = 33U,
+    .flags    = WIDGET_FLAG_HIDDEN,
+    .bounds   = { 0U, 0U, 160U, 240U },
+    .fg       = TFT_RGB(0xFFU, 0xFFU, 0xFFU),
+    .bg       = TFT_RGB(0x00U, 0x00U, 0x00U),
+    .text     = NULL,
+    .cells    = 0U,
+    .decimals = 0U,
+    .slot     = WIDGET_SLOT_NONE,
+    .range    = 0,
+  },
+  [UI_LATENCY] =
+  {
+    .type     = WIDGET_LIST,
+    .parent   = UI_OVERLAY,
+    .end      = 33U,
+    .flags    = 0U,
+    .bounds   = { 6U, 16U, 144U, 190U },
+    .text_x   = 0U,
+    .text_y   = 0U,
+    .atlas    = &glyph_atlas_small,
+    .fg       = TFT_RGB(0xFFU, 0xFFU, 0xFFU),
+    .bg       = TFT_RGB(0x00U, 0x00U, 0x00U),
+    .text     = NULL,
+    .cells    = 12U,
+    .decimals = 0U,
+    .slot     = WIDGET_SLOT_NONE,
+    .range    = 0,
+  },
+  [UI_LATENCY_0] =
+  {
+    .type     = WIDGET_LABEL,
+    .parent   = UI_LATENCY,
+    .end      = 29U,
+    .flags    = 0U,
+    .bounds   = { 6U, 16U, 144U, 14U },
+    .text_x   = 6U,
+    .text_y   = 16U,
+    .atlas    = &glyph_atlas_small,
+    .fg       = TFT_RGB(0xFFU, 0xFFU, 0xFFU),
+    .bg       = TFT_RGB(0x00U, 0x00U, 0x00U),
+    .text     = NULL,
+    .cells    = 12U,
+    .decimals = 0U,
+    .slot     = 14U,
+    .range    = 0,
+  },
+  [UI_LATENCY_1] =
+  {
+    .type     = WIDGET_LABEL,
+    .parent   = UI_LATENCY,
+    .end      = 30U,
+    .flags    = 0U,
+    .bounds   = { 6U, 60U, 144U, 14U },
+    .text_x   = 6U,
+    .text_y   = 60U,
+    .atlas    = &glyph_atlas_small,
+    .fg       = TFT_RGB(0xFFU, 0xFFU, 0xFFU),
+    .bg       = TFT_RGB(0x00U, 0x00U, 0x00U),
+    .text     = NULL,
+    .cells    = 12U,
+    .decimals = 0U,
+    .slot     = 15U,
+    .range    = 0,
+  },
+  [UI_LATENCY_2] =
+  {
+    .type     = WIDGET_LABEL,
+    .parent   = UI_LATENCY,
+    .end      = 31U,
+    .flags    = 0U,
+    .bounds   = { 6U, 104U, 144U, 14U },
+    .text_x   = 6U,
+    .text_y   = 104U,
+    .atlas    = &glyph_atlas_small,
+    .fg       = TFT_RGB(0xFFU, 0xFFU, 0xFFU),
+    .bg       = TFT_RGB(0x00U, 0x00U, 0x00U),
+    .text     = NULL,
+    .cells    = 12U,
+    .decimals = 0U,
+    .slot     = 16U,
+    .range    = 0,
+  },
+  [UI_LATENCY_3] =
+  {
+    .type     = WIDGET_LABEL,
+    .parent   = UI_LATENCY,
+    .end      = 32U,
+    .flags    = 0U,
+    .bounds   = { 6U, 148U, 144U, 14U },
+    .text_x   = 6U,
+    .text_y   = 148U,
+    .atlas    = &glyph_atlas_small,
+    .fg       = TFT_RGB(0xFFU, 0xFFU, 0xFFU),
+    .bg       = TFT_RGB(0x00U, 0x00U, 0x00U),
+    .text     = NULL,
+    .cells    = 12U,
+    .decimals = 0U,
+    .slot     = 17U,
+    .range    = 0,
+  },
+  [UI_LATENCY_4] =
+  {
+    .type     = WIDGET_LABEL,
+    .parent   = UI_LATENCY,
+    .end      = 33U,
+    .flags    = 0U,
+    .bounds   = { 6U, 192U, 144U, 14U },
+    .text_x   = 6U,
+    .text_y   = 192U,
+    .atlas    = &glyph_atlas_small,
+    .fg       = TFT_RGB(0xFFU, 0xFFU, 0xFFU),
+    .bg       = TFT_RGB(0x00U, 0x00U, 0x00U),
+    .text     = NULL,
+    .cells    = 12U,
+    .decimals = 0U,
+    .slot     = 18U,
+    .range    = 0,
+  },
+  [UI_CHART] =
+  {
+    .type     = WIDGET_CHART,
+    .parent   = UI_ROOT,
+    .end      = 34U,
+    .flags    = WIDGET_FLAG_TOUCH,
+    .bounds   = { 160U, 0U, 160U, 240U },
+    .fg       = TFT_RGB(0xFFU, 0xFFU, 0xFFU),
+    .bg       = TFT_RGB(0x00U, 0x00U, 0x00U),
+    .text     = NULL,
+    .cells    = 0U,
+    .decimals = 0U,
+    .slot     = WIDGET_SLOT_NONE,
+    .range    = 0,
+  },
+};
+
+// offset into ui_hit_table of the candidates over each cell
+const uint8_t ui_hit_grid[UI_HIT_ROWS][UI_HIT_COLS] =
+{
+  { 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U },
+  { 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U },
+  { 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U },
+  { 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U },
+  { 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U },
+  { 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U },
+  { 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U },
+  { 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U },
+  { 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U },
+  { 6U, 6U, 6U, 6U, 6U, 6U, 6U, 6U, 6U, 6U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U },
+  { 10U, 10U, 10U, 10U, 10U, 10U, 10U, 10U, 10U, 10U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U },
+  { 10U, 10U, 10U, 10U, 10U, 10U, 10U, 10U, 10U, 10U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U },
+  { 10U, 10U, 10U, 10U, 10U, 13U, 13U, 13U, 13U, 13U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U },
+  { 10U, 10U, 10U, 10U, 10U, 13U, 13U, 13U, 13U, 13U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U },
+  { 17U, 17U, 17U, 17U, 17U, 19U, 19U, 19U, 19U, 19U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U, 4U },
+};
+
+const widget_id_t ui_hit_table[UI_HIT_TABLE] =
+{
+  WIDGET_NONE, UI_PDO, UI_READOUTS, WIDGET_NONE, UI_CHART, WIDGET_NONE, UI_PDO, UI_PD,
+  UI_READOUTS, WIDGET_NONE, UI_PD, UI_READOUTS, WIDGET_NONE, UI_PDO_BACK, UI_PD, UI_READOUTS,
+  WIDGET_NONE, UI_READOUTS, WIDGET_NONE, UI_PDO_BACK, UI_READOUTS, WIDGET_NONE,
+};
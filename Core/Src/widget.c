@@ -0,0 +1,500 @@
+/**
+  ******************************************************************************
+  * @file           : widget.c
+  * @brief          : Retained-mode widget tree on top of the renderer.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "cycles.h"
+#include "ui_layout.h"
+#include "widget.h"
+
+/* Private define ------------------------------------------------------------*/
+
+#if (UI_TEXT_ITEMS > RENDER_TEXT_MAX) || (UI_BOX_ITEMS > RENDER_BOX_MAX)
+#error "ui_layout.h: the widget tree needs more renderer items than configured"
+#endif
+
+#define WIDGET_DIRTY_WORDS    ((UI_WIDGETS + 31U) / 32U)
+
+/* Private typedef -----------------------------------------------------------*/
+
+typedef struct
+{
+  int32_t value;          // numbers, bars; lists: selected row, -1 for none
+  int32_t range;          // bars: full scale
+  uint8_t hidden;
+  uint8_t pressed;        // buttons
+  render_text_id_t text;
+  render_box_id_t box;    // bars: the track, the fill is the next box
+}
+widget_t;
+
+/* Private variables ---------------------------------------------------------*/
+
+// divisor from thousandths to the shown fraction digits
+static const uint16_t _fraction[4U] = { 1000U, 100U, 10U, 1U };
+
+static widget_t _widget[UI_WIDGETS];
+static char _text[UI_TEXT_SLOTS][WIDGET_TEXT_LEN];
+static uint32_t _dirty[WIDGET_DIRTY_WORDS];
+
+static widget_id_t _pressed = WIDGET_NONE;
+
+static widget_stats_t _stats;
+
+/* Private function prototypes -----------------------------------------------*/
+
+static void _mark(widget_id_t id);
+static void _mark_tree(widget_id_t id);
+static uint8_t _selected(widget_id_t id);
+static void _apply(widget_id_t id);
+static void _format_number(char *buf, const widget_def_t *d, int32_t value);
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Allocate the renderer items of every widget and mark the whole
+  *         tree dirty. Call after render_init().
+  * @retval None
+  */
+void widget_init(void)
+{
+  for (widget_id_t id = 0U; id < UI_WIDGETS; ++id)
+  {
+    const widget_def_t *d = &ui_layout[id];
+    widget_t *w = &_widget[id];
+
+    memset(w, 0, sizeof(*w));
+    w->range  = d->range;
+    w->hidden = (0U != (d->flags & WIDGET_FLAG_HIDDEN));
+    w->text   = RENDER_TEXT_NONE;
+    w->box    = RENDER_BOX_NONE;
+
+    if (WIDGET_SLOT_NONE != d->slot)
+    {
+      memset(_text[d->slot], 0, WIDGET_TEXT_LEN);
+      if (NULL != d->text)
+        { strncpy(_text[d->slot], d->text, d->cells); }
+    }
+
+    switch (d->type)
+    {
+      case WIDGET_BAR:
+      {
+        render_rect_t fill = { d->bounds.x, d->bounds.y, 0U, d->bounds.h };
+        w->box = render_box(&d->bounds, d->bg);
+        (void)render_box(&fill, d->fg);
+        break;
+      }
+      case WIDGET_BUTTON:
+        w->box = render_box(&d->bounds, d->bg);
+        w->text = render_text(d->text_x, d->text_y, d->atlas, d->fg, d->bg);
+        break;
+      case WIDGET_LABEL:
+      case WIDGET_NUMBER:
+        w->text = render_text(d->text_x, d->text_y, d->atlas, d->fg, d->bg);
+        break;
+      case WIDGET_LIST:
+        w->value = -1;
+        break;
+      default:
+        break;
+    }
+
+    _mark(id);
+  }
+}
+
+/**
+  * @brief  Change the text of a label, button or list row.
+  * @param  id: widget
+  * @param  str: new text, truncated to the widget's cells
+  * @retval None
+  */
+void widget_set_text(widget_id_t id, const char *str)
+{
+  if ((id >= UI_WIDGETS) || (NULL == str) ||
+      (WIDGET_SLOT_NONE == ui_layout[id].slot))
+    { return; }
+
+  const widget_def_t *d = &ui_layout[id];
+  char *text = _text[d->slot];
+
+  if (0 != strncmp(text, str, d->cells))
+  {
+    strncpy(text, str, d->cells);
+    text[d->cells] = '\0';
+    _mark(id);
+  }
+}
+
+/**
+  * @brief  Change the value of a number or bar, in thousandths for numbers,
+  *         or the selected row of a list (-1 for none).
+  * @param  id: widget
+  * @param  value: new value
+  * @retval None
+  */
+void widget_set_value(widget_id_t id, int32_t value)
+{
+  if ((id >= UI_WIDGETS) || (value == _widget[id].value))
+    { return; }
+
+  widget_t *w = &_widget[id];
+
+  if (WIDGET_LIST == ui_layout[id].type)
+  {
+    // only the rows changing colour
+    int32_t rows = (int32_t)ui_layout[id].end - id - 1;
+    if ((w->value >= 0) && (w->value < rows))
+      { _mark(id + 1U + (widget_id_t)w->value); }
+    if ((value >= 0) && (value < rows))
+      { _mark(id + 1U + (widget_id_t)value); }
+  }
+  else
+    { _mark(id); }
+
+  w->value = value;
+}
+
+/**
+  * @brief  Change the full scale of a bar.
+  * @param  id: widget
+  * @param  range: value that fills the bar
+  * @retval None
+  */
+void widget_set_range(widget_id_t id, int32_t range)
+{
+  if ((id >= UI_WIDGETS) || (range == _widget[id].range))
+    { return; }
+
+  _widget[id].range = range;
+  _mark(id);
+}
+
+/**
+  * @brief  Show or hide a widget and everything inside it.
+  * @param  id: widget
+  * @param  visible: 0 to hide
+  * @retval None
+  */
+void widget_show(widget_id_t id, uint8_t visible)
+{
+  if (id >= UI_WIDGETS)
+    { return; }
+
+  uint8_t hidden = (0U == visible);
+  if (hidden == _widget[id].hidden)
+    { return; }
+
+  _widget[id].hidden = hidden;
+  // a button disappearing under the pen is released
+  if ((0U != hidden) && (_pressed >= id) && (_pressed < ui_layout[id].end))
+  {
+    _widget[_pressed].pressed = 0U;
+    _pressed = WIDGET_NONE;
+  }
+  _mark_tree(id);
+}
+
+/**
+  * @brief  Force a widget and everything inside it to be redrawn.
+  * @param  id: widget
+  * @retval None
+  */
+void widget_invalidate(widget_id_t id)
+{
+  if (id < UI_WIDGETS)
+    { _mark_tree(id); }
+}
+
+/**
+  * @brief  Whether a widget and all of its ancestors are shown.
+  * @param  id: widget
+  * @retval 1 if visible
+  */
+uint8_t widget_visible(widget_id_t id)
+{
+  for (; id < UI_WIDGETS; id = ui_layout[id].parent)
+  {
+    if (0U != _widget[id].hidden)
+      { return 0U; }
+  }
+
+  return 1U;
+}
+
+/**
+  * @brief  Change the text of one row of a list.
+  * @param  id: list
+  * @param  row: from 0 at the top
+  * @param  str: new text
+  * @retval None
+  */
+void widget_list_set(widget_id_t id, uint8_t row, const char *str)
+{
+  if ((id >= UI_WIDGETS) || (WIDGET_LIST != ui_layout[id].type) ||
+      ((id + 1U + row) >= ui_layout[id].end))
+    { return; }
+
+  widget_set_text(id + 1U + row, str);
+}
+
+/**
+  * @brief  Row of a list under a screen line, the gap below a row counts as
+  *         part of it.
+  * @param  id: list
+  * @param  y: screen line
+  * @retval Row, WIDGET_NONE if there is none
+  */
+uint8_t widget_list_row(widget_id_t id, uint16_t y)
+{
+  if ((id >= UI_WIDGETS) || (WIDGET_LIST != ui_layout[id].type))
+    { return WIDGET_NONE; }
+
+  const render_rect_t *b = &ui_layout[id].bounds;
+  uint32_t rows = ui_layout[id].end - id - 1U;
+  // rows are evenly spaced
+  uint32_t pitch = (rows > 1U) ?
+      (uint32_t)(ui_layout[id + 2U].bounds.y - ui_layout[id + 1U].bounds.y) : b->h;
+
+  if ((y < b->y) || (y >= (b->y + b->h)) || (0U == pitch))
+    { return WIDGET_NONE; }
+
+  uint32_t row = (y - b->y) / pitch;
+  return (row < rows) ? (uint8_t)row : WIDGET_NONE;
+}
+
+/**
+  * @brief  Innermost visible touchable widget at a point, from the
+  *         precomputed hit grid.
+  * @param  x, y: screen coordinates
+  * @retval Widget, WIDGET_NONE if there is none
+  */
+widget_id_t widget_hit(uint16_t x, uint16_t y)
+{
+  if ((x >= TFT_WIDTH) || (y >= TFT_HEIGHT))
+    { return WIDGET_NONE; }
+
+  // candidates over the cell, innermost first; the cell may be only partly
+  // covered by them, or they may be on a hidden page
+  const widget_id_t *id = &ui_hit_table[ui_hit_grid[y / UI_HIT_CELL][x / UI_HIT_CELL]];
+
+  for (; WIDGET_NONE != *id; ++id)
+  {
+    const render_rect_t *b = &ui_layout[*id].bounds;
+
+    if ((x >= b->x) && (x < (b->x + b->w)) &&
+        (y >= b->y) && (y < (b->y + b->h)) &&
+        (0U != widget_visible(*id)))
+      { return *id; }
+  }
+
+  return WIDGET_NONE;
+}
+
+/**
+  * @brief  Route a touch event: buttons are shown pressed from press to
+  *         release.
+  * @param  event: touch event
+  * @retval Widget under the event, WIDGET_NONE if there is none
+  */
+widget_id_t widget_touch(const touch_event_t *event)
+{
+  if (NULL == event)
+    { return WIDGET_NONE; }
+
+  widget_id_t id = widget_hit(event->x, event->y);
+
+  if ((TOUCH_RELEASE == event->type) && (WIDGET_NONE != _pressed))
+  {
+    _widget[_pressed].pressed = 0U;
+    _mark(_pressed);
+    _pressed = WIDGET_NONE;
+  }
+  else if ((TOUCH_PRESS == event->type) && (WIDGET_NONE != id) &&
+      (WIDGET_BUTTON == ui_layout[id].type))
+  {
+    _widget[id].pressed = 1U;
+    _mark(id);
+    _pressed = id;
+  }
+
+  if (WIDGET_NONE != id)
+  {
+    taskENTER_CRITICAL();
+    ++_stats.hits;
+    taskEXIT_CRITICAL();
+  }
+
+  return id;
+}
+
+/**
+  * @brief  Hand every dirty widget to the renderer. Call from the screen
+  *         task before render_flush().
+  * @retval None
+  */
+void widget_update(void)
+{
+  uint32_t start = cycles_now();
+  uint32_t updates = 0U;
+
+  for (uint32_t i = 0U; i < WIDGET_DIRTY_WORDS; ++i)
+  {
+    uint32_t word = _dirty[i];
+    _dirty[i] = 0U;
+
+    while (0U != word)
+    {
+      widget_id_t id = (widget_id_t)((i * 32U) + (uint32_t)__builtin_ctz(word));
+      word &= word - 1U;
+      _apply(id);
+      ++updates;
+    }
+  }
+
+  uint32_t time = cycles_to_us(cycles_since(start));
+
+  taskENTER_CRITICAL();
+  _stats.updates += updates;
+  _stats.update_time = time;
+  taskEXIT_CRITICAL();
+}
+
+/**
+  * @brief  Copy the invalidation statistics.
+  * @param  stats: destination
+  * @retval None
+  */
+void widget_stats(widget_stats_t *stats)
+{
+  if (NULL == stats)
+    { return; }
+
+  taskENTER_CRITICAL();
+  *stats = _stats;
+  taskEXIT_CRITICAL();
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+static void _mark(widget_id_t id)
+{
+  uint32_t bit = 1UL << (id & 31U);
+
+  if (0U == (_dirty[id >> 5U] & bit))
+  {
+    _dirty[id >> 5U] |= bit;
+    ++_stats.invalidations;
+  }
+}
+
+/**
+  * @brief  Mark a widget and its subtree, the contiguous range up to end.
+  */
+static void _mark_tree(widget_id_t id)
+{
+  for (widget_id_t i = id; i < ui_layout[id].end; ++i)
+    { _mark(i); }
+}
+
+/**
+  * @brief  Whether a widget is the selected row of its list.
+  */
+static uint8_t _selected(widget_id_t id)
+{
+  widget_id_t parent = ui_layout[id].parent;
+
+  return (parent < UI_WIDGETS) && (WIDGET_LIST == ui_layout[parent].type) &&
+      (_widget[parent].value == (int32_t)(id - parent - 1U));
+}
+
+/**
+  * @brief  Push the current state of one widget into its renderer items. A
+  *         hidden widget keeps its items, emptied.
+  */
+static void _apply(widget_id_t id)
+{
+  const widget_def_t *d = &ui_layout[id];
+  widget_t *w = &_widget[id];
+  uint8_t visible = widget_visible(id);
+  char buf[WIDGET_TEXT_LEN];
+  tft_color_t fg = d->fg;
+  tft_color_t bg = d->bg;
+
+  buf[0] = '\0';
+
+  switch (d->type)
+  {
+    case WIDGET_LABEL:
+    case WIDGET_BUTTON:
+      if ((0U != w->pressed) || (0U != _selected(id)))
+      {
+        fg = d->bg;
+        bg = d->fg;
+      }
+      // padded to full width so a highlight covers the whole row
+      if (0U != visible)
+        { snprintf(buf, sizeof(buf), "%-*s", d->cells, _text[d->slot]); }
+      if (WIDGET_BUTTON == d->type)
+        { render_box_set(w->box, (0U != visible) ? d->bounds.w : 0U, bg); }
+      render_text_color(w->text, fg, bg);
+      render_text_set(w->text, buf);
+      break;
+
+    case WIDGET_NUMBER:
+      if (0U != visible)
+        { _format_number(buf, d, w->value); }
+      render_text_set(w->text, buf);
+      break;
+
+    case WIDGET_BAR:
+    {
+      uint16_t fill = 0U;
+      if ((0U != visible) && (w->range > 0) && (w->value > 0))
+      {
+        int32_t value = (w->value < w->range) ? w->value : w->range;
+        fill = (uint16_t)(((int64_t)value * d->bounds.w) / w->range);
+      }
+      render_box_set(w->box, (0U != visible) ? d->bounds.w : 0U, d->bg);
+      render_box_set(w->box + 1U, fill, d->fg);
+      break;
+    }
+
+    default:
+      // panels and lists have no pixels of their own, charts draw their own
+      break;
+  }
+}
+
+/**
+  * @brief  Right-align a value in thousandths with the widget's decimals and
+  *         unit.
+  */
+static void _format_number(char *buf, const widget_def_t *d, int32_t value)
+{
+  char num[WIDGET_TEXT_LEN];
+  uint32_t mag = (value < 0) ? (0U - (uint32_t)value) : (uint32_t)value;
+  uint32_t units = mag / 1000U;
+  uint32_t frac = (mag % 1000U) / _fraction[d->decimals];
+  const char *unit = (NULL != d->text) ? d->text : "";
+
+  if (0U == d->decimals)
+    { snprintf(num, sizeof(num), "%s%lu%s", (value < 0) ? "-" : "", units, unit); }
+  else
+  {
+    snprintf(num, sizeof(num), "%s%lu.%0*lu%s", (value < 0) ? "-" : "",
+        units, d->decimals, frac, unit);
+  }
+
+  snprintf(buf, WIDGET_TEXT_LEN, "%*s", d->cells, num);
+}
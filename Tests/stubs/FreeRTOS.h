@@ -0,0 +1,15 @@
+/**
+  ******************************************************************************
+  * @file           : FreeRTOS.h
+  * @brief          : Host stand-in: the types the tested modules use.
+  ******************************************************************************
+  */
+
+#ifndef INC_FREERTOS_H
+#define INC_FREERTOS_H
+
+#include <stdint.h>
+
+typedef unsigned long UBaseType_t;
+
+#endif /* INC_FREERTOS_H */
@@ -0,0 +1,37 @@
+/**
+  ******************************************************************************
+  * @file           : stm32g4xx.h
+  * @brief          : Host stand-in for the device header: the DWT cycle
+  *                   counter is a plain variable the tests set.
+  ******************************************************************************
+  */
+
+#ifndef __STM32G4xx_H
+#define __STM32G4xx_H
+
+#include <stdint.h>
+
+typedef struct
+{
+  volatile uint32_t CTRL;
+  volatile uint32_t CYCCNT;
+}
+DWT_Type;
+
+typedef struct
+{
+  volatile uint32_t DEMCR;
+}
+CoreDebug_Type;
+
+extern DWT_Type test_dwt;
+extern CoreDebug_Type test_core_debug;
+extern uint32_t SystemCoreClock;
+
+#define DWT                         (&test_dwt)
+#define CoreDebug                   (&test_core_debug)
+
+#define DWT_CTRL_CYCCNTENA_Msk      (1UL << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk  (1UL << 24)
+
+#endif /* __STM32G4xx_H */
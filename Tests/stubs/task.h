@@ -0,0 +1,15 @@
+/**
+  ******************************************************************************
+  * @file           : task.h
+  * @brief          : Host stand-in: the tests run on one thread, so critical
+  *                   sections are empty.
+  ******************************************************************************
+  */
+
+#ifndef INC_TASK_H
+#define INC_TASK_H
+
+#define taskENTER_CRITICAL_FROM_ISR()   (0UL)
+#define taskEXIT_CRITICAL_FROM_ISR(x)   ((void)(x))
+
+#endif /* INC_TASK_H */
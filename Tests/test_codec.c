@@ -0,0 +1,525 @@
+/**
+  ******************************************************************************
+  * @file           : test_codec.c
+  * @brief          : Host test of the Rice codec (Core/Src/codec.c).
+  ******************************************************************************
+  * @attention
+  *
+  * Checks the coding paths on the bit level (keyframe, escape, quotient
+  * boundary, adaptation of k, buffer room), then codes traces into
+  * LINK_TYPE_SAMPLES_RICE bodies batched as link_sample() does and prints
+  * them for test_codec.py, which decodes them with Tools/link.py:
+  *
+  *   trace <name>
+  *   s <mV> <mA>         one per sample
+  *   f <hex body>        one per frame
+  *
+  * Without arguments the traces are synthesized; otherwise each argument is
+  * a recorded trace, one "mV,mA" sample per line.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+
+// the private helpers (_k) are checked too
+#include "../Core/Src/codec.c"
+
+/* Private define ------------------------------------------------------------*/
+
+// as in link.h and link.c
+#define LINK_BODY_MAX         64U
+#define LINK_SAMPLE_BATCH     24U
+#define LINK_SAMPLE_HEADER    7U
+#define MEASURE_PERIOD_MS     10U
+
+#define TRACE_MAX             4096U
+
+#define CHECK(cond) _check((cond), #cond, __LINE__)
+
+/* Private typedef -----------------------------------------------------------*/
+
+typedef struct
+{
+  const char *name;
+  uint32_t count;
+  uint16_t value[TRACE_MAX][CODEC_CHANNELS];
+}
+trace_t;
+
+/* Private variables ---------------------------------------------------------*/
+
+static uint32_t _failed;
+static uint32_t _seed = 1U;
+static trace_t _trace;
+
+/* Private function prototypes -----------------------------------------------*/
+
+static void _check(int cond, const char *text, int line);
+static size_t _bits(const codec_bits_t *bits);
+static void _test_keyframe(void);
+static void _test_escape(void);
+static void _test_adapt(void);
+static void _test_room(void);
+static int32_t _noise(int32_t lsb);
+static uint16_t _ina260(int32_t value);
+static void _add(int32_t mV, int32_t mA);
+static void _synth_idle(void);
+static void _synth_load(void);
+static void _synth_negotiation(void);
+static void _synth_ripple(void);
+static void _synth_edges(void);
+static void _synth_long(void);
+static int _load(const char *path);
+static void _emit(size_t size, uint32_t batch);
+static void _frame(uint8_t *body, codec_bits_t *bits, uint32_t batched);
+
+/* Exported functions --------------------------------------------------------*/
+
+int main(int argc, char *argv[])
+{
+  _test_keyframe();
+  _test_escape();
+  _test_adapt();
+  _test_room();
+
+  if (argc > 1)
+  {
+    for (int i = 1; i < argc; ++i)
+    {
+      if (0 != _load(argv[i]))
+        { return 2; }
+      _emit(LINK_BODY_MAX, LINK_SAMPLE_BATCH);
+    }
+  }
+  else
+  {
+    _synth_idle();
+    _synth_load();
+    _synth_negotiation();
+    _synth_ripple();
+    _synth_edges();
+    _synth_long();
+  }
+
+  if (0U != _failed)
+  {
+    fprintf(stderr, "test_codec: %u checks failed\n", (unsigned)_failed);
+    return 1;
+  }
+  return 0;
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+static void _check(int cond, const char *text, int line)
+{
+  if (!cond)
+  {
+    fprintf(stderr, "test_codec.c:%d: check failed: %s\n", line, text);
+    ++_failed;
+  }
+}
+
+/**
+  * @brief  Bits written so far, whole bytes and pending.
+  */
+static size_t _bits(const codec_bits_t *bits)
+{
+  return (bits->len * 8U) + bits->pending;
+}
+
+/**
+  * @brief  A keyframe is k and the value of each channel, and restarts the
+  *         statistics from that k.
+  */
+static void _test_keyframe(void)
+{
+  uint8_t buf[16] = { 0 };
+  uint16_t value[CODEC_CHANNELS] = { 20000U, (uint16_t)-1500 };
+  codec_t codec;
+  codec_bits_t bits;
+
+  codec_init(&codec);
+  CHECK(2U == _k(&codec.channel[0]));
+
+  codec.channel[1].sum = 300U;                  // k = 9 with count 1
+  codec_begin(&bits, buf, sizeof(buf));
+  CHECK(1U == codec_keyframe(&codec, &bits, value));
+  CHECK(CODEC_KEYFRAME_BITS == _bits(&bits));
+  CHECK(5U == codec_end(&bits));
+
+  // 0010 0100111000100000 1001 1111101000100100
+  CHECK((0x24U == buf[0]) && (0xE2U == buf[1]) && (0x09U == buf[2]) &&
+        (0xFAU == buf[3]) && (0x24U == buf[4]));
+
+  for (uint32_t i = 0U; i < CODEC_CHANNELS; ++i)
+  {
+    CHECK(value[i] == codec.channel[i].prev);
+    CHECK(1U == codec.channel[i].count);
+  }
+  CHECK(4U == codec.channel[0].sum);
+  CHECK(512U == codec.channel[1].sum);
+}
+
+/**
+  * @brief  The quotient boundary, and deltas coded raw after the escape,
+  *         including the extremes of the 16-bit range.
+  */
+static void _test_escape(void)
+{
+  static const struct
+  {
+    uint16_t delta;
+    size_t bits;
+  }
+  cases[] =
+  {
+    { 0U,                   1U + 2U },                       // q = 0
+    { 23U,                  (CODEC_ESCAPE - 1U) + 1U + 2U }, // zz 46, q = 11
+    { 24U,                  CODEC_ESCAPE + 16U },            // zz 48, q = 12
+    { (uint16_t)-24,        (CODEC_ESCAPE - 1U) + 1U + 2U }, // zz 47, q = 11
+    { 15000U,               CODEC_ESCAPE + 16U },
+    { 0x7FFFU,              CODEC_ESCAPE + 16U },            // zz 0xFFFE
+    { 0x8000U,              CODEC_ESCAPE + 16U },            // zz 0xFFFF
+  };
+
+  for (size_t i = 0U; i < (sizeof(cases) / sizeof(cases[0])); ++i)
+  {
+    uint8_t buf[16];
+    uint16_t key[CODEC_CHANNELS] = { 5000U, 5000U };
+    uint16_t next[CODEC_CHANNELS] = { 5000U, (uint16_t)(5000U + cases[i].delta) };
+    codec_t codec;
+    codec_bits_t bits;
+    size_t before;
+
+    codec_init(&codec);
+    codec_begin(&bits, buf, sizeof(buf));
+    (void)codec_keyframe(&codec, &bits, key);
+    before = _bits(&bits);
+
+    CHECK(1U == codec_encode(&codec, &bits, next));
+    // channel 0 repeats its value: one bit of quotient, k = 2 bits
+    CHECK((3U + cases[i].bits) == (_bits(&bits) - before));
+    CHECK(next[1] == codec.channel[1].prev);
+  }
+}
+
+/**
+  * @brief  k follows the magnitude of recent deltas, both ways, and never
+  *         exceeds CODEC_K_MAX.
+  */
+static void _test_adapt(void)
+{
+  uint8_t buf[LINK_BODY_MAX * 64U];
+  uint16_t value[CODEC_CHANNELS] = { 0U, 0U };
+  codec_t codec;
+  codec_bits_t bits;
+  uint8_t k;
+
+  codec_init(&codec);
+  codec_begin(&bits, buf, sizeof(buf));
+  (void)codec_keyframe(&codec, &bits, value);
+
+  // |delta| 200 alternating: zz ~400, k settles at 9 (count << 9 >= sum)
+  for (uint32_t i = 0U; i < 64U; ++i)
+  {
+    value[0] = (uint16_t)(value[0] + ((0U != (i & 1U)) ? 200U : (uint16_t)-200));
+    (void)codec_encode(&codec, &bits, value);
+  }
+  k = _k(&codec.channel[0]);
+  CHECK((k >= 8U) && (k <= 9U));
+  CHECK(0U == _k(&codec.channel[1]));
+
+  // quiet again: the halving forgets the burst within a few resets
+  for (uint32_t i = 0U; i < 160U; ++i)
+    { (void)codec_encode(&codec, &bits, value); }
+  CHECK(0U == _k(&codec.channel[0]));
+
+  // full-scale swings saturate k
+  for (uint32_t i = 0U; i < 64U; ++i)
+  {
+    value[0] = (uint16_t)(value[0] + 0x7FFFU);
+    (void)codec_encode(&codec, &bits, value);
+  }
+  CHECK(CODEC_K_MAX == _k(&codec.channel[0]));
+  CHECK(bits.len < sizeof(buf));
+}
+
+/**
+  * @brief  Nothing is written when the worst case does not fit.
+  */
+static void _test_room(void)
+{
+  uint8_t buf[(CODEC_KEYFRAME_BITS + CODEC_SAMPLE_BITS_MAX + 7U) / 8U];
+  uint16_t value[CODEC_CHANNELS] = { 1U, 2U };
+  codec_t codec;
+  codec_bits_t bits;
+  size_t before;
+
+  codec_init(&codec);
+  codec_begin(&bits, buf, (CODEC_KEYFRAME_BITS / 8U) - 1U);
+  CHECK(0U == codec_keyframe(&codec, &bits, value));
+  CHECK(0U == _bits(&bits));
+
+  codec_begin(&bits, buf, sizeof(buf));
+  CHECK(1U == codec_keyframe(&codec, &bits, value));
+  CHECK(1U == codec_encode(&codec, &bits, value));
+  before = _bits(&bits);
+  CHECK(0U == codec_encode(&codec, &bits, value));
+  CHECK(before == _bits(&bits));
+}
+
+/**
+  * @brief  Roughly normal noise, standard deviation of about lsb.
+  */
+static int32_t _noise(int32_t lsb)
+{
+  int32_t sum = 0;
+
+  for (uint32_t i = 0U; i < 4U; ++i)
+  {
+    _seed = (_seed * 1103515245U) + 12345U;
+    sum += (int32_t)((_seed >> 16) & 0x3FFU) - 512;
+  }
+
+  return (sum * lsb) / 591;
+}
+
+/**
+  * @brief  A reading as measure.c publishes it: INA260 counts of 1.25 mV or
+  *         1.25 mA, rounded to whole units.
+  */
+static uint16_t _ina260(int32_t value)
+{
+  int32_t counts = (value * 4 + ((value < 0) ? -2 : 2)) / 5;
+
+  return (uint16_t)(int16_t)((counts * 5) / 4);
+}
+
+static void _add(int32_t mV, int32_t mA)
+{
+  if (_trace.count < TRACE_MAX)
+  {
+    _trace.value[_trace.count][0] = _ina260(mV + _noise(2));
+    _trace.value[_trace.count][1] = _ina260(mA + _noise(2));
+    ++_trace.count;
+  }
+}
+
+/**
+  * @brief  5 V, nothing attached to the output: noise only.
+  */
+static void _synth_idle(void)
+{
+  _trace.name  = "idle-5V";
+  _trace.count = 0U;
+  for (uint32_t i = 0U; i < 1200U; ++i)
+    { _add(5080, 3); }
+  _emit(LINK_BODY_MAX, LINK_SAMPLE_BATCH);
+}
+
+/**
+  * @brief  20 V contract, load stepping and ramping, VBUS sagging with the
+  *         current through the cable.
+  */
+static void _synth_load(void)
+{
+  static const int32_t step[] = { 500, 2000, 3250, 800, 4700, 1500 };
+
+  _trace.name  = "load-20V";
+  _trace.count = 0U;
+  for (uint32_t i = 0U; i < 1800U; ++i)
+  {
+    int32_t mA = step[(i / 150U) % (sizeof(step) / sizeof(step[0]))];
+
+    if ((i % 600U) >= 450U)
+      { mA = 500 + (int32_t)((i % 150U) * 25U); }
+    mA += _noise(6);
+    _add(20040 - ((mA * 60) / 1000), mA);
+  }
+  _emit(LINK_BODY_MAX, LINK_SAMPLE_BATCH);
+}
+
+/**
+  * @brief  Attach and negotiation: vSafe5V, then requests for 9 V, 15 V
+  *         and 20 V, each transition within one sample, a hard reset back
+  *         to 0 V and a new contract.
+  */
+static void _synth_negotiation(void)
+{
+  static const struct { uint32_t until; int32_t mV; int32_t mA; } phase[] =
+  {
+    { 10U, 0, 0 }, { 40U, 5080, 90 }, { 70U, 9030, 350 }, { 100U, 15050, 1200 },
+    { 160U, 20040, 2900 }, { 170U, 0, 0 }, { 200U, 5080, 120 }, { 300U, 20040, 1800 },
+  };
+  uint32_t p = 0U;
+
+  _trace.name  = "negotiation";
+  _trace.count = 0U;
+  for (uint32_t i = 0U; i < 300U; ++i)
+  {
+    while (i >= phase[p].until)
+      { ++p; }
+    _add(phase[p].mV, phase[p].mA + _noise(10));
+  }
+  _emit(LINK_BODY_MAX, LINK_SAMPLE_BATCH);
+}
+
+/**
+  * @brief  A switching load: tens of mA of ripple aliased into the samples,
+  *         then a steady load. k climbs and comes back down.
+  */
+static void _synth_ripple(void)
+{
+  _trace.name  = "ripple";
+  _trace.count = 0U;
+  for (uint32_t i = 0U; i < 600U; ++i)
+  {
+    int32_t ripple = (i < 300U) ? _noise(60) : 0;
+
+    _add(12010 - (ripple / 20), 1500 + ripple);
+  }
+  _emit(LINK_BODY_MAX, LINK_SAMPLE_BATCH);
+}
+
+/**
+  * @brief  Values at the ends of the ranges: wrap of the 16-bit difference,
+  *         full-scale swings, the most negative current.
+  */
+static void _synth_edges(void)
+{
+  static const uint16_t edge[][CODEC_CHANNELS] =
+  {
+    { 0U, 0U }, { 0xFFFFU, 0x7FFFU }, { 0U, 0x8000U }, { 0x7FFFU, 0x7FFFU },
+    { 0x8000U, 0x8000U }, { 1U, 0xFFFFU }, { 1U, 0xFFFFU }, { 25U, 0x0017U },
+    { 1U, 0xFFE8U },
+  };
+
+  _trace.name  = "edges";
+  _trace.count = 0U;
+  for (uint32_t i = 0U; i < 60U; ++i)
+  {
+    _trace.value[_trace.count][0] = edge[i % 9U][0];
+    _trace.value[_trace.count][1] = edge[(i / 3U) % 9U][1];
+    ++_trace.count;
+  }
+  _emit(LINK_BODY_MAX, LINK_SAMPLE_BATCH);
+}
+
+/**
+  * @brief  Frames of up to 255 samples, more than link.c sends: with a
+  *         keyframe every LINK_SAMPLE_BATCH samples the count never reaches
+  *         CODEC_RESET, here the halving runs on both sides.
+  */
+static void _synth_long(void)
+{
+  _trace.name  = "long-frames";
+  _trace.count = 0U;
+  for (uint32_t i = 0U; i < 1020U; ++i)
+  {
+    int32_t ripple = (0U == ((i / 85U) & 1U)) ? _noise(40) : 0;
+
+    _add(9030 - (ripple / 20), 700 + ripple);
+  }
+  _emit(LINK_SAMPLE_HEADER + 1024U, UINT8_MAX);
+}
+
+/**
+  * @brief  Read a recorded trace, "mV,mA" per line.
+  */
+static int _load(const char *path)
+{
+  FILE *f = fopen(path, "r");
+  char line[64];
+
+  if (NULL == f)
+  {
+    perror(path);
+    return -1;
+  }
+
+  _trace.name  = path;
+  _trace.count = 0U;
+  while ((NULL != fgets(line, sizeof(line), f)) && (_trace.count < TRACE_MAX))
+  {
+    long mV;
+    long mA;
+
+    if (2 != sscanf(line, "%ld,%ld", &mV, &mA))
+      { continue; }
+    _trace.value[_trace.count][0] = (uint16_t)((mV > 0xFFFF) ? 0xFFFF : (mV < 0) ? 0 : mV);
+    _trace.value[_trace.count][1] = (uint16_t)(int16_t)((mA > INT16_MAX) ? INT16_MAX :
+        (mA < INT16_MIN) ? INT16_MIN : mA);
+    ++_trace.count;
+  }
+  fclose(f);
+
+  return 0;
+}
+
+/**
+  * @brief  Print the trace and its frames, batched as link_sample() does.
+  * @param  size: body size, LINK_BODY_MAX
+  * @param  batch: samples per frame, LINK_SAMPLE_BATCH
+  */
+static void _emit(size_t size, uint32_t batch)
+{
+  codec_t codec;
+  static uint8_t body[LINK_SAMPLE_HEADER + 1024U];
+  codec_bits_t bits;
+  uint32_t batched = 0U;
+
+  codec_init(&codec);
+
+  printf("trace %s\n", _trace.name);
+  for (uint32_t i = 0U; i < _trace.count; ++i)
+    { printf("s %u %d\n", _trace.value[i][0], (int16_t)_trace.value[i][1]); }
+
+  for (uint32_t i = 0U; i < _trace.count; ++i)
+  {
+    const uint16_t *value = _trace.value[i];
+
+    if ((0U != batched) && (0U == codec_encode(&codec, &bits, value)))
+    {
+      _frame(body, &bits, batched);
+      batched = 0U;
+    }
+
+    if (0U == batched)
+    {
+      uint32_t tick = 1000U + (i * MEASURE_PERIOD_MS);
+
+      body[0] = (uint8_t)tick;
+      body[1] = (uint8_t)(tick >> 8U);
+      body[2] = (uint8_t)(tick >> 16U);
+      body[3] = (uint8_t)(tick >> 24U);
+      body[4] = (uint8_t)MEASURE_PERIOD_MS;
+      body[5] = (uint8_t)(MEASURE_PERIOD_MS >> 8U);
+      codec_begin(&bits, &body[LINK_SAMPLE_HEADER], size - LINK_SAMPLE_HEADER);
+      CHECK(1U == codec_keyframe(&codec, &bits, value));
+    }
+
+    if (++batched >= batch)
+    {
+      _frame(body, &bits, batched);
+      batched = 0U;
+    }
+  }
+
+  if (0U != batched)
+    { _frame(body, &bits, batched); }
+}
+
+static void _frame(uint8_t *body, codec_bits_t *bits, uint32_t batched)
+{
+  size_t len = LINK_SAMPLE_HEADER + codec_end(bits);
+
+  body[6] = (uint8_t)batched;
+  printf("f ");
+  for (size_t i = 0U; i < len; ++i)
+    { printf("%02x", body[i]); }
+  printf("\n");
+}
@@ -0,0 +1,92 @@
+#!/usr/bin/env python3
+"""Round trip of the Rice codec through the host decoder.
+
+Runs test_codec, which codes traces with Core/Src/codec.c, decodes every
+frame with decode_rice() of Tools/link.py and checks that the samples and
+their ticks come back exactly. Prints the size of the coded stream against
+the uncompressed LINK_TYPE_SAMPLES bodies (8 samples of 4 bytes and a 7-byte
+header each) for every trace.
+
+    python3 Tests/test_codec.py Tests/test_codec [trace.csv ...]
+"""
+
+import os
+import subprocess
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "Tools"))
+import link  # noqa: E402
+
+HEADER = 7
+RAW_BATCH = 8
+RAW_SAMPLE = 4
+PERIOD = 10
+
+
+def raw_size(count):
+    """Body bytes the uncompressed format needs for count samples."""
+    frames = (count + RAW_BATCH - 1) // RAW_BATCH
+    return frames * HEADER + count * RAW_SAMPLE
+
+
+def check(samples, frames):
+    rows = []
+    for n, body in enumerate(frames):
+        try:
+            rows.extend(link.decode_rice(body))
+        except IndexError:
+            return "frame %d: decoder ran past the end" % n
+    if len(rows) != len(samples):
+        return "%d samples decoded, %d coded" % (len(rows), len(samples))
+    for i, ((tick, mv, ma), sample) in enumerate(zip(rows, samples)):
+        if (mv, ma) != sample:
+            return "sample %d: %r decoded as %r" % (i, sample, (mv, ma))
+        if tick != 1000 + i * PERIOD:
+            return "sample %d: tick %d" % (i, tick)
+    return None
+
+
+def main(argv):
+    if len(argv) < 2:
+        print(__doc__.strip().split("\n")[-1].strip(), file=sys.stderr)
+        return 2
+    out = subprocess.run(argv[1:], stdout=subprocess.PIPE, check=True,
+                         universal_newlines=True).stdout
+
+    traces = []
+    for line in out.splitlines():
+        kind, _, rest = line.partition(" ")
+        if kind == "trace":
+            traces.append((rest, [], []))
+        elif kind == "s":
+            mv, ma = rest.split()
+            traces[-1][1].append((int(mv), int(ma)))
+        elif kind == "f":
+            traces[-1][2].append(bytes.fromhex(rest))
+
+    failed = 0
+    total_raw = total_coded = 0
+    print("%-14s %7s %7s %9s %9s %6s" % ("trace", "samples", "frames",
+                                         "raw B", "coded B", "ratio"))
+    for name, samples, frames in traces:
+        error = check(samples, frames)
+        if error:
+            print("%s: %s" % (name, error), file=sys.stderr)
+            failed += 1
+        raw = raw_size(len(samples))
+        coded = sum(len(f) for f in frames)
+        total_raw += raw
+        total_coded += coded
+        print("%-14s %7d %7d %9d %9d %6.2f" % (name, len(samples), len(frames),
+                                               raw, coded, raw / coded))
+    print("%-14s %7s %7s %9d %9d %6.2f" % ("all", "", "", total_raw, total_coded,
+                                           total_raw / total_coded))
+
+    if failed or not traces:
+        print("test_codec: %d traces failed" % failed, file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
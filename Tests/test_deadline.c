@@ -0,0 +1,292 @@
+/**
+  ******************************************************************************
+  * @file           : test_deadline.c
+  * @brief          : Host test of the deadline monitor (Core/Src/deadline.c).
+  ******************************************************************************
+  * @attention
+  *
+  * The DWT cycle counter is a variable (stubs/stm32g4xx.h): each simulated
+  * occurrence advances it by the work done plus any load injected, so the
+  * misses, worst-case latency and lateness and the histogram are known
+  * exactly.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+
+#include "stm32g4xx.h"
+#include "deadline.h"
+
+/* Private define ------------------------------------------------------------*/
+
+#define MHZ                   170U
+
+#define CHECK(cond) _check((cond), #cond, __LINE__)
+
+/* Exported variables --------------------------------------------------------*/
+
+DWT_Type test_dwt;
+CoreDebug_Type test_core_debug;
+uint32_t SystemCoreClock = MHZ * 1000000U;
+
+/* Private variables ---------------------------------------------------------*/
+
+static uint32_t _failed;
+static const char _load[] = "load";    // names are matched by pointer
+
+/* Private function prototypes -----------------------------------------------*/
+
+static void _check(int cond, const char *text, int line);
+static void _elapse(uint32_t cycles);
+static void _run(deadline_id_t id, uint32_t cycles);
+static void _test_load(void);
+static void _test_bins(void);
+static void _test_wrap(void);
+static void _test_pending(void);
+static void _test_mark(void);
+static void _test_register(void);
+
+/* Exported functions --------------------------------------------------------*/
+
+int main(void)
+{
+  _test_load();
+  _test_bins();
+  _test_wrap();
+  _test_pending();
+  _test_mark();
+  _test_register();
+
+  if (0U != _failed)
+  {
+    fprintf(stderr, "test_deadline: %u checks failed\n", (unsigned)_failed);
+    return 1;
+  }
+  printf("test_deadline: ok\n");
+  return 0;
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+static void _check(int cond, const char *text, int line)
+{
+  if (!cond)
+  {
+    fprintf(stderr, "test_deadline.c:%d: check failed: %s\n", line, text);
+    ++_failed;
+  }
+}
+
+static void _elapse(uint32_t cycles)
+{
+  test_dwt.CYCCNT += cycles;
+}
+
+/**
+  * @brief  One occurrence taking the given time from start to finish.
+  */
+static void _run(deadline_id_t id, uint32_t cycles)
+{
+  deadline_start(id);
+  _elapse(cycles);
+  deadline_finish(id);
+  _elapse(1000U);
+}
+
+/**
+  * @brief  A 1 ms task doing 200 us of work, with load injected into some
+  *         occurrences: misses, lateness and bins follow the load.
+  */
+static void _test_load(void)
+{
+  deadline_id_t id = deadline_register(_load, 1000U);
+  deadline_stats_t stats;
+
+  CHECK(0U != (test_dwt.CTRL & DWT_CTRL_CYCCNTENA_Msk));
+  CHECK(0U != (test_core_debug.DEMCR & CoreDebug_DEMCR_TRCENA_Msk));
+  CHECK(0U == test_dwt.CYCCNT);
+
+  for (uint32_t i = 0U; i < 100U; ++i)
+  {
+    uint32_t us = 200U;
+
+    if (9U == (i % 10U))
+      { us += 1500U; }         // 10 x 1700 us: 1 to 2 budgets late
+    if (50U == i)
+      { us += 3500U; }         // 1 x 3700 us
+    if (77U == i)
+      { us += 6000U; }         // 1 x 6200 us: more than 4 budgets
+    _run(id, us * MHZ);
+  }
+
+  deadline_stats(id, &stats);
+  CHECK(1000U == stats.budget_us);
+  CHECK(100U == stats.count);
+  CHECK(12U == stats.missed);
+  CHECK(6200U == stats.worst_us);
+  CHECK(5200U == stats.lateness_us);
+  CHECK(0U == stats.histogram[0]);
+  CHECK(88U == stats.histogram[1]);
+  CHECK(10U == stats.histogram[5]);
+  CHECK(1U == stats.histogram[6]);
+  CHECK(1U == stats.histogram[7]);
+
+  deadline_reset(id);
+  deadline_stats(id, &stats);
+  CHECK((0U == stats.count) && (0U == stats.missed) && (0U == stats.worst_us) &&
+        (0U == stats.lateness_us) && (0U == stats.histogram[1]));
+  CHECK(1000U == stats.budget_us);
+}
+
+/**
+  * @brief  Each bin up to and including its edge, then one cycle over. One
+  *         cycle over the budget is a miss even if under 1 us late.
+  */
+static void _test_bins(void)
+{
+  const uint32_t budget = 800U * MHZ;
+  const uint32_t edge[] =
+  {
+    budget >> 3, budget >> 2, budget >> 1, budget - (budget >> 2), budget,
+    budget << 1, budget << 2,
+  };
+  deadline_id_t id = deadline_register("bins", 800U);
+  deadline_stats_t stats;
+
+  for (uint32_t i = 0U; i < (sizeof(edge) / sizeof(edge[0])); ++i)
+  {
+    _run(id, edge[i]);
+    _run(id, edge[i] + 1U);
+  }
+
+  deadline_stats(id, &stats);
+  CHECK(14U == stats.count);
+  CHECK(1U == stats.histogram[0]);
+  for (uint32_t bin = 1U; bin < 7U; ++bin)
+    { CHECK(2U == stats.histogram[bin]); }
+  CHECK(1U == stats.histogram[7]);
+  CHECK(5U == stats.missed);
+  CHECK(3200U == stats.worst_us);
+  CHECK(2400U == stats.lateness_us);
+
+  // a single cycle over
+  deadline_reset(id);
+  _run(id, budget + 1U);
+  deadline_stats(id, &stats);
+  CHECK((1U == stats.missed) && (0U == stats.lateness_us) && (1U == stats.histogram[5]));
+}
+
+/**
+  * @brief  Occurrences across the wrap of the 32-bit counter.
+  */
+static void _test_wrap(void)
+{
+  deadline_id_t id = deadline_register("wrap", 500U);
+  deadline_stats_t stats;
+
+  test_dwt.CYCCNT = 0xFFFFFFFFU - (100U * MHZ);
+  _run(id, 300U * MHZ);
+  test_dwt.CYCCNT = 0xFFFFFFFFU - (100U * MHZ);
+  _run(id, 700U * MHZ);
+
+  deadline_stats(id, &stats);
+  CHECK(2U == stats.count);
+  CHECK(1U == stats.missed);
+  CHECK(700U == stats.worst_us);
+  CHECK(200U == stats.lateness_us);
+}
+
+/**
+  * @brief  A second start keeps the first; finish without start and a
+  *         cancelled occurrence record nothing.
+  */
+static void _test_pending(void)
+{
+  deadline_id_t id = deadline_register("pending", 100U);
+  deadline_stats_t stats;
+
+  deadline_start(id);
+  _elapse(50U * MHZ);
+  deadline_start(id);
+  _elapse(80U * MHZ);
+  deadline_finish(id);
+  deadline_finish(id);
+
+  deadline_start(id);
+  _elapse(500U * MHZ);
+  deadline_cancel(id);
+  deadline_finish(id);
+
+  deadline_stats(id, &stats);
+  CHECK(1U == stats.count);
+  CHECK(1U == stats.missed);
+  CHECK(130U == stats.worst_us);
+  CHECK(30U == stats.lateness_us);
+}
+
+/**
+  * @brief  A 10 ms periodic activity with jitter and one injected stall;
+  *         a cancelled period is not measured across the pause.
+  */
+static void _test_mark(void)
+{
+  deadline_id_t id = deadline_register("mark", 10000U);
+  deadline_stats_t stats;
+
+  deadline_mark(id);
+  for (uint32_t i = 0U; i < 20U; ++i)
+  {
+    uint32_t us = 10000U + ((0U != (i & 1U)) ? 150U : 0U) - 100U;
+
+    if (12U == i)
+      { us = 25000U; }
+    _elapse(us * MHZ);
+    deadline_mark(id);
+  }
+
+  deadline_cancel(id);
+  _elapse(200000U * MHZ);
+  deadline_mark(id);
+  _elapse(9000U * MHZ);
+  deadline_mark(id);
+
+  deadline_stats(id, &stats);
+  CHECK(21U == stats.count);
+  CHECK(11U == stats.missed);            // 10 x 10050 us and the stall
+  CHECK(25000U == stats.worst_us);
+  CHECK(15000U == stats.lateness_us);
+  CHECK(10U == stats.histogram[4]);
+  CHECK(10U == stats.histogram[5]);
+  CHECK(1U == stats.histogram[6]);
+}
+
+/**
+  * @brief  The same name finds its deadline again, the table stops at
+  *         DEADLINE_MAX and ids out of range are ignored.
+  */
+static void _test_register(void)
+{
+  static const char *const name[] = { "a", "b", "c", "d", "e", "f", "g", "h" };
+  deadline_stats_t stats;
+  uint32_t count = deadline_count();
+
+  // a running counter is left alone
+  test_dwt.CYCCNT = 0x12345678U;
+  CHECK(0U == deadline_register(_load, 1U));
+  CHECK(0x12345678U == test_dwt.CYCCNT);
+  deadline_stats(0U, &stats);
+  CHECK(1000U == stats.budget_us);
+
+  for (uint32_t i = count; i < DEADLINE_MAX; ++i)
+    { CHECK(i == deadline_register(name[i], 100U)); }
+  CHECK(DEADLINE_MAX == deadline_count());
+  CHECK(DEADLINE_NONE == deadline_register("full", 100U));
+
+  deadline_start(DEADLINE_NONE);
+  deadline_finish(DEADLINE_NONE);
+  deadline_mark(DEADLINE_NONE);
+  deadline_stats(DEADLINE_NONE, &stats);
+  CHECK(1000U == stats.budget_us);
+}
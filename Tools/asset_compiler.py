@@ -0,0 +1,272 @@
+#!/usr/bin/env python3
+"""Compile the images in Assets/ into palette + RLE encoded RGB565 assets.
+
+Every PNG (8-bit RGB/RGBA/palette, not interlaced) or binary PPM in Assets/
+becomes a const asset_image_t named asset_<file stem>. Colours are reduced
+to RGB565 and collected into a palette of at most 256 entries; each row is
+then encoded on its own so the decoder can start at any row:
+
+    0x00..0x7F  literal: (b + 1) palette indices follow, one byte each
+    0x80..0xFE  run: (b - 0x80 + 1) pixels of the palette index that follows
+    0xFF        long run: 16-bit little-endian count, then the palette index
+
+Run from the repository root after adding or changing an image:
+
+    python3 Tools/asset_compiler.py
+
+It rewrites Core/Inc/assets.h and Core/Src/assets.c and prints the flash
+saved against raw RGB565.
+"""
+
+import os
+import re
+import struct
+import sys
+import zlib
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), os.pardir)
+ASSETS = os.path.join(ROOT, "Assets")
+HEADER = os.path.join(ROOT, "Core", "Inc", "assets.h")
+SOURCE = os.path.join(ROOT, "Core", "Src", "assets.c")
+
+LITERAL_MAX = 0x80
+RUN_MAX = 0x7F
+LONG_RUN = 0xFF
+# shorter runs are cheaper as part of a literal
+RUN_MIN = 3
+
+BYTES_PER_LINE = 16
+
+
+def read_png(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        sys.exit("asset_compiler: %s: not a PNG" % path)
+
+    pos = 8
+    idat = b""
+    palette = None
+    while pos < len(data):
+        size, kind = struct.unpack(">I4s", data[pos:pos + 8])
+        body = data[pos + 8:pos + 8 + size]
+        pos += 12 + size
+        if kind == b"IHDR":
+            width, height, depth, color, _, _, interlace = struct.unpack(">IIBBBBB", body)
+        elif kind == b"PLTE":
+            palette = [tuple(body[i:i + 3]) for i in range(0, len(body), 3)]
+        elif kind == b"IDAT":
+            idat += body
+        elif kind == b"IEND":
+            break
+
+    channels = {2: 3, 6: 4, 3: 1}.get(color)
+    if depth != 8 or channels is None or interlace != 0:
+        sys.exit("asset_compiler: %s: only 8-bit RGB, RGBA or palette PNGs" % path)
+
+    raw = zlib.decompress(idat)
+    stride = width * channels
+    rows = []
+    prev = bytearray(stride)
+    for y in range(height):
+        kind = raw[y * (stride + 1)]
+        line = bytearray(raw[y * (stride + 1) + 1:(y + 1) * (stride + 1)])
+        for i in range(stride):
+            a = line[i - channels] if i >= channels else 0
+            b = prev[i]
+            c = prev[i - channels] if i >= channels else 0
+            if kind == 1:
+                line[i] = (line[i] + a) & 0xFF
+            elif kind == 2:
+                line[i] = (line[i] + b) & 0xFF
+            elif kind == 3:
+                line[i] = (line[i] + ((a + b) >> 1)) & 0xFF
+            elif kind == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                pred = a if (pa <= pb and pa <= pc) else (b if pb <= pc else c)
+                line[i] = (line[i] + pred) & 0xFF
+        prev = line
+        if color == 3:
+            rows.append([palette[i] for i in line])
+        else:
+            rows.append([tuple(line[i:i + 3]) for i in range(0, stride, channels)])
+    return width, height, rows
+
+
+def read_ppm(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    match = re.match(rb"P6\s+(?:#.*\s+)*(\d+)\s+(\d+)\s+(\d+)\s", data)
+    if not match or int(match.group(3)) != 255:
+        sys.exit("asset_compiler: %s: only binary 8-bit PPMs" % path)
+    width, height = int(match.group(1)), int(match.group(2))
+    body = data[match.end():]
+    rows = []
+    for y in range(height):
+        line = body[y * width * 3:(y + 1) * width * 3]
+        rows.append([tuple(line[i:i + 3]) for i in range(0, width * 3, 3)])
+    return width, height, rows
+
+
+def rgb565(rgb):
+    r, g, b = rgb
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3)
+
+
+def encode_row(row):
+    out = bytearray()
+    literal = []
+
+    def flush():
+        while literal:
+            chunk = literal[:LITERAL_MAX]
+            del literal[:LITERAL_MAX]
+            out.append(len(chunk) - 1)
+            out.extend(chunk)
+
+    i = 0
+    while i < len(row):
+        n = 1
+        while i + n < len(row) and row[i + n] == row[i] and n < 0xFFFF:
+            n += 1
+        if n < RUN_MIN:
+            literal.extend(row[i:i + n])
+        else:
+            flush()
+            if n <= RUN_MAX:
+                out.append(0x80 + n - 1)
+            else:
+                out.append(LONG_RUN)
+                out.extend(struct.pack("<H", n))
+            out.append(row[i])
+        i += n
+    flush()
+    return bytes(out)
+
+
+def compile_image(name, width, height, rows):
+    colors = []
+    lookup = {}
+    indexed = []
+    for row in rows:
+        line = []
+        for px in row:
+            c = rgb565(px)
+            if c not in lookup:
+                lookup[c] = len(colors)
+                colors.append(c)
+            line.append(lookup[c])
+        indexed.append(line)
+    if len(colors) > 256:
+        sys.exit("asset_compiler: %s: %d colours, at most 256" % (name, len(colors)))
+
+    offsets = []
+    data = bytearray()
+    for line in indexed:
+        offsets.append(len(data))
+        data.extend(encode_row(line))
+    if len(data) > 0xFFFF:
+        sys.exit("asset_compiler: %s: encoded size over 64 KB" % name)
+
+    def table(values, fmt, per_line):
+        lines = []
+        for i in range(0, len(values), per_line):
+            lines.append("  " + ", ".join(fmt % v for v in values[i:i + per_line]) + ",")
+        return lines
+
+    raw = width * height * 2
+    size = len(colors) * 2 + len(offsets) * 2 + len(data)
+
+    lines = []
+    lines.append("// %s: %dx%d, %d colours, %d -> %d bytes" % (name, width, height, len(colors), raw, size))
+    lines.append("static const uint16_t _%s_palette[] =" % name)
+    lines.append("{")
+    lines.extend(table(colors, "0x%04X", 8))
+    lines.append("};")
+    lines.append("")
+    lines.append("static const uint16_t _%s_rows[] =" % name)
+    lines.append("{")
+    lines.extend(table(offsets, "%5d", 10))
+    lines.append("};")
+    lines.append("")
+    lines.append("static const uint8_t _%s_data[] =" % name)
+    lines.append("{")
+    lines.extend(table(list(data), "0x%02X", BYTES_PER_LINE))
+    lines.append("};")
+    lines.append("")
+
+    struct_lines = []
+    struct_lines.append("const asset_image_t asset_%s =" % name)
+    struct_lines.append("{")
+    struct_lines.append("  .width   = %dU," % width)
+    struct_lines.append("  .height  = %dU," % height)
+    struct_lines.append("  .colors  = %dU," % len(colors))
+    struct_lines.append("  .size    = %dU," % size)
+    struct_lines.append("  .palette = _%s_palette," % name)
+    struct_lines.append("  .rows    = _%s_rows," % name)
+    struct_lines.append("  .data    = _%s_data," % name)
+    struct_lines.append("};")
+    struct_lines.append("")
+
+    return lines, struct_lines, raw, size
+
+
+BANNER = """/**
+  ******************************************************************************
+  * @file           : %s
+  * @brief          : Compressed image assets, generated by
+  *                   Tools/asset_compiler.py from Assets/. Do not edit.
+  ******************************************************************************
+  */
+"""
+
+
+def main():
+    names = sorted(f for f in os.listdir(ASSETS) if f.lower().endswith((".png", ".ppm")))
+    if not names:
+        sys.exit("asset_compiler: no images in %s" % ASSETS)
+
+    source = [BANNER % "assets.c",
+              "/* Includes ------------------------------------------------------------------*/",
+              '#include "assets.h"', "",
+              "/* Private variables ---------------------------------------------------------*/", ""]
+    exported = ["/* Exported constants --------------------------------------------------------*/", ""]
+    header = [BANNER % "assets.h",
+              "/* Define to prevent recursive inclusion -------------------------------------*/",
+              "#ifndef __ASSETS_H", "#define __ASSETS_H", "",
+              "#ifdef __cplusplus", 'extern "C" {', "#endif", "",
+              "/* Includes ------------------------------------------------------------------*/",
+              '#include "asset.h"', "",
+              "/* Exported constants --------------------------------------------------------*/", ""]
+
+    total_raw = 0
+    total_size = 0
+    for filename in names:
+        path = os.path.join(ASSETS, filename)
+        name = re.sub(r"\W", "_", os.path.splitext(filename)[0].lower())
+        reader = read_png if filename.lower().endswith(".png") else read_ppm
+        width, height, rows = reader(path)
+        lines, struct_lines, raw, size = compile_image(name, width, height, rows)
+        source.extend(lines)
+        exported.extend(struct_lines)
+        total_raw += raw
+        total_size += size
+        decl = "extern const asset_image_t asset_%s;" % name
+        header.append("%-50s// %dx%d, %d bytes" % (decl, width, height, size))
+        print("asset_compiler: %-12s %6d -> %5d bytes" % (name, raw, size))
+
+    header.extend(["", "#ifdef __cplusplus", "}", "#endif", "", "#endif /* __ASSETS_H */", ""])
+    source.extend(exported)
+
+    with open(SOURCE, "w", newline="\n") as f:
+        f.write("\n".join(source))
+    with open(HEADER, "w", newline="\n") as f:
+        f.write("\n".join(header))
+
+    print("asset_compiler: %d bytes of flash saved (%d -> %d)"
+          % (total_raw - total_size, total_raw, total_size))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,240 @@
+#!/usr/bin/env python3
+"""Generate the flash-resident glyph atlas used by the TFT renderer.
+
+The 5x7 source font below is scaled to a few fixed sizes and stored as
+1-bpp row masks (MSB is the leftmost pixel), which the renderer expands to
+RGB565 directly into its DMA strip buffers. Only the characters each size
+needs are emitted: labels use the small atlas, readouts the larger ones.
+
+Run from the repository root after changing the font or the atlas list:
+
+    python3 Tools/glyph_atlas.py
+
+It rewrites Core/Inc/glyph_atlas.h and Core/Src/glyph_atlas.c.
+"""
+
+import os
+import sys
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), os.pardir)
+HEADER = os.path.join(ROOT, "Core", "Inc", "glyph_atlas.h")
+SOURCE = os.path.join(ROOT, "Core", "Src", "glyph_atlas.c")
+
+# Classic 5x7 terminal font, column-major, bit 0 at the top.
+FONT_WIDTH = 5
+FONT_HEIGHT = 7
+FONT_ADVANCE = 6
+
+FONT = {
+    " ": (0x00, 0x00, 0x00, 0x00, 0x00),
+    "!": (0x00, 0x00, 0x5F, 0x00, 0x00),
+    '"': (0x00, 0x07, 0x00, 0x07, 0x00),
+    "#": (0x14, 0x7F, 0x14, 0x7F, 0x14),
+    "$": (0x24, 0x2A, 0x7F, 0x2A, 0x12),
+    "%": (0x23, 0x13, 0x08, 0x64, 0x62),
+    "&": (0x36, 0x49, 0x55, 0x22, 0x50),
+    "'": (0x00, 0x05, 0x03, 0x00, 0x00),
+    "(": (0x00, 0x1C, 0x22, 0x41, 0x00),
+    ")": (0x00, 0x41, 0x22, 0x1C, 0x00),
+    "*": (0x08, 0x2A, 0x1C, 0x2A, 0x08),
+    "+": (0x08, 0x08, 0x3E, 0x08, 0x08),
+    ",": (0x00, 0x50, 0x30, 0x00, 0x00),
+    "-": (0x08, 0x08, 0x08, 0x08, 0x08),
+    ".": (0x00, 0x60, 0x60, 0x00, 0x00),
+    "/": (0x20, 0x10, 0x08, 0x04, 0x02),
+    "0": (0x3E, 0x51, 0x49, 0x45, 0x3E),
+    "1": (0x00, 0x42, 0x7F, 0x40, 0x00),
+    "2": (0x42, 0x61, 0x51, 0x49, 0x46),
+    "3": (0x21, 0x41, 0x45, 0x4B, 0x31),
+    "4": (0x18, 0x14, 0x12, 0x7F, 0x10),
+    "5": (0x27, 0x45, 0x45, 0x45, 0x39),
+    "6": (0x3C, 0x4A, 0x49, 0x49, 0x30),
+    "7": (0x01, 0x71, 0x09, 0x05, 0x03),
+    "8": (0x36, 0x49, 0x49, 0x49, 0x36),
+    "9": (0x06, 0x49, 0x49, 0x29, 0x1E),
+    ":": (0x00, 0x36, 0x36, 0x00, 0x00),
+    ";": (0x00, 0x56, 0x36, 0x00, 0x00),
+    "<": (0x08, 0x14, 0x22, 0x41, 0x00),
+    "=": (0x14, 0x14, 0x14, 0x14, 0x14),
+    ">": (0x00, 0x41, 0x22, 0x14, 0x08),
+    "?": (0x02, 0x01, 0x51, 0x09, 0x06),
+    "@": (0x32, 0x49, 0x79, 0x41, 0x3E),
+    "A": (0x7E, 0x11, 0x11, 0x11, 0x7E),
+    "B": (0x7F, 0x49, 0x49, 0x49, 0x36),
+    "C": (0x3E, 0x41, 0x41, 0x41, 0x22),
+    "D": (0x7F, 0x41, 0x41, 0x22, 0x1C),
+    "E": (0x7F, 0x49, 0x49, 0x49, 0x41),
+    "F": (0x7F, 0x09, 0x09, 0x09, 0x01),
+    "G": (0x3E, 0x41, 0x49, 0x49, 0x7A),
+    "H": (0x7F, 0x08, 0x08, 0x08, 0x7F),
+    "I": (0x00, 0x41, 0x7F, 0x41, 0x00),
+    "J": (0x20, 0x40, 0x41, 0x3F, 0x01),
+    "K": (0x7F, 0x08, 0x14, 0x22, 0x41),
+    "L": (0x7F, 0x40, 0x40, 0x40, 0x40),
+    "M": (0x7F, 0x02, 0x0C, 0x02, 0x7F),
+    "N": (0x7F, 0x04, 0x08, 0x10, 0x7F),
+    "O": (0x3E, 0x41, 0x41, 0x41, 0x3E),
+    "P": (0x7F, 0x09, 0x09, 0x09, 0x06),
+    "Q": (0x3E, 0x41, 0x51, 0x21, 0x5E),
+    "R": (0x7F, 0x09, 0x19, 0x29, 0x46),
+    "S": (0x46, 0x49, 0x49, 0x49, 0x31),
+    "T": (0x01, 0x01, 0x7F, 0x01, 0x01),
+    "U": (0x3F, 0x40, 0x40, 0x40, 0x3F),
+    "V": (0x1F, 0x20, 0x40, 0x20, 0x1F),
+    "W": (0x3F, 0x40, 0x38, 0x40, 0x3F),
+    "X": (0x63, 0x14, 0x08, 0x14, 0x63),
+    "Y": (0x07, 0x08, 0x70, 0x08, 0x07),
+    "Z": (0x61, 0x51, 0x49, 0x45, 0x43),
+    "[": (0x00, 0x7F, 0x41, 0x41, 0x00),
+    "\\": (0x02, 0x04, 0x08, 0x10, 0x20),
+    "]": (0x00, 0x41, 0x41, 0x7F, 0x00),
+    "^": (0x04, 0x02, 0x01, 0x02, 0x04),
+    "_": (0x40, 0x40, 0x40, 0x40, 0x40),
+    # lower-case unit prefixes and symbols, other letters fold to upper-case
+    "h": (0x7F, 0x08, 0x04, 0x04, 0x78),
+    "k": (0x7F, 0x10, 0x28, 0x44, 0x00),
+    "m": (0x7C, 0x04, 0x18, 0x04, 0x78),
+    "s": (0x48, 0x54, 0x54, 0x54, 0x20),
+}
+
+LABEL_CHARS = "".join(chr(c) for c in range(ord(" "), ord("_") + 1)) + "hkms"
+READOUT_CHARS = " 0123456789.-+:%VAWhkms"
+
+# (name, scale, characters)
+ATLASES = (
+    ("small", 2, LABEL_CHARS),
+    ("medium", 3, READOUT_CHARS),
+    ("large", 4, READOUT_CHARS),
+)
+
+FIRST = 0x20
+LAST = 0x7E
+
+BYTES_PER_LINE = 12
+
+
+def rows(ch, scale):
+    """Scaled row masks of one glyph, as lists of 0/1 pixels."""
+    columns = FONT[ch]
+    out = []
+    for y in range(FONT_HEIGHT * scale):
+        row = []
+        for x in range(FONT_WIDTH * scale):
+            row.append((columns[x // scale] >> (y // scale)) & 1)
+        out.append(row)
+    return out
+
+
+def pack(row):
+    """Pack one row of pixels MSB-first into bytes."""
+    data = []
+    for i in range(0, len(row), 8):
+        byte = 0
+        for bit, pixel in enumerate(row[i:i + 8]):
+            byte |= pixel << (7 - bit)
+        data.append(byte)
+    return data
+
+
+def atlas(name, scale, chars):
+    width = FONT_WIDTH * scale
+    stride = (width + 7) // 8
+    index = [0xFF] * (LAST - FIRST + 1)
+    glyphs = []
+
+    for ch in chars:
+        if ch not in FONT:
+            sys.exit("glyph_atlas: no source glyph for %r" % ch)
+        index[ord(ch) - FIRST] = len(glyphs)
+        glyphs.append(ch)
+
+    # letters without a glyph of their own borrow the other case
+    for code in range(FIRST, LAST + 1):
+        ch = chr(code)
+        if index[code - FIRST] == 0xFF and ch.isalpha():
+            other = ch.upper() if ch.islower() else ch.lower()
+            if other in glyphs:
+                index[code - FIRST] = glyphs.index(other)
+
+    lines = []
+    lines.append("// %s: %dx%d" % (name, width, FONT_HEIGHT * scale))
+    lines.append("static const uint8_t _%s_index[GLYPH_INDEX_SIZE] =" % name)
+    lines.append("{")
+    for i in range(0, len(index), 16):
+        lines.append("  " + ", ".join("0x%02X" % v for v in index[i:i + 16]) + ",")
+    lines.append("};")
+    lines.append("")
+    lines.append("static const uint8_t _%s_masks[] =" % name)
+    lines.append("{")
+    for ch in glyphs:
+        label = "'\\\\'" if ch == "\\" else "'%s'" % ch
+        lines.append("  // %s" % label)
+        data = [b for row in rows(ch, scale) for b in pack(row)]
+        for i in range(0, len(data), BYTES_PER_LINE):
+            lines.append("  " + ", ".join("0x%02X" % b for b in data[i:i + BYTES_PER_LINE]) + ",")
+    lines.append("};")
+    lines.append("")
+
+    struct = []
+    struct.append("const glyph_atlas_t glyph_atlas_%s =" % name)
+    struct.append("{")
+    struct.append("  .width   = %dU," % width)
+    struct.append("  .height  = %dU," % (FONT_HEIGHT * scale))
+    struct.append("  .advance = %dU," % (FONT_ADVANCE * scale))
+    struct.append("  .stride  = %dU," % stride)
+    struct.append("  .index   = _%s_index," % name)
+    struct.append("  .masks   = _%s_masks," % name)
+    struct.append("};")
+    struct.append("")
+
+    size = len(index) + len(glyphs) * FONT_HEIGHT * scale * stride
+    return lines, struct, size
+
+
+BANNER = """/**
+  ******************************************************************************
+  * @file           : %s
+  * @brief          : Pre-rendered glyph atlas, generated by
+  *                   Tools/glyph_atlas.py. Do not edit.
+  ******************************************************************************
+  */
+"""
+
+
+def main():
+    source = [BANNER % "glyph_atlas.c",
+              "/* Includes ------------------------------------------------------------------*/",
+              '#include "glyph_atlas.h"', "",
+              "/* Private variables ---------------------------------------------------------*/", ""]
+    exported = ["/* Exported constants --------------------------------------------------------*/", ""]
+    header = [BANNER % "glyph_atlas.h",
+              "/* Define to prevent recursive inclusion -------------------------------------*/",
+              "#ifndef __GLYPH_ATLAS_H", "#define __GLYPH_ATLAS_H", "",
+              "#ifdef __cplusplus", 'extern "C" {', "#endif", "",
+              "/* Includes ------------------------------------------------------------------*/",
+              '#include "glyph.h"', "",
+              "/* Exported constants --------------------------------------------------------*/", ""]
+
+    total = 0
+    for name, scale, chars in ATLASES:
+        lines, struct, size = atlas(name, scale, chars)
+        source.extend(lines)
+        exported.extend(struct)
+        total += size
+        decl = "extern const glyph_atlas_t glyph_atlas_%s;" % name
+        header.append("%-50s// %dx%d, %d glyphs"
+                      % (decl, FONT_WIDTH * scale, FONT_HEIGHT * scale, len(chars)))
+    source.extend(exported)
+
+    header.extend(["", "#ifdef __cplusplus", "}", "#endif", "", "#endif /* __GLYPH_ATLAS_H */", ""])
+
+    with open(SOURCE, "w", newline="\n") as f:
+        f.write("\n".join(source))
+    with open(HEADER, "w", newline="\n") as f:
+        f.write("\n".join(header))
+
+    print("glyph_atlas: %d bytes of flash" % total)
+
+
+if __name__ == "__main__":
+    main()
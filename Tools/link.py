@@ -0,0 +1,449 @@
+#!/usr/bin/env python3
+"""Decode the binary telemetry stream sent on USART2 (Core/Inc/link.h).
+
+Frames are COBS-encoded and separated by zero bytes. Each one carries a
+schema version, a channel, a record type and a per-channel sequence number,
+followed by the body and a CRC-16/CCITT-FALSE. Corrupt frames are counted
+and skipped; gaps in the sequence numbers are reported as lost frames.
+
+Read a capture file, a serial device already set to the right baud rate,
+or standard input:
+
+    stty -F /dev/ttyACM0 115200 raw && python3 Tools/link.py /dev/ttyACM0
+    python3 Tools/link.py capture.bin
+
+Records are printed one per line, per-channel totals at the end. Deferred
+log records are formatted with the strings from the firmware ELF file, given
+with -e; without it they are printed as format ID and raw arguments. USB-PD
+stack trace records show payloads in hex, with a marker where records were
+dropped. PD message captures are printed raw here, Tools/pdcap.py decodes
+them. Command responses (Core/Inc/shell.h) come in chunks and are printed
+once a line is complete. Commands given with -c are written to the device first:
+
+    python3 Tools/link.py -c '*IDN?' -c 'MEAS?' /dev/ttyACM0
+
+With pyserial installed, -b raises the port rate first: the device offers
+the fastest rate it can generate up to the one given, both sides switch and
+verify it, and either side falls back if that fails:
+
+    python3 Tools/link.py -b MAX /dev/ttyACM0
+    python3 Tools/link.py -b 3000000 -c 'SYST:COMM:SER:BAUD?' /dev/ttyACM0
+"""
+
+import argparse
+import binascii
+import re
+import struct
+import sys
+import time
+
+SCHEMA_VERSION = 1
+
+CHANNELS = ("response", "event", "log", "sample")
+
+TYPE_SAMPLES = 0x10
+TYPE_SAMPLES_RICE = 0x11
+TYPE_NOTIFY = 0x20
+TYPE_CABLE = 0x21
+TYPE_CAPTURE = 0x22
+TYPE_LOG = 0x30
+TYPE_DLOG = 0x31
+TYPE_TRACE = 0x32
+TYPE_RESPONSE = 0x40
+
+# Core/Inc/baud.h
+SAFE_RATE = 115200
+CONFIRM_TIMEOUT = 1.2
+SILENCE_TIMEOUT = 3.0
+
+HEADER = struct.Struct("<BBBH")
+CRC_SIZE = 2
+
+
+def cobs_decode(data):
+    """Decode one COBS frame, without its delimiter. Returns None if the
+    code bytes run past the end."""
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            return None
+        out += data[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def crc16(data):
+    """CRC-16/CCITT-FALSE, as configured on the CRC unit."""
+    return binascii.crc_hqx(data, 0xFFFF)
+
+
+def decode_samples(body):
+    tick, period, count = struct.unpack_from("<IHB", body)
+    samples = struct.iter_unpack("<Hh", body[7:7 + 4 * count])
+    return [(tick + i * period, mv, ma) for i, (mv, ma) in enumerate(samples)]
+
+
+# Core/Inc/codec.h
+CODEC_CHANNELS = 2
+CODEC_K_MAX = 15
+CODEC_ESCAPE = 12
+CODEC_RESET = 32
+
+
+class BitReader:
+    """MSB-first bit reader."""
+
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def bit(self):
+        byte = self.data[self.pos >> 3]
+        bit = (byte >> (7 - (self.pos & 7))) & 1
+        self.pos += 1
+        return bit
+
+    def bits(self, count):
+        value = 0
+        for _ in range(count):
+            value = (value << 1) | self.bit()
+        return value
+
+
+def decode_rice(body):
+    """Mirror of codec.c: a keyframe, then count - 1 delta-coded samples."""
+    tick, period, count = struct.unpack_from("<IHB", body)
+    reader = BitReader(body[7:])
+    prev, total, seen = [], [], []
+    for _ in range(CODEC_CHANNELS):
+        k = reader.bits(4)
+        prev.append(reader.bits(16))
+        total.append(1 << k)
+        seen.append(1)
+    rows = [list(prev)]
+    for _ in range(count - 1):
+        for c in range(CODEC_CHANNELS):
+            k = 0
+            while k < CODEC_K_MAX and (seen[c] << k) < total[c]:
+                k += 1
+            q = 0
+            while q < CODEC_ESCAPE and reader.bit():
+                q += 1
+            zz = reader.bits(16) if q == CODEC_ESCAPE else (q << k) | reader.bits(k)
+            delta = (zz >> 1) ^ -(zz & 1)
+            prev[c] = (prev[c] + delta) & 0xFFFF
+            total[c] += zz
+            seen[c] += 1
+            if seen[c] >= CODEC_RESET:
+                total[c] >>= 1
+                seen[c] >>= 1
+        rows.append(list(prev))
+    return [(tick + i * period, mv, ma - 0x10000 if ma & 0x8000 else ma)
+            for i, (mv, ma) in enumerate(rows)]
+
+
+def format_samples(decode):
+    def fmt(body):
+        return " ".join("%d:%.3fV,%.3fA" % (t, mv / 1000.0, ma / 1000.0)
+                        for t, mv, ma in decode(body))
+    return fmt
+
+
+def format_event(name):
+    def fmt(body):
+        tick, port, value = struct.unpack_from("<IBB", body)
+        return "%d port %d %s %d" % (tick, port, name, value)
+    return fmt
+
+
+def load_formats(path):
+    """Format strings of deferred log records (Core/Inc/dlog.h) by ID, read
+    from the .dlog section of the firmware ELF file."""
+    with open(path, "rb") as f:
+        elf = f.read()
+    if elf[:4] != b"\x7fELF":
+        raise ValueError("%s is not an ELF file" % path)
+    wide = elf[4] == 2
+    order = "<" if elf[5] == 1 else ">"
+    if wide:
+        shoff, = struct.unpack_from(order + "Q", elf, 0x28)
+        shentsize, shnum, shstrndx = struct.unpack_from(order + "HHH", elf, 0x3A)
+        header = struct.Struct(order + "IIQQQQ")
+    else:
+        shoff, = struct.unpack_from(order + "I", elf, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from(order + "HHH", elf, 0x2E)
+        header = struct.Struct(order + "IIIIII")
+    sections = [header.unpack_from(elf, shoff + i * shentsize) for i in range(shnum)]
+    names = sections[shstrndx][4]
+
+    formats = {}
+    for name, _, _, addr, offset, size in sections:
+        if elf[names + name:elf.index(b"\0", names + name)] != b".dlog":
+            continue
+        data = elf[offset:offset + size]
+        i = 0
+        while i < len(data):
+            end = data.index(b"\0", i)
+            if end > i:
+                formats[(addr + i) & 0xFFFF] = data[i:end].decode("ascii", "replace")
+            i = end + 1
+    return formats
+
+
+CONVERSION = re.compile(r"%([-+ #0]*\d*(?:\.\d+)?)(?:hh|h|ll|l|z|j|t)?([diuxXcp%])")
+
+
+def cformat(fmt, args):
+    """printf() with 32-bit integer arguments."""
+    args = iter(args)
+
+    def convert(match):
+        flags, kind = match.groups()
+        if kind == "%":
+            return "%"
+        value = next(args, 0)
+        if kind in "di":
+            value -= (value & 0x80000000) << 1
+            kind = "d"
+        elif kind == "u":
+            kind = "d"
+        elif kind == "p":
+            return "0x%08x" % value
+        elif kind == "c":
+            return chr(value & 0xFF)
+        return ("%" + flags + kind) % value
+
+    return CONVERSION.sub(convert, fmt)
+
+
+def format_dlog(formats):
+    """One line per record, timed from the cycle counter against the tick
+    taken when the frame was built."""
+    def fmt(body):
+        tick, cycles, mhz, dropped = struct.unpack_from("<IIBH", body)
+        lines = ["%d dropped" % dropped] if dropped else []
+        i = 11
+        while i + 7 <= len(body):
+            ident, info, when = struct.unpack_from("<HBI", body, i)
+            count = info & 0x0F
+            args = struct.unpack_from("<%dI" % count, body, i + 7)
+            i += 7 + 4 * count
+            delta = ((when - cycles + 0x80000000) & 0xFFFFFFFF) - 0x80000000
+            text = (cformat(formats[ident], args) if ident in formats else
+                    " ".join(["#%04x" % ident] + ["%08x" % a for a in args]))
+            lines.append("%.3f port %d %s" % (tick + delta / (mhz * 1000.0),
+                                              info >> 4, text))
+        return lines
+    return fmt
+
+
+# TRACE_EVENT of the USB-PD stack (usbpd_trace.h), the source of a record
+TRACE_EVENTS = {1: "msg-in", 2: "msg-out", 3: "cad", 4: "pe-state",
+                5: "cad-low", 6: "debug", 7: "src", 8: "snk", 9: "notif"}
+TRACE_DROPPED = 0xFF
+TRACE_DATA_MAX = 30  # PD_TRACE_DATA_MAX
+
+
+def format_trace(body):
+    """One line per USB-PD stack trace record (Core/Inc/pd_trace.h), timed
+    as deferred log records are."""
+    tick, cycles, mhz = struct.unpack_from("<IIB", body)
+    lines = []
+    i = 9
+    while i + 7 <= len(body):
+        kind, info, size, when = struct.unpack_from("<BBBI", body, i)
+        data = body[i + 7:i + 7 + min(size, TRACE_DATA_MAX)]
+        i += 7 + len(data)
+        delta = ((when - cycles + 0x80000000) & 0xFFFFFFFF) - 0x80000000
+        ms = tick + delta / (mhz * 1000.0)
+        if kind == TRACE_DROPPED:
+            lines.append("%.3f %d %s records dropped" % (
+                ms, struct.unpack("<I", data)[0],
+                TRACE_EVENTS.get(info, "type %d" % info)))
+            continue
+        text = (data.decode("ascii", "replace") if kind == 6 else data.hex()) + \
+            ("" if len(data) == size else " (%d bytes)" % size)
+        lines.append("%.3f port %d sop %d %s %s" % (
+            ms, info >> 4, info & 0x0F,
+            TRACE_EVENTS.get(kind, "type %d" % kind), text))
+    return lines
+
+
+def format_log(body):
+    tick, port = struct.unpack_from("<IB", body)
+    return "%d port %d %s" % (tick, port, body[5:].decode("ascii", "replace"))
+
+
+FORMATTERS = {
+    TYPE_SAMPLES: format_samples(decode_samples),
+    TYPE_SAMPLES_RICE: format_samples(decode_rice),
+    TYPE_NOTIFY: format_event("notify"),
+    TYPE_CABLE: format_event("cable"),
+    TYPE_LOG: format_log,
+    TYPE_DLOG: format_dlog({}),
+    TYPE_TRACE: format_trace,
+}
+
+
+class Stream:
+    """Splits a byte stream into frames and tracks losses per channel."""
+
+    def __init__(self):
+        self.pending = bytearray()
+        self.sequence = {}
+        self.frames = [0] * len(CHANNELS)
+        self.lost = [0] * len(CHANNELS)
+        self.corrupt = 0
+
+    def feed(self, data):
+        """Yield (channel, type, sequence, body) for each good frame."""
+        self.pending += data
+        while True:
+            end = self.pending.find(0)
+            if end < 0:
+                return
+            raw = bytes(self.pending[:end])
+            del self.pending[:end + 1]
+            if raw:
+                frame = self.parse(raw)
+                if frame is not None:
+                    yield frame
+
+    def parse(self, raw):
+        frame = cobs_decode(raw)
+        if (frame is None or len(frame) < HEADER.size + CRC_SIZE or
+                crc16(frame[:-CRC_SIZE]) !=
+                struct.unpack_from("<H", frame, len(frame) - CRC_SIZE)[0]):
+            self.corrupt += 1
+            return None
+
+        version, channel, kind, sequence = HEADER.unpack_from(frame)
+        if version != SCHEMA_VERSION or channel >= len(CHANNELS):
+            self.corrupt += 1
+            return None
+
+        expected = self.sequence.get(channel)
+        if expected is not None:
+            self.lost[channel] += (sequence - expected) & 0xFFFF
+        self.sequence[channel] = (sequence + 1) & 0xFFFF
+        self.frames[channel] += 1
+
+        return channel, kind, sequence, frame[HEADER.size:-CRC_SIZE]
+
+
+def read_response(port, stream, timeout):
+    """First response line within timeout, other records are dropped."""
+    response = bytearray()
+    deadline = time.monotonic() + timeout
+    while time.monotonic() < deadline:
+        for _, kind, _, body in stream.feed(port.read(256)):
+            if kind == TYPE_RESPONSE:
+                response += body
+                if b"\n" in response:
+                    return response.partition(b"\n")[0].decode("ascii", "replace")
+    return None
+
+
+def negotiate(port, stream, rate):
+    """Raise the port to the fastest rate the device accepts up to rate and
+    verify it (Core/Inc/baud.h). Returns the rate in use."""
+    port.write(b"SYST:COMM:SER:NEG? %s\n" % rate.encode("ascii"))
+    answer = read_response(port, stream, 1.0)
+    if answer is None or not answer.isdigit():
+        return port.baudrate
+    if int(answer) == port.baudrate:
+        return port.baudrate
+
+    old = port.baudrate
+    port.baudrate = int(answer)
+    port.reset_input_buffer()
+    stream.pending.clear()
+    # the device switches once its answer has drained, then waits
+    # CONFIRM_TIMEOUT for the confirmation
+    deadline = time.monotonic() + CONFIRM_TIMEOUT
+    while time.monotonic() < deadline:
+        port.write(b"SYST:COMM:SER:CONF?\n")
+        if read_response(port, stream, 0.1) == answer:
+            return port.baudrate
+    port.baudrate = old
+    return old
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("source", nargs="?", help="capture file or serial device")
+    parser.add_argument("-c", dest="commands", action="append", default=[],
+                        metavar="COMMAND", help="send a shell command first")
+    parser.add_argument("-b", dest="baud", metavar="RATE",
+                        help="negotiate up to RATE (or MAX), needs pyserial")
+    parser.add_argument("-e", dest="elf", metavar="ELF",
+                        help="firmware, for the deferred log formats")
+    args = parser.parse_args(argv[1:])
+
+    if args.elf:
+        FORMATTERS[TYPE_DLOG] = format_dlog(load_formats(args.elf))
+
+    port = None
+    if args.baud:
+        if not args.source:
+            parser.error("-b needs a device")
+        import serial
+        port = serial.Serial(args.source, SAFE_RATE, timeout=0.05)
+        source = port
+    elif args.source:
+        source = open(args.source, "r+b" if args.commands else "rb", buffering=0)
+    elif args.commands:
+        parser.error("-c needs a device")
+    else:
+        source = sys.stdin.buffer
+
+    stream = Stream()
+    if port is not None:
+        print("# %d baud" % negotiate(port, stream, args.baud), file=sys.stderr)
+
+    for command in args.commands:
+        source.write(command.encode("ascii") + b"\n")
+
+    response = bytearray()
+    last = time.monotonic()
+    try:
+        while True:
+            data = source.read(4096)
+            if not data:
+                if port is None:
+                    break
+                # a device that gave up the negotiated rate is found at the
+                # safe one
+                if port.baudrate != SAFE_RATE and time.monotonic() - last > SILENCE_TIMEOUT:
+                    port.baudrate = SAFE_RATE
+                    print("# fell back to %d baud" % SAFE_RATE, file=sys.stderr)
+                continue
+            for channel, kind, sequence, body in stream.feed(data):
+                last = time.monotonic()
+                if kind == TYPE_RESPONSE:
+                    response += body
+                    while b"\n" in response:
+                        line, _, response = response.partition(b"\n")
+                        print("%-8s %5d %02x %s" % (CHANNELS[channel], sequence, kind,
+                                                    line.decode("ascii", "replace")))
+                    continue
+                fmt = FORMATTERS.get(kind)
+                text = fmt(body) if fmt else body.hex()
+                for line in text if isinstance(text, list) else [text]:
+                    print("%-8s %5d %02x %s" % (CHANNELS[channel], sequence, kind, line))
+    except KeyboardInterrupt:
+        pass
+
+    for i, name in enumerate(CHANNELS):
+        print("# %-8s %d frames, %d lost" % (name, stream.frames[i], stream.lost[i]),
+              file=sys.stderr)
+    print("# %d corrupt frames" % stream.corrupt, file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,286 @@
+#!/usr/bin/env python3
+"""Decode the USB-PD message capture in the telemetry stream (Core/Inc/sniff.h).
+
+Reads the stream as link.py does, from a capture file, a serial device or
+standard input, keeps the LINK_TYPE_CAPTURE records and prints one line per
+message on the wire: time in microseconds, direction, SOP type, message
+name, MessageID and revision, data objects or extended payload, and the
+outcome when it was not clean. A message sent again before its GoodCRC
+arrived is marked as a retry; one received again, as a repeat (the partner
+missed our GoodCRC).
+
+    python3 Tools/pdcap.py capture.bin
+    python3 Tools/pdcap.py -b MAX -w negotiation.pcapng /dev/ttyACM0
+
+With -w the messages are also written to a pcapng file, one packet each,
+with link type USER0 (147): the record info byte (direction, outcome, SOP
+type) followed by the message without its CRC. The decoded line is kept as
+the packet comment.
+"""
+
+import argparse
+import struct
+import sys
+import time
+
+import link
+
+# Core/Inc/sniff.h
+TX = 0x80
+DATA_MAX = 30
+SOP_NAMES = ("SOP", "SOP'", "SOP''", "SOP'_Dbg", "SOP''_Dbg", "CableRst",
+             "SOP_Ext1", "SOP_Ext2", "HardRst")
+RESULTS = ("", "crc-error", "discarded", "aborted")
+
+CONTROL = {1: "GoodCRC", 2: "GotoMin", 3: "Accept", 4: "Reject", 5: "Ping",
+           6: "PS_RDY", 7: "Get_Source_Cap", 8: "Get_Sink_Cap", 9: "DR_Swap",
+           10: "PR_Swap", 11: "VCONN_Swap", 12: "Wait", 13: "Soft_Reset",
+           14: "Data_Reset", 15: "Data_Reset_Complete", 16: "Not_Supported",
+           17: "Get_Source_Cap_Extended", 18: "Get_Status", 19: "FR_Swap",
+           20: "Get_PPS_Status", 21: "Get_Country_Codes",
+           22: "Get_Sink_Cap_Extended"}
+DATA = {1: "Source_Capabilities", 2: "Request", 3: "BIST",
+        4: "Sink_Capabilities", 5: "Battery_Status", 6: "Alert",
+        7: "Get_Country_Info", 8: "Enter_USB", 15: "Vendor_Defined"}
+EXTENDED = {1: "Source_Capabilities_Extended", 2: "Status",
+            3: "Get_Battery_Cap", 4: "Get_Battery_Status",
+            5: "Battery_Capabilities", 6: "Get_Manufacturer_Info",
+            7: "Manufacturer_Info", 8: "Security_Request",
+            9: "Security_Response", 10: "Firmware_Update_Request",
+            11: "Firmware_Update_Response", 12: "PPS_Status",
+            13: "Country_Info", 14: "Country_Codes",
+            15: "Sink_Capabilities_Extended"}
+
+GOODCRC = 1
+SOFT_RESET = 13
+
+LINKTYPE_USER0 = 147
+
+
+class Clock:
+    """Microseconds since boot from the frames' tick and cycle counter and
+    the records' cycle counts. The tick tells how often the 32-bit counter
+    wrapped between two frames."""
+
+    def __init__(self):
+        self.last = None
+
+    def frame(self, tick, cycles, mhz):
+        if self.last is None:
+            self.cycles = tick * 1000 * mhz
+        else:
+            last_tick, last_cycles = self.last
+            counted = (cycles - last_cycles) & 0xFFFFFFFF
+            expected = ((tick - last_tick) & 0xFFFFFFFF) * 1000 * mhz
+            self.cycles += counted + round((expected - counted) / 2.0 ** 32) * 2 ** 32
+        self.last = (tick, cycles)
+        self.mhz = mhz
+
+    def us(self, cycles):
+        delta = ((cycles - self.last[1] + 0x80000000) & 0xFFFFFFFF) - 0x80000000
+        return (self.cycles + delta) / self.mhz
+
+
+def decode_capture(body, clock):
+    """Yield (us, info, size, data) for each message in a capture frame, and
+    (us, None, dropped, None) when messages were dropped before it."""
+    tick, cycles, mhz, dropped = struct.unpack_from("<IIBH", body)
+    clock.frame(tick, cycles, mhz)
+    if dropped:
+        yield clock.us(cycles), None, dropped, None
+    i = 11
+    while i + 7 <= len(body):
+        when, info, size = struct.unpack_from("<IBH", body, i)
+        data = body[i + 7:i + 7 + min(size, DATA_MAX)]
+        i += 7 + len(data)
+        yield clock.us(when), info, size, data
+
+
+def pdos(objects):
+    text = []
+    for o in objects:
+        kind = o >> 30
+        if kind == 0:
+            text.append("%dmV/%dmA" % (((o >> 10) & 0x3FF) * 50, (o & 0x3FF) * 10))
+        elif kind == 3 and (o >> 28) & 3 == 0:
+            text.append("PPS %d-%dmV/%dmA" % (((o >> 8) & 0xFF) * 100,
+                                              ((o >> 17) & 0xFF) * 100, (o & 0x7F) * 50))
+        else:
+            text.append("%08x" % o)
+    return " ".join(text)
+
+
+def describe(data, size):
+    """Text of a message, and its type, MessageID, extended flag and data
+    object count; None for those if it is too short to have a header."""
+    if len(data) < 2:
+        return "(%d bytes)" % size, None
+    header, = struct.unpack_from("<H", data)
+    kind = header & 0x1F
+    count = (header >> 12) & 7
+    ident = (header >> 9) & 7
+    extended = header >> 15
+    rev = "%d.0" % (((header >> 6) & 3) + 1)
+
+    if extended:
+        name = EXTENDED.get(kind, "Extended_%d" % kind)
+    elif count == 0:
+        name = CONTROL.get(kind, "Control_%d" % kind)
+    else:
+        name = DATA.get(kind, "Data_%d" % kind)
+    text = "%s id=%d rev=%s" % (name, ident, rev)
+
+    if extended and len(data) >= 4:
+        ext, = struct.unpack_from("<H", data, 2)
+        text += " size=%d chunk=%d%s%s %s" % (
+            ext & 0x1FF, (ext >> 11) & 0xF, " chunked" if ext >> 15 else "",
+            " request" if (ext >> 10) & 1 else "", data[4:].hex())
+    elif count:
+        objects = struct.unpack_from("<%dI" % min(count, (len(data) - 2) // 4), data, 2)
+        if not extended and kind in (1, 4):
+            text += " " + pdos(objects)
+        elif not extended and kind == 2:
+            text += " pos=%d %08x" % (objects[0] >> 28 & 7, objects[0])
+        else:
+            text += " " + " ".join("%08x" % o for o in objects)
+    if size > len(data):
+        text += " (%d bytes)" % size
+
+    return text, (kind, ident, extended, count)
+
+
+class Timeline:
+    """Marks retries and repeats: a message with the same header as the
+    last one in its direction on its SOP, with no GoodCRC for its MessageID
+    in between."""
+
+    def __init__(self):
+        self.pending = {}
+
+    def line(self, us, info, size, data):
+        if info is None:
+            # counted when the frame was built, somewhere before its messages
+            return "%14s    %d messages dropped" % ("", size)
+        tx = bool(info & TX)
+        sop = info & 0x0F
+        result = (info >> 4) & 7
+        sop_name = SOP_NAMES[sop] if sop < len(SOP_NAMES) else "SOP?%d" % sop
+
+        if sop == 8 or sop == 5:
+            self.pending.clear()
+            text, key = "", None
+        else:
+            text, key = describe(data, size)
+
+        notes = []
+        if result:
+            notes.append(RESULTS[result])
+        if key is None:
+            pass
+        elif key[0] == GOODCRC and not key[2] and not key[3]:
+            # acknowledges the other direction
+            other = self.pending.get((not tx, sop))
+            if other is not None and other[1] == key[1]:
+                del self.pending[(not tx, sop)]
+        else:
+            if self.pending.get((tx, sop)) == key:
+                notes.append("retry" if tx else "repeat")
+            self.pending[(tx, sop)] = key
+            if key[0] == SOFT_RESET and not key[2] and not key[3]:
+                self.pending.pop((not tx, sop), None)
+
+        return "%14.1f %s %-9s %s%s" % (us, "TX" if tx else "RX", sop_name, text,
+                                         "".join(" [%s]" % n for n in notes))
+
+
+class Pcapng:
+    """Minimal pcapng writer: one section, one interface, microseconds."""
+
+    def __init__(self, f):
+        self.f = f
+        self.block(0x0A0D0D0A, struct.pack("<IHHq", 0x1A2B3C4D, 1, 0, -1) + self.end())
+        self.block(0x00000001, struct.pack("<HHI", LINKTYPE_USER0, 0, 0) +
+                   self.option(2, b"usbpd") + self.option(9, b"\x06") + self.end())
+
+    @staticmethod
+    def option(code, value):
+        return struct.pack("<HH", code, len(value)) + value + b"\0" * (-len(value) % 4)
+
+    @staticmethod
+    def end():
+        return struct.pack("<HH", 0, 0)
+
+    def block(self, kind, body):
+        total = 12 + len(body)
+        self.f.write(struct.pack("<II", kind, total) + body + struct.pack("<I", total))
+
+    def packet(self, us, data, size, comment):
+        us = int(us)
+        self.block(0x00000006, struct.pack("<IIIII", 0, us >> 32, us & 0xFFFFFFFF,
+                                           len(data), size) +
+                   data + b"\0" * (-len(data) % 4) +
+                   self.option(1, comment.encode("ascii", "replace")) + self.end())
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("source", nargs="?", help="capture file or serial device")
+    parser.add_argument("-b", dest="baud", metavar="RATE",
+                        help="negotiate up to RATE (or MAX), needs pyserial")
+    parser.add_argument("-w", dest="pcapng", metavar="FILE",
+                        help="also write the messages to a pcapng file")
+    args = parser.parse_args(argv[1:])
+
+    stream = link.Stream()
+    if args.baud:
+        if not args.source:
+            parser.error("-b needs a device")
+        import serial
+        source = serial.Serial(args.source, link.SAFE_RATE, timeout=0.05)
+        print("# %d baud" % link.negotiate(source, stream, args.baud), file=sys.stderr)
+    elif args.source:
+        source = open(args.source, "rb", buffering=0)
+    else:
+        source = sys.stdin.buffer
+
+    pcap = Pcapng(open(args.pcapng, "wb")) if args.pcapng else None
+    clock = Clock()
+    timeline = Timeline()
+    offset = None
+    messages = 0
+    dropped = 0
+
+    try:
+        while True:
+            data = source.read(4096)
+            if not data:
+                if not args.baud:
+                    break
+                continue
+            for _, kind, _, body in stream.feed(data):
+                if kind != link.TYPE_CAPTURE:
+                    continue
+                for us, info, size, payload in decode_capture(body, clock):
+                    if offset is None:
+                        offset = time.time() * 1e6 - us
+                    line = timeline.line(us, info, size, payload)
+                    print(line)
+                    if info is None:
+                        dropped += size
+                        continue
+                    messages += 1
+                    if pcap is not None:
+                        pcap.packet(us + offset, bytes([info]) + payload, 1 + size,
+                                    line.strip())
+    except KeyboardInterrupt:
+        pass
+
+    if pcap is not None:
+        pcap.f.close()
+    print("# %d messages, %d dropped, %d frames lost" % (
+        messages, dropped, stream.lost[link.CHANNELS.index("event")]), file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
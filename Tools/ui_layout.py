@@ -0,0 +1,389 @@
+#!/usr/bin/env python3
+"""Generate the static widget tree of the TFT UI.
+
+The tree below is described with positions relative to the parent. This
+script resolves it once, at build time, into what the firmware needs at run
+time so nothing is laid out or searched on the target:
+
+  - absolute bounds and text origins (buttons centre their caption)
+  - text widths from the glyph atlas metrics, and a check that every
+    character a widget can show has a glyph in its atlas
+  - one text buffer slot per widget with settable text
+  - the renderer items the tree needs, checked against RENDER_TEXT_MAX and
+    RENDER_BOX_MAX by widget.c
+  - a hit-test grid of UI_HIT_CELL pixel cells, each pointing at the list
+    of touchable widgets over it, innermost first; pages sharing an area
+    share cells and only the visible one answers
+
+Widgets are emitted in depth-first order, so a subtree is the contiguous
+range id + 1 .. end - 1 and its id names are UI_<NAME>.
+
+Run from the repository root after changing the layout or the atlases:
+
+    python3 Tools/ui_layout.py
+
+It rewrites Core/Inc/ui_layout.h and Core/Src/ui_layout.c. Every list also
+gets a UI_<NAME>_ROWS constant.
+"""
+
+import os
+import re
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import glyph_atlas  # noqa: E402
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), os.pardir)
+HEADER = os.path.join(ROOT, "Core", "Inc", "ui_layout.h")
+SOURCE = os.path.join(ROOT, "Core", "Src", "ui_layout.c")
+
+HIT_CELL = 16
+
+BLACK = (0x00, 0x00, 0x00)
+WHITE = (0xFF, 0xFF, 0xFF)
+GREY = (0x30, 0x30, 0x30)
+AMBER = (0xFF, 0xB0, 0x00)
+
+NUMBER_CHARS = "0123456789.- "
+
+
+def define(path, name):
+    """Read a numeric #define from a firmware header."""
+    with open(os.path.join(ROOT, "Core", "Inc", path)) as f:
+        match = re.search(r"#define\s+%s\s+\(?(\d+)U?" % name, f.read())
+    if match is None:
+        sys.exit("ui_layout: %s not found in %s" % (name, path))
+    return int(match.group(1))
+
+
+TFT_WIDTH = define("tft.h", "TFT_WIDTH")
+TFT_HEIGHT = define("tft.h", "TFT_HEIGHT")
+CHART_X = define("chart.h", "CHART_X")
+TEXT_LEN = define("render.h", "RENDER_TEXT_LEN")
+
+ATLASES = {name: (glyph_atlas.FONT_ADVANCE * scale,
+                  glyph_atlas.FONT_HEIGHT * scale, chars)
+           for name, scale, chars in glyph_atlas.ATLASES}
+
+
+class Widget:
+    def __init__(self, kind, name, x, y, w=0, h=0, children=(), touch=False,
+                 hidden=False, atlas=None, fg=WHITE, bg=BLACK, text=None,
+                 cells=0, decimals=0, range=0):
+        self.kind = kind
+        self.name = name
+        self.x, self.y, self.w, self.h = x, y, w, h
+        self.children = list(children)
+        self.touch = touch
+        self.hidden = hidden
+        self.atlas = atlas
+        self.fg, self.bg = fg, bg
+        self.text = text
+        self.cells = cells
+        self.decimals = decimals
+        self.range = range
+        self.text_x = self.text_y = 0
+        self.slot = None
+
+
+def panel(name, x, y, w, h, children, touch=False, hidden=False):
+    return Widget("PANEL", name, x, y, w, h, children, touch, hidden)
+
+
+def label(name, x, y, text, cells=None, atlas="small", **kw):
+    return Widget("LABEL", name, x, y, atlas=atlas, text=text,
+                  cells=len(text) if cells is None else cells, **kw)
+
+
+def number(name, x, y, cells, decimals, unit, atlas="small", **kw):
+    return Widget("NUMBER", name, x, y, atlas=atlas, text=unit, cells=cells,
+                  decimals=decimals, **kw)
+
+
+def bar(name, x, y, w, h, range, fg=AMBER, bg=GREY):
+    return Widget("BAR", name, x, y, w, h, fg=fg, bg=bg, range=range)
+
+
+def button(name, x, y, w, h, text, atlas="small", fg=WHITE, bg=GREY):
+    return Widget("BUTTON", name, x, y, w, h, touch=True, atlas=atlas,
+                  fg=fg, bg=bg, text=text, cells=len(text))
+
+
+def chart(name, x, y, w, h):
+    return Widget("CHART", name, x, y, w, h, touch=True)
+
+
+def listing(name, x, y, rows, cells, pitch, atlas="small", touch=False,
+            hidden=False):
+    items = [label("%s_%d" % (name, i), 0, i * pitch, "", cells=cells,
+                   atlas=atlas) for i in range(rows)]
+    return Widget("LIST", name, x, y, 0, 0, items, touch, hidden, atlas=atlas,
+                  cells=cells)
+
+
+# Readouts left of the chart on glyph_atlas_small: 12 cells of 12 px per
+# line, a 4-cell name followed by an 8-cell value.
+LINE_X = 6
+LINE_Y = 16
+LINE_PITCH = 44
+VALUE_X = 4 * 12
+
+# USBPD_MAX_NB_PDO, the most a Source_Capabilities message carries
+PDO_ROWS = 7
+
+
+def line(i):
+    return LINE_Y + i * LINE_PITCH
+
+
+LAYOUT = panel("root", 0, 0, TFT_WIDTH, TFT_HEIGHT, [
+    # a long press anywhere on the readouts toggles the latency overlay
+    panel("readouts", 0, 0, CHART_X, TFT_HEIGHT, touch=True, children=[
+        panel("live", 0, 0, CHART_X, TFT_HEIGHT, [
+            label("vbus_label", LINE_X, line(0), "VBUS"),
+            number("vbus", LINE_X + VALUE_X, line(0), 8, 3, "V"),
+            label("ibus_label", LINE_X, line(1), "IBUS"),
+            number("ibus", LINE_X + VALUE_X, line(1), 8, 3, "A"),
+            label("pbus_label", LINE_X, line(2), "PBUS"),
+            number("pbus", LINE_X + VALUE_X, line(2), 8, 2, "W"),
+            # power drawn out of what the contract allows
+            bar("power", LINE_X, line(2) + 24, 12 * 12, 6, range=15000),
+            # tapping the contract opens the PDO list
+            panel("pd", 0, line(3) - 4, CHART_X, LINE_PITCH + 22, touch=True,
+                  children=[
+                label("pd_label", LINE_X, 4, "PD"),
+                label("pd_detached", LINE_X + VALUE_X, 4, "detached"),
+                number("pd_voltage", LINE_X + VALUE_X, 4, 8, 2, "V",
+                       hidden=True),
+                number("pd_current", LINE_X + VALUE_X, 4 + LINE_PITCH, 8, 2,
+                       "A", hidden=True),
+            ]),
+        ]),
+        # one row per source PDO, the active one highlighted
+        panel("pdos", 0, 0, CHART_X, TFT_HEIGHT, hidden=True, children=[
+            listing("pdo", 2, 6, PDO_ROWS, 13, 22, touch=True),
+            label("pdo_status", 2, 164, "", cells=13),
+            button("pdo_back", 84, 196, 72, 36, "BACK"),
+        ]),
+        panel("overlay", 0, 0, CHART_X, TFT_HEIGHT, hidden=True, children=[
+            listing("latency", LINE_X, LINE_Y, 5, 12, LINE_PITCH),
+        ]),
+    ]),
+    chart("chart", CHART_X, 0, TFT_WIDTH - CHART_X, TFT_HEIGHT),
+])
+
+
+def flatten(widget, parent, x0, y0, out):
+    widget.x += x0
+    widget.y += y0
+    widget.parent = parent
+    widget.id = len(out)
+    out.append(widget)
+    for child in widget.children:
+        flatten(child, widget.id, widget.x, widget.y, out)
+    widget.end = len(out)
+
+
+def resolve(widgets):
+    slots = 0
+    texts = 0
+    boxes = 0
+
+    for w in widgets:
+        if w.atlas is not None:
+            if w.atlas not in ATLASES:
+                sys.exit("ui_layout: %s: no atlas %r" % (w.name, w.atlas))
+            advance, height, chars = ATLASES[w.atlas]
+            needed = (w.text or "") + (NUMBER_CHARS if w.kind == "NUMBER" else "")
+            for ch in needed:
+                if ch not in chars and ch.swapcase() not in chars:
+                    sys.exit("ui_layout: %s: no glyph for %r in the %s atlas"
+                             % (w.name, ch, w.atlas))
+
+        if w.kind in ("LABEL", "NUMBER"):
+            w.w = w.cells * advance
+            w.h = height
+            w.text_x, w.text_y = w.x, w.y
+            texts += 1
+        elif w.kind == "BUTTON":
+            if w.cells * advance > w.w or height > w.h:
+                sys.exit("ui_layout: %s: caption does not fit" % w.name)
+            w.text_x = w.x + (w.w - w.cells * advance) // 2
+            w.text_y = w.y + (w.h - height) // 2
+            texts += 1
+            boxes += 1
+        elif w.kind == "BAR":
+            boxes += 2
+        elif w.kind == "LIST":
+            rows = w.children
+            w.w = max(r.x + r.cells * advance for r in rows) - w.x
+            w.h = rows[-1].y + height - w.y
+
+        if w.kind in ("LABEL", "BUTTON"):
+            w.slot = slots
+            slots += 1
+        if w.kind == "NUMBER" and w.decimals > 3:
+            sys.exit("ui_layout: %s: values only carry 3 decimals" % w.name)
+        if w.cells >= TEXT_LEN:
+            sys.exit("ui_layout: %s: more cells than WIDGET_TEXT_LEN" % w.name)
+
+    for w in widgets:
+        if w.parent is None:
+            continue
+        p = widgets[w.parent]
+        if (w.x < p.x or w.y < p.y or w.x + w.w > p.x + p.w or
+                w.y + w.h > p.y + p.h):
+            sys.exit("ui_layout: %s is outside %s" % (w.name, p.name))
+
+    return slots, texts, boxes
+
+
+def ancestors(widgets, w):
+    out = set()
+    while w.parent is not None:
+        w = widgets[w.parent]
+        out.add(w.id)
+    return out
+
+
+def hit_grid(widgets):
+    """Map every cell to an offset into a shared, WIDGET_NONE terminated
+    candidate table; cells with the same candidates share one entry."""
+    cols = (TFT_WIDTH + HIT_CELL - 1) // HIT_CELL
+    rows = (TFT_HEIGHT + HIT_CELL - 1) // HIT_CELL
+    cells = [[[] for _ in range(cols)] for _ in range(rows)]
+
+    for w in widgets:
+        if not w.touch:
+            continue
+        for row in range(w.y // HIT_CELL, (w.y + w.h - 1) // HIT_CELL + 1):
+            for col in range(w.x // HIT_CELL, (w.x + w.w - 1) // HIT_CELL + 1):
+                cells[row][col].append(w.id)
+
+    # deepest first, then the one drawn last
+    depth = {w.id: len(ancestors(widgets, w)) for w in widgets}
+    table = [None]
+    offsets = {(): 0}
+    grid = []
+    for row in cells:
+        out = []
+        for ids in row:
+            key = tuple(sorted(ids, key=lambda i: (-depth[i], -i)))
+            if key not in offsets:
+                offsets[key] = len(table)
+                table.extend(key + (None,))
+            out.append(offsets[key])
+        grid.append(out)
+
+    if len(table) > 0xFF:
+        sys.exit("ui_layout: hit table too large, raise HIT_CELL")
+    return grid, table, cols, rows
+
+
+BANNER = """/**
+  ******************************************************************************
+  * @file           : %s
+  * @brief          : Static widget tree and hit-test grid, generated by
+  *                   Tools/ui_layout.py. Do not edit.
+  ******************************************************************************
+  */
+"""
+
+
+def rgb(color):
+    return "TFT_RGB(0x%02XU, 0x%02XU, 0x%02XU)" % color
+
+
+def main():
+    widgets = []
+    flatten(LAYOUT, None, 0, 0, widgets)
+    slots, texts, boxes = resolve(widgets)
+    grid, table, cols, rows = hit_grid(widgets)
+
+    def ident(i):
+        return "WIDGET_NONE" if i is None else "UI_%s" % widgets[i].name.upper()
+
+    header = [BANNER % "ui_layout.h",
+              "/* Define to prevent recursive inclusion -------------------------------------*/",
+              "#ifndef __UI_LAYOUT_H", "#define __UI_LAYOUT_H", "",
+              "#ifdef __cplusplus", 'extern "C" {', "#endif", "",
+              "/* Includes ------------------------------------------------------------------*/",
+              '#include "widget.h"', "",
+              "/* Exported constants --------------------------------------------------------*/", "",
+              "#define UI_WIDGETS            %dU" % len(widgets),
+              "#define UI_TEXT_SLOTS         %dU" % slots,
+              "// renderer items the tree allocates",
+              "#define UI_TEXT_ITEMS         %dU" % texts,
+              "#define UI_BOX_ITEMS          %dU" % boxes, "",
+              "#define UI_HIT_CELL           %dU" % HIT_CELL,
+              "#define UI_HIT_COLS           %dU" % cols,
+              "#define UI_HIT_ROWS           %dU" % rows,
+              "#define UI_HIT_TABLE          %dU" % len(table), ""]
+    for w in widgets:
+        if w.kind == "LIST":
+            header.append("#define %-21s %dU" % ("UI_%s_ROWS" % w.name.upper(), len(w.children)))
+    header.extend(["",
+              "/* Exported types ------------------------------------------------------------*/", "",
+              "enum", "{"])
+    for w in widgets:
+        depth = len(ancestors(widgets, w))
+        header.append("  %-28s// %s" % ("%s," % ident(w.id), "  " * depth + w.kind.lower()))
+    header.extend(["};", "",
+                   "/* Exported variables --------------------------------------------------------*/", "",
+                   "extern const widget_def_t ui_layout[UI_WIDGETS];",
+                   "extern const uint8_t ui_hit_grid[UI_HIT_ROWS][UI_HIT_COLS];",
+                   "extern const widget_id_t ui_hit_table[UI_HIT_TABLE];",
+                   "", "#ifdef __cplusplus", "}", "#endif", "",
+                   "#endif /* __UI_LAYOUT_H */", ""])
+
+    source = [BANNER % "ui_layout.c",
+              "/* Includes ------------------------------------------------------------------*/",
+              "#include <stddef.h>", "",
+              '#include "glyph_atlas.h"',
+              '#include "ui_layout.h"', "",
+              "/* Exported variables --------------------------------------------------------*/", "",
+              "const widget_def_t ui_layout[UI_WIDGETS] =", "{"]
+    for w in widgets:
+        source.append("  [%s] =" % ident(w.id))
+        source.append("  {")
+        source.append("    .type     = WIDGET_%s," % w.kind)
+        source.append("    .parent   = %s," % ident(w.parent))
+        source.append("    .end      = %dU," % w.end)
+        flags = [f for f, on in (("WIDGET_FLAG_TOUCH", w.touch),
+                                 ("WIDGET_FLAG_HIDDEN", w.hidden)) if on]
+        source.append("    .flags    = %s," % (" | ".join(flags) if flags else "0U"))
+        source.append("    .bounds   = { %dU, %dU, %dU, %dU }," % (w.x, w.y, w.w, w.h))
+        if w.atlas is not None:
+            source.append("    .text_x   = %dU," % w.text_x)
+            source.append("    .text_y   = %dU," % w.text_y)
+            source.append("    .atlas    = &glyph_atlas_%s," % w.atlas)
+        source.append("    .fg       = %s," % rgb(w.fg))
+        source.append("    .bg       = %s," % rgb(w.bg))
+        source.append("    .text     = %s," % ('"%s"' % w.text if w.text else "NULL"))
+        source.append("    .cells    = %dU," % w.cells)
+        source.append("    .decimals = %dU," % w.decimals)
+        source.append("    .slot     = %s," % ("WIDGET_SLOT_NONE" if w.slot is None else "%dU" % w.slot))
+        source.append("    .range    = %d," % w.range)
+        source.append("  },")
+    source.extend(["};", "",
+                   "// offset into ui_hit_table of the candidates over each cell",
+                   "const uint8_t ui_hit_grid[UI_HIT_ROWS][UI_HIT_COLS] =", "{"])
+    for row in grid:
+        source.append("  { " + ", ".join("%dU" % i for i in row) + " },")
+    source.extend(["};", "",
+                   "const widget_id_t ui_hit_table[UI_HIT_TABLE] =", "{"])
+    for i in range(0, len(table), 8):
+        source.append("  " + " ".join("%s," % ident(j) for j in table[i:i + 8]))
+    source.extend(["};", ""])
+
+    with open(HEADER, "w", newline="\n") as f:
+        f.write("\n".join(header))
+    with open(SOURCE, "w", newline="\n") as f:
+        f.write("\n".join(source))
+
+    print("ui_layout: %d widgets, %d text items, %d boxes, %dx%d hit cells"
+          % (len(widgets), texts, boxes, cols, rows))
+
+
+if __name__ == "__main__":
+    main()
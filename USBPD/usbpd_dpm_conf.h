@@ -44,6 +44,14 @@
 
 /* USER CODE BEGIN Define */
 /* Section where Define can be added */
+/* Run CAD processing and the SNK policy engine in a single event-driven task
+   instead of a CAD task plus a PE task created on attach (single port only) */
+#ifndef USBPD_DPM_SINGLE_TASK
+#define USBPD_DPM_SINGLE_TASK   0
+#endif
+#if (USBPD_DPM_SINGLE_TASK != 0) && (USBPD_PORT_COUNT != 1)
+#error "USBPD_DPM_SINGLE_TASK requires USBPD_PORT_COUNT == 1"
+#endif
 
 /* USER CODE END Define */
 
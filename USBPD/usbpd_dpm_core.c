@@ -28,6 +28,7 @@
 #include "usbpd_dpm_user.h"
 #include "usbpd_dpm_conf.h"
 #include "cmsis_os.h"
+#include "deadline.h"
 #if (osCMSIS >= 0x20000U)
 #include "task.h"
 #endif /* osCMSIS >= 0x20000U */
@@ -46,6 +47,14 @@ enum
 extern uint32_t HAL_GetTick(void);
 
 /* Private function prototypes -----------------------------------------------*/
+#if (USBPD_DPM_SINGLE_TASK != 0)
+#if (osCMSIS < 0x20000U)
+void USBPD_DPM_Task(void const *argument);
+#else
+void USBPD_DPM_Task(void *argument);
+#endif /* osCMSIS < 0x20000U */
+static void DPM_TaskSignal(uint32_t Signal);
+#endif /* USBPD_DPM_SINGLE_TASK */
 #if (osCMSIS < 0x20000U)
 
 void USBPD_PE_Task(void const *argument);
@@ -68,12 +77,28 @@ void USBPD_CAD_Task(void *argument);
 #define FREERTOS_PE_STACK_SIZE                  (200 * DPM_STACK_SIZE_ADDON_FOR_CMSIS)
 #define FREERTOS_CAD_PRIORITY                   osPriorityRealtime
 #define FREERTOS_CAD_STACK_SIZE                 (300 * DPM_STACK_SIZE_ADDON_FOR_CMSIS)
+/* Merged CAD+PE task: CAD priority, PE call depth on top of the CAD one */
+#define FREERTOS_DPM_PRIORITY                   FREERTOS_CAD_PRIORITY
+#define FREERTOS_DPM_STACK_SIZE                 (350 * DPM_STACK_SIZE_ADDON_FOR_CMSIS)
+#define DPM_SIGNAL_CAD                          0x01U
+#define DPM_SIGNAL_PE                           0x02U
+#define DPM_SIGNAL_ALL                          (DPM_SIGNAL_CAD | DPM_SIGNAL_PE)
+/* Latency budgets from task wake-up to the end of the state machine pass */
+#ifndef DPM_PE_DEADLINE_US
+#define DPM_PE_DEADLINE_US                      2000U
+#endif
+#ifndef DPM_CAD_DEADLINE_US
+#define DPM_CAD_DEADLINE_US                     1000U
+#endif
 #if (osCMSIS < 0x20000U)
 osThreadDef(PE_0, USBPD_PE_Task, FREERTOS_PE_PRIORITY, 0, FREERTOS_PE_STACK_SIZE);
 osThreadDef(PE_1, USBPD_PE_Task, FREERTOS_PE_PRIORITY, 0, FREERTOS_PE_STACK_SIZE);
 osMessageQDef(queuePE, 1, uint16_t);
 osThreadDef(CAD, USBPD_CAD_Task, FREERTOS_CAD_PRIORITY, 0, FREERTOS_CAD_STACK_SIZE);
 osMessageQDef(queueCAD, 2, uint16_t);
+#if (USBPD_DPM_SINGLE_TASK != 0)
+osThreadDef(DPM, USBPD_DPM_Task, FREERTOS_DPM_PRIORITY, 0, FREERTOS_DPM_STACK_SIZE);
+#endif /* USBPD_DPM_SINGLE_TASK */
 
 #else /* osCMSIS >= 0x20000U */
 
@@ -94,6 +119,14 @@ osThreadAttr_t CAD_Thread_Atrr = {
   .stack_size = FREERTOS_CAD_STACK_SIZE
 };
 
+#if (USBPD_DPM_SINGLE_TASK != 0)
+osThreadAttr_t DPM_Thread_Atrr = {
+  .name       = "DPM",
+  .priority   = FREERTOS_DPM_PRIORITY,
+  .stack_size = FREERTOS_DPM_STACK_SIZE
+};
+#endif /* USBPD_DPM_SINGLE_TASK */
+
 #endif /* osCMSIS < 0x20000U */
 
 /* Private define ------------------------------------------------------------*/
@@ -120,6 +153,11 @@ osThreadAttr_t CAD_Thread_Atrr = {
 /* Private variables ---------------------------------------------------------*/
 static osThreadId DPM_Thread_Table[MAX_THREAD_NB];
 static osMessageQId PEQueueId[USBPD_PORT_COUNT], CADQueueId;
+static deadline_id_t DPM_PE_Deadline[USBPD_PORT_COUNT], DPM_CAD_Deadline;
+#if (USBPD_DPM_SINGLE_TASK != 0)
+/* PE state machine runs only while attached, as the PE task would */
+static volatile uint8_t DPM_PE_Running;
+#endif /* USBPD_DPM_SINGLE_TASK */
 
 USBPD_ParamsTypeDef   DPM_Params[USBPD_PORT_COUNT];
 
@@ -230,6 +268,26 @@ USBPD_StatusTypeDef USBPD_DPM_InitCore(void)
   */
 USBPD_StatusTypeDef USBPD_DPM_InitOS(void)
 {
+  DPM_CAD_Deadline   = deadline_register("CAD", DPM_CAD_DEADLINE_US);
+  DPM_PE_Deadline[0] = deadline_register("PE_0", DPM_PE_DEADLINE_US);
+#if USBPD_PORT_COUNT == 2
+  DPM_PE_Deadline[1] = deadline_register("PE_1", DPM_PE_DEADLINE_US);
+#endif /* USBPD_PORT_COUNT == 2 */
+
+#if (USBPD_DPM_SINGLE_TASK != 0)
+  /* One task waits on task notifications for both layers: no queues */
+  DPM_PE_Running = 0U;
+  DPM_Thread_Table[USBPD_THREAD_PORT_0] = NULL;
+#if (osCMSIS < 0x20000U)
+  if ((DPM_Thread_Table[USBPD_THREAD_CAD] = osThreadCreate(osThread(DPM), NULL)) == NULL)
+#else
+  if ((DPM_Thread_Table[USBPD_THREAD_CAD] = osThreadNew(USBPD_DPM_Task, NULL, &DPM_Thread_Atrr)) == NULL)
+#endif /* osCMSIS < 0x20000U */
+  {
+    return USBPD_ERROR;
+  }
+  return USBPD_OK;
+#else
 #if (osCMSIS < 0x20000U)
   CADQueueId = osMessageCreate(osMessageQ(queueCAD), NULL);
   if((DPM_Thread_Table[USBPD_THREAD_CAD] = osThreadCreate(osThread(CAD), NULL)) == NULL)
@@ -261,6 +319,7 @@ USBPD_StatusTypeDef USBPD_DPM_InitOS(void)
 #endif /* USBPD_PORT_COUNT == 2 */
 
   return USBPD_OK;
+#endif /* USBPD_DPM_SINGLE_TASK */
 }
 
 /**
@@ -306,7 +365,10 @@ void USBPD_DPM_TimerCounter(void)
   */
 static void USBPD_PE_TaskWakeUp(uint8_t PortNum)
 {
-#if (osCMSIS < 0x20000U)
+  deadline_start(DPM_PE_Deadline[PortNum]);
+#if (USBPD_DPM_SINGLE_TASK != 0)
+  DPM_TaskSignal(DPM_SIGNAL_PE);
+#elif (osCMSIS < 0x20000U)
   (void)osMessagePut(PEQueueId[PortNum], 0xFFFF, 0);
 #else
   uint32_t event = 0xFFFFU;
@@ -320,7 +382,10 @@ static void USBPD_PE_TaskWakeUp(uint8_t PortNum)
   */
 static void USBPD_DPM_CADTaskWakeUp(void)
 {
-#if (osCMSIS < 0x20000U)
+  deadline_start(DPM_CAD_Deadline);
+#if (USBPD_DPM_SINGLE_TASK != 0)
+  DPM_TaskSignal(DPM_SIGNAL_CAD);
+#elif (osCMSIS < 0x20000U)
   (void)osMessagePut(CADQueueId, 0xFFFF, 0);
 #else
   uint32_t event = 0xFFFFU;
@@ -328,6 +393,63 @@ static void USBPD_DPM_CADTaskWakeUp(void)
 #endif /* osCMSIS < 0x20000U */
 }
 
+#if (USBPD_DPM_SINGLE_TASK != 0)
+/**
+  * @brief  Signal the merged CAD+PE task
+  * @param  Signal DPM_SIGNAL_CAD and/or DPM_SIGNAL_PE
+  * @retval None
+  */
+static void DPM_TaskSignal(uint32_t Signal)
+{
+  /* wake-ups may come from ISRs before the task exists */
+  if (NULL != DPM_Thread_Table[USBPD_THREAD_CAD])
+  {
+#if (osCMSIS < 0x20000U)
+    (void)osSignalSet(DPM_Thread_Table[USBPD_THREAD_CAD], (int32_t)Signal);
+#else
+    (void)osThreadFlagsSet(DPM_Thread_Table[USBPD_THREAD_CAD], Signal);
+#endif /* osCMSIS < 0x20000U */
+  }
+}
+
+/**
+  * @brief  Merged task for CAD and PE layers (single port)
+  * @note   Both layers run on every wake-up, whichever one was signalled:
+  *         each returns the time until it needs to run again, and the task
+  *         sleeps for the shorter of the two.
+  * @param  argument Not used
+  * @retval None
+  */
+#if (osCMSIS < 0x20000U)
+void USBPD_DPM_Task(void const *argument)
+#else
+void USBPD_DPM_Task(void *argument)
+#endif /* osCMSIS < 0x20000U */
+{
+  for (;;)
+  {
+    uint32_t _timing = USBPD_CAD_Process();
+    deadline_finish(DPM_CAD_Deadline);
+
+    if (0U != DPM_PE_Running)
+    {
+      uint32_t _timing_pe = USBPD_PE_StateMachine_SNK(USBPD_PORT_0);
+      deadline_finish(DPM_PE_Deadline[USBPD_PORT_0]);
+      if (_timing_pe < _timing)
+      {
+        _timing = _timing_pe;
+      }
+    }
+
+#if (osCMSIS < 0x20000U)
+    (void)osSignalWait(DPM_SIGNAL_ALL, _timing);
+#else
+    (void)osThreadFlagsWait(DPM_SIGNAL_ALL, osFlagsWaitAny, _timing);
+#endif /* osCMSIS < 0x20000U */
+  }
+}
+#endif /* USBPD_DPM_SINGLE_TASK */
+
 #if (osCMSIS < 0x20000U)
 /**
   * @brief  Main task for PE layer
@@ -340,8 +462,9 @@ void USBPD_PE_Task(void const *argument)
 
   for(;;)
   {
-    osMessageGet(PEQueueId[_port],
-    USBPD_PE_StateMachine_SNK(_port));
+    uint32_t _timing = USBPD_PE_StateMachine_SNK(_port);
+    deadline_finish(DPM_PE_Deadline[_port]);
+    osMessageGet(PEQueueId[_port], _timing);
   }
 }
 
@@ -381,8 +504,9 @@ static void PE_Task(uint32_t PortNum)
   for (;;)
   {
     uint32_t event;
-    (void)osMessageQueueGet(PEQueueId[PortNum], &event, NULL,
-    USBPD_PE_StateMachine_SNK(PortNum));
+    uint32_t _timing = USBPD_PE_StateMachine_SNK(PortNum);
+    deadline_finish(DPM_PE_Deadline[PortNum]);
+    (void)osMessageQueueGet(PEQueueId[PortNum], &event, NULL, _timing);
   }
 }
 #endif /* osCMSIS < 0x20000U */
@@ -400,11 +524,13 @@ void USBPD_CAD_Task(void *argument)
 {
   for(;;)
   {
+    uint32_t _timing = USBPD_CAD_Process();
+    deadline_finish(DPM_CAD_Deadline);
 #if (osCMSIS < 0x20000U)
-    osMessageGet(CADQueueId, USBPD_CAD_Process());
+    osMessageGet(CADQueueId, _timing);
 #else
     uint32_t event;
-    (void)osMessageQueueGet(CADQueueId, &event, NULL, USBPD_CAD_Process());
+    (void)osMessageQueueGet(CADQueueId, &event, NULL, _timing);
 #endif /* osCMSIS < 0x20000U */
   }
 }
@@ -434,12 +560,18 @@ void USBPD_DPM_CADCallback(uint8_t PortNum, USBPD_CAD_EVENT State, CCxPin_TypeDe
     {
       /* The ufp is detached */
       (void)USBPD_PE_IsCableConnected(PortNum, 0);
+#if (USBPD_DPM_SINGLE_TASK != 0)
+      /* Stop running the PE state machine */
+      DPM_PE_Running = 0U;
+      deadline_cancel(DPM_PE_Deadline[PortNum]);
+#else
       /* Terminate PE task */
       if (DPM_Thread_Table[PortNum] != NULL)
       {
         osThreadTerminate(DPM_Thread_Table[PortNum]);
         DPM_Thread_Table[PortNum] = NULL;
       }
+#endif /* USBPD_DPM_SINGLE_TASK */
       USBPD_DPM_UserCableDetection(PortNum, State);
       DPM_Params[PortNum].PE_SwapOngoing = USBPD_FALSE;
       DPM_Params[PortNum].ActiveCCIs = CCNONE;
@@ -459,6 +591,11 @@ static void DPM_ManageAttachedState(uint8_t PortNum, USBPD_CAD_EVENT State, CCxP
 
   USBPD_DPM_UserCableDetection(PortNum, State);
 
+#if (USBPD_DPM_SINGLE_TASK != 0)
+  /* Called from USBPD_CAD_Process() in the merged task, the PE state
+     machine runs right after it in the same loop pass */
+  DPM_PE_Running = 1U;
+#else
   /* Create PE task */
   if (DPM_Thread_Table[PortNum] == NULL)
   {
@@ -473,5 +610,6 @@ static void DPM_ManageAttachedState(uint8_t PortNum, USBPD_CAD_EVENT State, CCxP
       while(1);
     }
   }
+#endif /* USBPD_DPM_SINGLE_TASK */
 }
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
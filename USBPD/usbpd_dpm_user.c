@@ -35,6 +35,11 @@
 #include "string.h"
 #include "cmsis_os.h"
 #include "usbpd_pwr_user.h"
+#include "deadline.h"
+#include "dlog.h"
+#include "link.h"
+#include "pdo.h"
+#include "screen.h"
 
 /** @addtogroup STM32_USBPD_APPLICATION
   * @{
@@ -59,7 +64,12 @@ void                USBPD_DPM_UserExecute(void const *argument);
 void                USBPD_DPM_UserExecute(void *argument);
 #endif /* osCMSIS < 0x20000U */
 /* USER CODE BEGIN Private_Define */
-
+/* Attach to explicit contract budget, the spec maxima of the steps in
+   between: tTypeCSinkWaitCap for Source_Capabilities (620 ms), then
+   tSenderResponse for Accept (30 ms) and tPSTransition for PS_RDY (550 ms) */
+#ifndef DPM_USER_CONTRACT_DEADLINE_US
+#define DPM_USER_CONTRACT_DEADLINE_US  1200000u
+#endif
 /* USER CODE END Private_Define */
 
 /**
@@ -84,7 +94,10 @@ void                USBPD_DPM_UserExecute(void *argument);
 #define DPM_USER_DEBUG_TRACE(_PORT_, ...)
 #endif /* _TRACE */
 /* USER CODE BEGIN Private_Macro */
-
+/* Debug traces are deferred: the format stays out of flash and the host
+   formats the record (dlog.h), no snprintf() in the PE callbacks */
+#undef DPM_USER_DEBUG_TRACE
+#define DPM_USER_DEBUG_TRACE(_PORT_, ...)  DLOG((_PORT_), __VA_ARGS__)
 /* USER CODE END Private_Macro */
 /**
   * @}
@@ -96,6 +109,8 @@ void                USBPD_DPM_UserExecute(void *argument);
   */
 /* USER CODE BEGIN Private_Variables */
 extern USBPD_ParamsTypeDef DPM_Params[USBPD_PORT_COUNT];
+static deadline_id_t DPM_ContractDeadline[USBPD_PORT_COUNT];
+static const char * const DPM_ContractDeadlineName[] = { "contract_0", "contract_1" };
 /* USER CODE END Private_Variables */
 /**
   * @}
@@ -144,6 +159,16 @@ static void DPM_SNK_GetSelectedPDO(
 USBPD_StatusTypeDef USBPD_DPM_UserInit(void)
 {
 /* USER CODE BEGIN USBPD_DPM_UserInit */
+#if defined(_TRACE)
+  /* Non-blocking trace back end, drained by ShellTask (pd_trace.h) */
+  USBPD_TRACE_Init();
+#endif /* _TRACE */
+
+  for (uint8_t _port = 0u; _port < USBPD_PORT_COUNT; _port++)
+  {
+    DPM_ContractDeadline[_port] = deadline_register(DPM_ContractDeadlineName[_port], DPM_USER_CONTRACT_DEADLINE_US);
+  }
+
   USBPD_PWR_IF_Init();
 
   return USBPD_OK;
@@ -208,6 +233,19 @@ void USBPD_DPM_UserCableDetection(uint8_t PortNum, USBPD_CAD_EVENT State)
 
   }
 /* USER CODE BEGIN USBPD_DPM_UserCableDetection */
+  link_event(LINK_TYPE_CABLE, PortNum, (uint8_t)State);
+
+  /* Measure attach to explicit contract, see USBPD_DPM_Notification */
+  if ((USBPD_CAD_EVENT_ATTACHED == State) || (USBPD_CAD_EVENT_ATTEMC == State))
+  {
+    deadline_start(DPM_ContractDeadline[PortNum]);
+  }
+  else
+  {
+    deadline_cancel(DPM_ContractDeadline[PortNum]);
+    pdo_reset(PortNum);
+  }
+  screen_notify(SCREEN_EVENT_DPM);
 /* USER CODE END USBPD_DPM_UserCableDetection */
 }
 
@@ -278,6 +316,11 @@ USBPD_StatusTypeDef USBPD_DPM_EvaluatePowerRoleSwap(uint8_t PortNum)
 void USBPD_DPM_Notification(uint8_t PortNum, USBPD_NotifyEventValue_TypeDef EventVal)
 {
 /* USER CODE BEGIN USBPD_DPM_Notification */
+  link_event(LINK_TYPE_NOTIFY, PortNum, (uint8_t)EventVal);
+
+  /* Outcome of a request made from the PDO list */
+  pdo_notify(PortNum, EventVal);
+
   switch(EventVal)
   {
     /***************************************************************************
@@ -287,6 +330,8 @@ void USBPD_DPM_Notification(uint8_t PortNum, USBPD_NotifyEventValue_TypeDef Even
       /* Power ready means an explicit contract has been establish and Power is available */
       /* Turn On VBUS LED when an explicit contract is established */
       //LED_ON(LED2_WHITE);
+      deadline_finish(DPM_ContractDeadline[PortNum]);
+      screen_notify(SCREEN_EVENT_DPM);
       break;
     /*
                               End Power Notification
@@ -302,6 +347,12 @@ void USBPD_DPM_Notification(uint8_t PortNum, USBPD_NotifyEventValue_TypeDef Even
         rdo.d32 = DPM_Ports[PortNum].DPM_RequestDOMsg;
         DPM_Ports[PortNum].DPM_RDOPosition = rdo.GenericRDO.ObjectPosition;
       }
+      screen_notify(SCREEN_EVENT_DPM);
+    break;
+
+    case USBPD_NOTIFY_REQUEST_REJECTED:
+    case USBPD_NOTIFY_REQUEST_WAIT:
+      screen_notify(SCREEN_EVENT_DPM);
     break;
     /*
                               End REQUEST ANSWER NOTIFICATION
@@ -315,6 +366,7 @@ void USBPD_DPM_Notification(uint8_t PortNum, USBPD_NotifyEventValue_TypeDef Even
       {
         /* SINK Port Partner is not PD capable. Legacy cable may have been connected
            In this state, VBUS is set to 5V */
+        screen_notify(SCREEN_EVENT_DPM);
       }
       break;
     default :
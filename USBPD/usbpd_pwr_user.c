@@ -30,7 +30,9 @@
 /* USER CODE BEGIN include */
 #include "main.h"
 #include "usbpd_pwr_if.h"
-#include "ina260.h"
+#include "measure.h"
+#include "deadline.h"
+#include "dlog.h"
 /* USER CODE END include */
 
 /** @addtogroup BSP
@@ -54,6 +56,10 @@
 * @{
 */
 /* USER CODE BEGIN POWER_Private_Constants */
+/* Budget for a single INA260 register read over I2C */
+#ifndef PWR_MEASURE_DEADLINE_US
+#define PWR_MEASURE_DEADLINE_US  1000U
+#endif
 
 /* USER CODE END POWER_Private_Constants */
 /**
@@ -69,6 +75,9 @@
 #define PWR_DEBUG_TRACE(_PORT_, __MESSAGE__)
 #endif /* _TRACE */
 /* USER CODE BEGIN POWER_Private_Macros */
+/* Deferred like the DPM traces: no copy of the text into the trace FIFO */
+#undef PWR_DEBUG_TRACE
+#define PWR_DEBUG_TRACE(_PORT_, __MESSAGE__)  DLOG((_PORT_), __MESSAGE__)
 
 /* USER CODE END POWER_Private_Macros */
 /**
@@ -79,6 +88,7 @@
   * @{
   */
 /* USER CODE BEGIN POWER_Private_Variables */
+static deadline_id_t PWR_MeasureDeadlineId = DEADLINE_NONE;
 
 /* USER CODE END POWER_Private_Variables */
 /**
@@ -89,6 +99,7 @@
   * @{
   */
 /* USER CODE BEGIN POWER_Private_Prototypes */
+static deadline_id_t PWR_MeasureDeadline(void);
 
 /* USER CODE END POWER_Private_Prototypes */
 /**
@@ -382,17 +393,15 @@ int32_t BSP_USBPD_PWR_VBUSGetVoltage(uint32_t Instance, uint32_t *pVoltage)
   }
   else {
 
-    ina260_t *pow = power();
-    float mV;
+    deadline_id_t dl = PWR_MeasureDeadline();
+    HAL_StatusTypeDef status;
 
-    if (HAL_OK == ina260_get_voltage(pow, &mV)) {
-      *pVoltage = (uint32_t)mV;
-      ret = BSP_ERROR_NONE;
-    }
-    else {
-      *pVoltage = 0U;
-      ret = BSP_ERROR_COMPONENT_FAILURE;
-    }
+    /* shares I2C3 with the periodic sampler, see measure.h */
+    deadline_start(dl);
+    status = measure_voltage(pVoltage);
+    deadline_finish(dl);
+
+    ret = (HAL_OK == status) ? BSP_ERROR_NONE : BSP_ERROR_COMPONENT_FAILURE;
 
   }
   return ret;
@@ -418,17 +427,14 @@ int32_t BSP_USBPD_PWR_VBUSGetCurrent(uint32_t Instance, int32_t *pCurrent)
   }
   else {
 
-    ina260_t *pow = power();
-    float mA;
+    deadline_id_t dl = PWR_MeasureDeadline();
+    HAL_StatusTypeDef status;
+
+    deadline_start(dl);
+    status = measure_current(pCurrent);
+    deadline_finish(dl);
 
-    if (HAL_OK == ina260_get_current(pow, &mA)) {
-      *pCurrent = (uint32_t)mA;
-      ret = BSP_ERROR_NONE;
-    }
-    else {
-      *pCurrent = 0U;
-      ret = BSP_ERROR_COMPONENT_FAILURE;
-    }
+    ret = (HAL_OK == status) ? BSP_ERROR_NONE : BSP_ERROR_COMPONENT_FAILURE;
 
   }
   return ret;
@@ -657,6 +663,19 @@ int32_t BSP_USBPD_PWR_VBUSIsOn(uint32_t Instance, uint8_t *pState)
   */
 
 /* USER CODE BEGIN POWER_Private_Functions */
+/**
+  * @brief  Deadline covering the INA260 reads of the measurement path,
+  *         registered on first use since no init hook runs before them.
+  * @retval Deadline id
+  */
+static deadline_id_t PWR_MeasureDeadline(void)
+{
+  if (DEADLINE_NONE == PWR_MeasureDeadlineId)
+  {
+    PWR_MeasureDeadlineId = deadline_register("INA260", PWR_MEASURE_DEADLINE_US);
+  }
+  return PWR_MeasureDeadlineId;
+}
 
 /* USER CODE END POWER_Private_Functions */
 